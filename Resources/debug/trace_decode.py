@@ -0,0 +1,227 @@
+# coding=utf-8
+"""
+trace_decode.py - convert a g2core binary event trace to Chrome-trace JSON
+
+Build the firmware with __TRACE defined in g2core.h, connect the second USB serial
+port (the muted secondary channel) and capture it to a file, e.g.:
+
+    cat /dev/ttyACM1 > run.trace          (or: python trace_decode.py --port /dev/ttyACM1 ...)
+
+then convert and open the result in https://ui.perfetto.dev or chrome://tracing:
+
+    python trace_decode.py run.trace -o run.json
+
+The wire format is described in g2core/trace.h. Event IDs and state names below must
+be kept in sync with traceEvent, bufferState and cmFeedholdState.
+"""
+import argparse
+import json
+import struct
+import sys
+
+TRACE_SYNC = 0x5447
+TRACE_VERSION = 1
+FRAME = struct.Struct('<HBBI')          # sync, count, version, dropped
+RECORD = struct.Struct('<IHBBI')        # time_us, seq, event, arg, value
+MAX_BATCH = 64                          # sanity limit for resync
+
+EVENTS = {
+    1: 'BUFFER_STATE',
+    2: 'FORWARD_PLAN_START',
+    3: 'FORWARD_PLAN_END',
+    4: 'LOAD_MOVE',
+    5: 'FEEDHOLD',
+    6: 'RX_LINE',
+    7: 'FEEDHOLD_STOP',
+}
+
+BUFFER_STATES = {
+    0: 'EMPTY',
+    1: 'INITIALIZING',
+    2: 'NOT_PLANNED',
+    3: 'BACK_PLANNED',
+    4: 'FULLY_PLANNED',
+    5: 'RUNNING',
+}
+
+BLOCK_TYPES = {
+    0: 'NULL',
+    1: 'ALINE',
+    2: 'COMMAND',
+    3: 'DWELL',
+    4: 'JSON_WAIT',
+    5: 'TOOL',
+    6: 'SPINDLE_SPEED',
+    7: 'STOP',
+    8: 'END',
+}
+
+FEEDHOLD_STATES = {
+    0: 'OFF',
+    1: 'REQUESTED',
+    2: 'SYNC',
+    3: 'DECEL_CONTINUE',
+    4: 'DECEL_TO_ZERO',
+    5: 'DECEL_COMPLETE',
+    6: 'MOTION_STOPPING',
+    7: 'MOTION_STOPPED',
+    8: 'HOLD_ACTIONS_PENDING',
+    9: 'HOLD_ACTIONS_COMPLETE',
+    10: 'HOLD',
+    11: 'EXIT_ACTIONS_PENDING',
+    12: 'EXIT_ACTIONS_COMPLETE',
+}
+
+PID = 1
+TID_PLANNER = 1
+TID_STEPPER = 2
+TID_FEEDHOLD = 3
+TID_RX = 4
+TID_BUFFER_BASE = 100                   # one track per planner buffer
+
+
+def read_records(data):
+    """Yield (dropped, record tuple) from a raw capture, resyncing on garbage."""
+    pos = 0
+    end = len(data)
+    while pos + FRAME.size <= end:
+        sync, count, version, dropped = FRAME.unpack_from(data, pos)
+        frame_end = pos + FRAME.size + count * RECORD.size
+        if (sync != TRACE_SYNC or version != TRACE_VERSION or
+                count == 0 or count > MAX_BATCH or frame_end > end):
+            pos += 1
+            continue
+        pos += FRAME.size
+        for _ in range(count):
+            yield dropped, RECORD.unpack_from(data, pos)
+            pos += RECORD.size
+
+
+def convert(data):
+    events = []
+    names = {
+        TID_PLANNER: 'forward plan',
+        TID_STEPPER: 'load move',
+        TID_FEEDHOLD: 'feedhold',
+        TID_RX: 'rx lines',
+    }
+    buffer_open = {}                    # buffer number -> open state slice name
+    plan_open = False
+    last_load = None
+    last_dropped = 0
+    wraps = 0
+    last_time = None
+    last_seq = None
+
+    for dropped, (time_us, seq, event, arg, value) in read_records(data):
+        # unwrap the 32 bit microsecond clock
+        if last_time is not None and time_us + wraps < last_time - (1 << 31):
+            wraps += 1 << 32
+        ts = time_us + wraps
+        last_time = ts
+
+        if last_seq is not None and ((last_seq + 1) & 0xFFFF) != seq and dropped == last_dropped:
+            events.append({'name': 'seq gap', 'ph': 'i', 's': 'g', 'pid': PID,
+                           'tid': TID_PLANNER, 'ts': ts})
+        last_seq = seq
+        if dropped != last_dropped:
+            events.append({'name': 'dropped', 'ph': 'C', 'pid': PID, 'ts': ts,
+                           'args': {'records': dropped}})
+            last_dropped = dropped
+
+        name = EVENTS.get(event, 'EVENT_%d' % event)
+
+        if name == 'BUFFER_STATE':
+            tid = TID_BUFFER_BASE + arg
+            names.setdefault(tid, 'mb %02d' % arg)
+            if buffer_open.pop(arg, None) is not None:
+                events.append({'ph': 'E', 'pid': PID, 'tid': tid, 'ts': ts})
+            if value != 0:
+                state = BUFFER_STATES.get(value, str(value))
+                events.append({'name': state, 'ph': 'B', 'pid': PID, 'tid': tid, 'ts': ts})
+                buffer_open[arg] = state
+
+        elif name == 'FORWARD_PLAN_START':
+            if plan_open:
+                events.append({'ph': 'E', 'pid': PID, 'tid': TID_PLANNER, 'ts': ts})
+            events.append({'name': 'mp_forward_plan', 'ph': 'B', 'pid': PID,
+                           'tid': TID_PLANNER, 'ts': ts})
+            plan_open = True
+
+        elif name == 'FORWARD_PLAN_END':
+            if plan_open:
+                events.append({'ph': 'E', 'pid': PID, 'tid': TID_PLANNER, 'ts': ts,
+                               'args': {'planned': bool(arg)}})
+                plan_open = False
+
+        elif name == 'LOAD_MOVE':
+            events.append({'name': BLOCK_TYPES.get(arg, str(arg)), 'ph': 'i', 's': 't',
+                           'pid': PID, 'tid': TID_STEPPER, 'ts': ts,
+                           'args': {'dda_ticks': value}})
+            if last_load is not None:
+                events.append({'name': 'load interval us', 'ph': 'C', 'pid': PID, 'ts': ts,
+                               'args': {'us': ts - last_load}})
+            last_load = ts
+
+        elif name == 'FEEDHOLD':
+            events.append({'name': FEEDHOLD_STATES.get(arg, str(arg)), 'ph': 'i', 's': 'p',
+                           'pid': PID, 'tid': TID_FEEDHOLD, 'ts': ts,
+                           'args': {'hold_type': value}})
+
+        elif name == 'FEEDHOLD_STOP':
+            events.append({'name': 'stopped', 'ph': 'i', 's': 'p', 'pid': PID,
+                           'tid': TID_FEEDHOLD, 'ts': ts,
+                           'args': {'hold_type': arg, 'distance_mm': value / 1000.0}})
+
+        elif name == 'RX_LINE':
+            events.append({'name': 'ctrl line' if arg else 'line', 'ph': 'i', 's': 't',
+                           'pid': PID, 'tid': TID_RX, 'ts': ts,
+                           'args': {'length': value}})
+
+        else:
+            events.append({'name': name, 'ph': 'i', 's': 't', 'pid': PID,
+                           'tid': TID_PLANNER, 'ts': ts, 'args': {'arg': arg, 'value': value}})
+
+    for tid, tname in names.items():
+        events.append({'name': 'thread_name', 'ph': 'M', 'pid': PID, 'tid': tid,
+                       'args': {'name': tname}})
+    events.append({'name': 'process_name', 'ph': 'M', 'pid': PID, 'args': {'name': 'g2core'}})
+    return {'traceEvents': events, 'displayTimeUnit': 'ms'}
+
+
+def capture(port, baud, seconds):
+    import serial                       # pyserial, only needed for live capture
+    import time
+    data = bytearray()
+    with serial.Serial(port, baud, timeout=0.1) as ser:
+        stop = time.time() + seconds
+        while time.time() < stop:
+            data += ser.read(4096)
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a g2core event trace to Chrome-trace JSON')
+    parser.add_argument('capture', nargs='?', help='raw capture file (omit with --port)')
+    parser.add_argument('-o', '--output', help='output JSON file (default stdout)')
+    parser.add_argument('--port', help='capture live from this serial port instead of a file')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--seconds', type=float, default=10.0, help='live capture duration')
+    args = parser.parse_args()
+
+    if args.port:
+        data = capture(args.port, args.baud, args.seconds)
+    elif args.capture:
+        with open(args.capture, 'rb') as f:
+            data = f.read()
+    else:
+        parser.error('need a capture file or --port')
+
+    out = open(args.output, 'w') if args.output else sys.stdout
+    json.dump(convert(data), out)
+    if args.output:
+        out.close()
+
+
+if __name__ == '__main__':
+    main()
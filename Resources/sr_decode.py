@@ -0,0 +1,125 @@
+# coding=utf-8
+"""
+sr_decode.py - decode g2core compact status reports back into status report dicts
+
+Send {"sf":1} on a channel to have its automatic status reports sent in compact form.
+Feed every line read from that channel to SRDecoder.feed(). Compact lines ('@...')
+return the decoded report: the full report for a keyframe, only the changed values for
+a delta, the same as a filtered JSON report. Any other line is returned as None and
+can be handled as usual JSON.
+
+    dec = SRDecoder()
+    for line in port:
+        sr = dec.feed(line)
+        if sr is not None:
+            update_display(sr)          # e.g. {'posx': 12.345, 'vel': 1200.0}
+
+dec.state always holds the latest value of every field. The wire format is described
+at the top of the status report section of g2core/report.cpp. Run as a script to turn
+a capture of a compact channel back into {"sr":...} JSON lines.
+"""
+import argparse
+import json
+import sys
+
+
+class SRDecodeError(ValueError):
+    pass
+
+
+class SRDecoder(object):
+    def __init__(self):
+        self.fields = []                # (token, precision) in SR order
+        self.raw = []                   # scaled integer values, None for null fields
+        self.state = {}                 # token -> latest decoded value
+
+    def _value(self, i):
+        token, precision = self.fields[i]
+        raw = self.raw[i]
+        if raw is None:
+            return None
+        if precision == 0:
+            return raw
+        return raw / float(10 ** precision)
+
+    def _field_list(self, body):
+        self.fields = []
+        for item in body.split(','):
+            token, _, precision = item.rpartition('.')
+            self.fields.append((token, int(precision)))
+        self.raw = [None] * len(self.fields)
+        self.state = {}
+        return None                     # values follow in the keyframe
+
+    def _keyframe(self, body):
+        values = body.split(',')
+        if len(values) != len(self.fields):
+            raise SRDecodeError('keyframe has %d values for %d fields' % (len(values), len(self.fields)))
+        report = {}
+        for i, v in enumerate(values):
+            self.raw[i] = int(v) if v != '' else None
+            report[self.fields[i][0]] = self._value(i)
+        self.state.update(report)
+        return report
+
+    def _delta(self, body):
+        if not self.fields:
+            raise SRDecodeError('delta before the first keyframe')
+        mask_text, _, deltas = body.partition(':')
+        mask = int(mask_text, 16)
+        deltas = [int(d) for d in deltas.split(',')] if deltas else []
+        changed = [i for i in range(len(self.fields)) if mask & (1 << i)]
+        if mask >> len(self.fields) or any(self.raw[i] is None for i in changed):
+            raise SRDecodeError('delta does not match the field list')
+        if len(changed) != len(deltas):
+            raise SRDecodeError('delta has %d values for %d mask bits' % (len(deltas), len(changed)))
+        report = {}
+        for i, d in zip(changed, deltas):   # checked first, so a bad delta leaves the state alone
+            self.raw[i] += d
+            report[self.fields[i][0]] = self._value(i)
+        self.state.update(report)
+        return report
+
+    def feed(self, line):
+        """Decode one line. Returns a report dict for a compact SR, None otherwise."""
+        line = line.strip()
+        if len(line) < 3 or line[0] != '@' or line[2] != ':':
+            return None
+        kind, body = line[1], line[3:]
+        if kind == 'F':
+            return self._field_list(body)
+        if kind == 'K':
+            return self._keyframe(body)
+        if kind == 'D':
+            return self._delta(body)
+        raise SRDecodeError('unknown compact report type %r' % kind)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode g2core compact status reports to JSON')
+    parser.add_argument('capture', nargs='?', help='captured channel output (default stdin)')
+    parser.add_argument('--full', action='store_true', help='print the full state for every report')
+    args = parser.parse_args()
+
+    dec = SRDecoder()
+    src = open(args.capture) if args.capture else sys.stdin
+    status = 0
+    for lineno, line in enumerate(src, 1):
+        try:
+            report = dec.feed(line)
+        except (SRDecodeError, ValueError) as e:
+            # e.g. a capture started mid-stream - the next keyframe gets back in step
+            sys.stderr.write('%s:%d: %s\n' % (args.capture or '<stdin>', lineno, e))
+            status = 1
+            continue
+        if report is None:
+            if not line.startswith('@'):
+                sys.stdout.write(line)  # pass the JSON through
+            continue
+        json.dump({'sr': dec.state if args.full else report}, sys.stdout, separators=(',', ':'))
+        sys.stdout.write('\n')
+    return status
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -101,7 +101,11 @@ void hardware_init()
 {
     spiBus.init();
     sd_card.init();
+#if SD_PERSISTENCE_JOURNAL
+    setup_sd_journal_persistence();
+#else
     setup_sd_persistence();
+#endif
     board_hardware_init();
     toolhead_for_tool(0)->init();
     spindle_set_toolhead(toolhead_for_tool(0));
@@ -66,6 +66,18 @@ HOT_DATA Trinamic2130<SPIBus_used_t::SPIBusDevice,
     motor_2 {spiBus, Motate::SPIChipSelectPin<Motate::kSocket2_SPISlaveSelectPinNumber>{}};
 #endif // QUADRATIC_REVISION == 'C'
 
+#if QUADRATIC_REVISION == 'C'
+// Poll both drivers' DRV_STATUS from the same tick (see gquintic/board_stepper.cpp)
+int16_t trinamic_poll_counter_ = TRINAMIC_STATUS_POLL_MS;
+Motate::SysTickEvent trinamic_status_tick_event {[&] {
+    if (!--trinamic_poll_counter_) {
+        motor_1.pollStatus();
+        motor_2.pollStatus();
+        trinamic_poll_counter_ = TRINAMIC_STATUS_POLL_MS;
+    }
+}, nullptr};
+#endif
+
 
 HOT_DATA StepDirHobbyServo<Motate::kServo1_PinNumber> motor_3;
 
@@ -74,4 +86,7 @@ Stepper* const Motors[MOTORS] = {&motor_1, &motor_2, &motor_3};
 
 void board_stepper_init() {
     for (uint8_t motor = 0; motor < MOTORS; motor++) { Motors[motor]->init(); }
+#if QUADRATIC_REVISION == 'C'
+    Motate::SysTickTimer.registerEvent(&trinamic_status_tick_event);
+#endif
 }
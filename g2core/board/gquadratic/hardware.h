@@ -65,6 +65,7 @@
 #if QUADRATIC_REVISION == 'C'
 #define MOTOR_1_IS_TRINAMIC
 #define MOTOR_2_IS_TRINAMIC
+#define TRINAMIC_STATUS_POLL_MS 5    // ms between DRV_STATUS (stallGuard, temperature, open load) polls of all drivers
 #include "MotateSPI.h"
 #endif
 #include "MotateTimers.h"       // for TimerChanel<> and related...
@@ -101,6 +101,10 @@ ESCSpindle esc_spindle {SPINDLE_PWM_NUMBER, SPINDLE_ENABLE_OUTPUT_NUMBER, SPINDL
 #error LASER_FIRE_PIN_NUMBER should be defined in settings or a board file!
 #endif
 
+#ifndef LASER_VELOCITY_POWER
+#define LASER_VELOCITY_POWER false  // {th2vp: scale M3 power with velocity
+#endif
+
 #include "laser_toolhead.h"
 HOT_DATA LaserTool_used_t laser_tool {LASER_ENABLE_OUTPUT_NUMBER, MOTOR_6};
 
@@ -424,12 +428,23 @@ stat_t set_max_ppm(nvObj_t *nv) {
     return (STAT_OK);
 }
 
+stat_t get_velocity_power(nvObj_t *nv) {
+    return (get_boolean(nv, laser_tool.get_velocity_power()));
+}
+stat_t set_velocity_power(nvObj_t *nv) {
+    bool velocity_power = false;
+    ritorno(set_boolean(nv, velocity_power));
+    laser_tool.set_velocity_power(velocity_power);
+    return (STAT_OK);
+}
+
 constexpr cfgItem_t sys_config_items_3[] = {
     { "th2","th2pd", _iip,  0, tx_print_nul, get_pulse_duration, set_pulse_duration, nullptr, LASER_PULSE_DURATION },
     { "th2","th2mns", _fip,  0, tx_print_nul, get_min_s, set_min_s, nullptr, LASER_MIN_S },
     { "th2","th2mxs", _fip,  0, tx_print_nul, get_max_s, set_max_s, nullptr, LASER_MAX_S },
     { "th2","th2mnp", _fip,  0, tx_print_nul, get_min_ppm, set_min_ppm, nullptr, LASER_MIN_PPM },
     { "th2","th2mxp", _fip,  0, tx_print_nul, get_max_ppm, set_max_ppm, nullptr, LASER_MAX_PPM },
+    { "th2","th2vp",  _bip,  0, tx_print_nul, get_velocity_power, set_velocity_power, nullptr, LASER_VELOCITY_POWER },
 };
 
 constexpr cfgSubtableFromStaticArray sys_config_3{sys_config_items_3};
@@ -101,6 +101,22 @@ Stepper* const Motors[MOTORS] = {&motor_1, &motor_2, &motor_3, &motor_4, &motor_
 #endif // 'D'
 
 
+// Poll every driver's DRV_STATUS from the same tick, so the reads go out as one
+// back-to-back burst on the SPI bus rather than scattered through the main loop
+int16_t trinamic_poll_counter_ = TRINAMIC_STATUS_POLL_MS;
+Motate::SysTickEvent trinamic_status_tick_event {[&] {
+    if (!--trinamic_poll_counter_) {
+        motor_1.pollStatus();
+        motor_2.pollStatus();
+        motor_3.pollStatus();
+        motor_4.pollStatus();
+#if QUINTIC_REVISION == 'D'
+        motor_5.pollStatus();
+#endif
+        trinamic_poll_counter_ = TRINAMIC_STATUS_POLL_MS;
+    }
+}, nullptr};
+
 #if (KINEMATICS == KINE_FOUR_CABLE)
 HOT_DATA encoder_0_t encoder_0{plex0, M1_ENCODER_INPUT_A, M1_ENCODER_INPUT_B, 1 << 0};
 HOT_DATA encoder_1_t encoder_1{plex0, M2_ENCODER_INPUT_A, M2_ENCODER_INPUT_B, 1 << 1};
@@ -127,5 +143,6 @@ ExternalEncoder* const ExternalEncoders[0] = {};
 
 void board_stepper_init() {
     for (uint8_t motor = 0; motor < MOTORS; motor++) { Motors[motor]->init(); }
+    Motate::SysTickTimer.registerEvent(&trinamic_status_tick_event);
     // Motate::SysTickTimer.registerEvent(&external_encoders_tick_event);
 }
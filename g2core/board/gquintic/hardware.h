@@ -87,6 +87,7 @@
 #if QUINTIC_REVISION == 'D'
 #define MOTOR_5_IS_TRINAMIC
 #endif
+#define TRINAMIC_STATUS_POLL_MS 5    // ms between DRV_STATUS (stallGuard, temperature, open load) polls of all drivers
 
 /*************************
  * Global System Defines *
@@ -111,6 +111,7 @@
 #include "settings.h"
 #include "xio.h"            // for serial queue flush
 #include "kinematics.h"     // for forward kinematics in cm_cycle_start
+#include "raster.h"
 
 /****************************************************************************************
  **** CM GLOBALS & STRUCTURE ALLOCATIONS ************************************************
@@ -291,6 +292,7 @@ void canonical_machine_init(cmMachine_t *_cm, void *_mp)
 
     canonical_machine_init_assertions(_cm);         // establish assertions
     cm_arc_init(_cm);                               // setup arcs. Note: spindle and coolant inits are independent
+    cm_drill_cycle_init(_cm);                       // setup canned drilling cycles
     _cm->mp = _mp;                                  // point to associated planner
     _cm->am = MODEL;                                // setup initial Gcode model pointer
 }
@@ -308,6 +310,7 @@ void canonical_machine_reset(cmMachine_t *_cm)
     cm_set_path_control(MODEL, cm->default_path_control);
     cm_set_distance_mode(cm->default_distance_mode);
     cm_set_arc_distance_mode(INCREMENTAL_DISTANCE_MODE); // always the default
+    cm_set_retract_mode(RETRACT_TO_INITIAL_LEVEL);  // always the default
     cm_set_feed_rate_mode(UNITS_PER_MINUTE_MODE);   // always the default
     cm_reset_overrides();                           // set overrides to initial conditions
 
@@ -346,6 +349,7 @@ void canonical_machine_reset_rotation(cmMachine_t *_cm) {
     // Separately handle a z-offset so that the new plane maintains a consistent
     // distance from the old one. We only need z, since we are rotating to the z axis.
     _cm->rotation_z_offset = 0.0;
+    _cm->rotation_active = false;
 }
 
 /****************************************************************************************
@@ -516,6 +520,7 @@ stat_t cm_check_linenum() {
  ****************************************************************************************/
 /*
  * cm_get_combined_offset() - return the combined offsets for an axis (G53-G59, G92, Tools)
+ * cm_invalidate_combined_offsets() - force the combined offsets to be recomputed on next use
  * cm_get_display_offset()  - return the current display offset from pecified Gcode model
  * cm_set_display_offsets() - capture combined offsets from the model into absolute values
  *                            in the active Gcode dynamic model
@@ -546,6 +551,11 @@ stat_t cm_check_linenum() {
  *
  *    - cm_get_combined_offset() puts the above together to provide a combined, active offset.
  *      G92 offsets are only included if g92 is active (gmx.g92_offset_enable == true)
+ *    - The combined offsets are cached in cm.combined_offset[] so a move does not add them
+ *      up again for every axis. The cache is recomputed when the coordinate system or G92
+ *      enable differs from the one it was built for (these also change when a saved gm is
+ *      restored), and anything that writes the offsets themselves (G10, G43/G49, G92,
+ *      the coordinate and tool offset config items) must call cm_invalidate_combined_offsets()
  *
  *  Display offsets
  *      *** Display offsets are for display only and CANNOT be used to set positions ***
@@ -567,16 +577,35 @@ stat_t cm_check_linenum() {
  *      move will run in absolute coordinates and POS will display using no offsets.
  */
 
+static const float *_get_combined_offsets()
+{
+    if (!cm->combined_offset_valid ||
+        (cm->combined_offset_coord != cm->gm.coord_system) ||
+        (cm->combined_offset_g92 != cm->gmx.g92_offset_enable)) {
+        for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+            cm->combined_offset[axis] = cm->coord_offset[cm->gm.coord_system][axis] + cm->tool_offset[axis];
+            if (cm->gmx.g92_offset_enable == true) {
+                cm->combined_offset[axis] += cm->gmx.g92_offset[axis];
+            }
+        }
+        cm->combined_offset_coord = cm->gm.coord_system;
+        cm->combined_offset_g92 = cm->gmx.g92_offset_enable;
+        cm->combined_offset_valid = true;
+    }
+    return (cm->combined_offset);
+}
+
 float cm_get_combined_offset(const uint8_t axis)
 {
     if (cm->gm.absolute_override >= ABSOLUTE_OVERRIDE_ON_DISPLAY_WITH_OFFSETS) {
         return (0);
     }
-    float offset = cm->coord_offset[cm->gm.coord_system][axis] + cm->tool_offset[axis];
-    if (cm->gmx.g92_offset_enable == true) {
-        offset += cm->gmx.g92_offset[axis];
-    }
-    return (offset);
+    return (_get_combined_offsets()[axis]);
+}
+
+void cm_invalidate_combined_offsets()
+{
+    cm->combined_offset_valid = false;
 }
 
 float cm_get_display_offset(const GCodeState_t *gcode_state, const uint8_t axis)
@@ -586,21 +615,16 @@ float cm_get_display_offset(const GCodeState_t *gcode_state, const uint8_t axis)
 
 void cm_set_display_offsets(GCodeState_t *gcode_state)
 {
-    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
-
-        // if absolute override is on for G53 so position should be displayed with no offsets
-        if (cm->gm.absolute_override == ABSOLUTE_OVERRIDE_ON_DISPLAY_WITH_NO_OFFSETS) {
+    // if absolute override is on for G53 so position should be displayed with no offsets
+    if (cm->gm.absolute_override == ABSOLUTE_OVERRIDE_ON_DISPLAY_WITH_NO_OFFSETS) {
+        for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
             gcode_state->display_offset[axis] = 0;
         }
+    }
 
-        // all other cases: position should be displayed with currently active offsets
-        else {
-            gcode_state->display_offset[axis] = cm->coord_offset[cm->gm.coord_system][axis] +
-                                                cm->tool_offset[axis];
-            if (cm->gmx.g92_offset_enable == true) {
-                gcode_state->display_offset[axis] += cm->gmx.g92_offset[axis];
-            }
-        }
+    // all other cases: position should be displayed with currently active offsets
+    else {
+        copy_vector(gcode_state->display_offset, _get_combined_offsets());
     }
 
     // If we're not in cycle, then no moves are queued to update the runtime offsets
@@ -809,9 +833,43 @@ stat_t cm_set_tram(nvObj_t *nv)
     cm->rotation_z_offset = (n_x*cm->probe_results[1][0] +
                              n_y*cm->probe_results[1][1]) /
                              n_z + cm->probe_results[1][2];
+    cm->rotation_active = true;
     return (STAT_OK);
 }
 
+/****************************************************************************************
+ * cm_get_mesh() - JSON query to determine if height-map compensation is active
+ * cm_set_mesh() - JSON command to load the last grid probe as the height map, or clear it
+ *
+ * For set_mesh there MUST be a completed grid probe ({"gprb":...}). See mp_mesh_load().
+ */
+
+stat_t cm_get_mesh(nvObj_t *nv)
+{
+    nv->value_int = mp_mesh_enabled();
+    nv->valuetype = TYPE_BOOLEAN;
+    return (STAT_OK);
+}
+
+stat_t cm_set_mesh(nvObj_t *nv)
+{
+    if ((cm->machine_state == MACHINE_CYCLE) || mp_has_runnable_buffer(mp)) {
+        return (STAT_COMMAND_NOT_ACCEPTED);     // don't change the map under queued moves
+    }
+    if (!nv->value_int) {
+        mp_mesh_disable();
+        return (STAT_OK);
+    }
+
+    uint8_t nx, ny;
+    float origin[2], step[2];
+    const float *z = cm_get_probe_grid(&nx, &ny, origin, step);
+    if (z == nullptr) {
+        return (STAT_COMMAND_NOT_ACCEPTED);     // no completed grid
+    }
+    return (mp_mesh_load(z, nx, ny, origin, step));
+}
+
 /****************************************************************************************
  * cm_set_nxt_line() - JSON command to set the next line number
  * cm_get_nxt_line() - JSON query to get the next expected line number
@@ -834,6 +892,168 @@ stat_t cm_get_nxln(nvObj_t *nv)
     return (STAT_OK);
 }
 
+/****************************************************************************************
+ * SEEK TO LINE (fast job restart)
+ *
+ * cm_set_seek()           - JSON command {seek:N} to restart the job stream at line N, 0 cancels
+ * cm_get_seek()           - JSON query returns the line being sought, 0 if not seeking
+ * cm_seek_start()         - arm a seek
+ * cm_seek_move_global()   - model-only G0, G1, G2, G3 (see cm_drill_cycle_seek() for canned cycles)
+ * cm_seek_goto_position() - model-only G28, G30
+ * cm_seek_finish()        - approach the restart point and hand back to normal execution
+ *
+ *  While a seek is armed the host re-sends the job from the top. Blocks before the
+ *  target line are run through the Gcode model only: units, planes, offsets, coordinate
+ *  systems, feed rate, tool and distance modes are applied as usual and motion updates
+ *  gmx.position, but nothing is sent to the planner. S, T, M3/M4/M5, M6 and M7/M8/M9
+ *  are recorded instead of executed, and dwells, homing, probing and M100/M101 are
+ *  skipped. T and M6 can't be queued while seeking: the tool is set by the planner
+ *  at runtime, and M6 waits for the queue to drain.
+ *
+ *  The current line is taken from N words only, so the host has to number the blocks it
+ *  re-sends. The firmware can't count lines itself: the RX scanner drops blank lines and
+ *  reads JSON and other control lines ahead of the Gcode around them. A block without an
+ *  N word belongs to the last numbered one, and blocks before the first N word (a
+ *  preamble) are line 0.
+ *
+ *  When the target line arrives cm_seek_finish() queues a safe approach from the real
+ *  machine position: raise Z (to the higher of the current and target Z, or to Z max if
+ *  Z is homed), select and change tools if the skipped blocks did, traverse the other
+ *  axes, restore spindle and coolant, then drop Z to the target at the modal feed rate.
+ *  The target line then executes normally.
+ */
+
+stat_t cm_seek_start(const int32_t line)
+{
+    if (line <= 0) {                                // cancel - resync the model with the planner
+        if (cm->seek.active) {
+            cm->seek.active = false;
+            copy_vector(cm->gmx.position, mp->position);
+        }
+        return (STAT_OK);
+    }
+    if (cm->machine_state == MACHINE_CYCLE) {       // must restart from a stopped machine
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    cm->seek.active = true;
+    cm->seek.target_line = line;
+    cm->seek.line = 0;
+    cm->seek.spindle_speed = 0;
+    cm->seek.spindle_speed_set = false;
+    cm->seek.spindle_direction = SPINDLE_OFF;
+    cm->seek.tool_select = 0;
+    cm->seek.tool_select_set = false;
+    cm->seek.tool_change = false;
+    cm->seek.mist = false;
+    cm->seek.flood = false;
+    return (STAT_OK);
+}
+
+stat_t cm_set_seek(nvObj_t *nv)
+{
+    if (nv->valuetype != TYPE_INTEGER && nv->valuetype != TYPE_FLOAT) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    return (cm_seek_start(nv->value_int));
+}
+
+stat_t cm_get_seek(nvObj_t *nv)
+{
+    nv->value_int = (cm->seek.active ? cm->seek.target_line : 0);
+    nv->valuetype = TYPE_INTEGER;
+    return (STAT_OK);
+}
+
+stat_t cm_seek_move_global(const float *target, const bool *flags, const cmMotionMode motion_mode)
+{
+    float target_mm[AXES];
+    cm->gm.motion_mode = motion_mode;
+    cm_axes_to_mm(target, target_mm, flags);
+    cm_set_model_target(target_mm, flags);
+    cm_update_model_position();
+    return (STAT_OK);
+}
+
+stat_t cm_seek_goto_position(const float position[])
+{
+    copy_vector(cm->gm.target, position);           // stored positions are absolute machine mm
+    cm->gm.motion_mode = MOTION_MODE_STRAIGHT_TRAVERSE;
+    cm_update_model_position();
+    return (STAT_OK);
+}
+
+stat_t cm_seek_finish()
+{
+    float target[AXES];
+    bool flags[] = INIT_AXES_FALSE;
+
+    cm->seek.active = false;
+    copy_vector(target, cm->gmx.position);          // where the skipped blocks left the model
+    copy_vector(cm->gmx.position, mp->position);    // moves are planned from the real position
+
+    cmMotionMode saved_motion_mode = cm->gm.motion_mode;
+    cmDistanceMode saved_distance_mode = cm->gm.distance_mode;
+    cm_set_absolute_override(MODEL, ABSOLUTE_OVERRIDE_ON_DISPLAY_WITH_OFFSETS);  // target is in machine coords
+    cm_set_distance_mode(ABSOLUTE_DISTANCE_MODE);
+
+    // raise Z clear of the work, then traverse everything else to the restart point
+    float safe_z = std::max(cm->gmx.position[AXIS_Z], target[AXIS_Z]);
+    if (cm->homed[AXIS_Z]) {
+        safe_z = std::max(safe_z, cm->a[AXIS_Z].travel_max);
+    }
+    float approach[AXES];
+    copy_vector(approach, target);
+    approach[AXIS_Z] = safe_z;
+
+    flags[AXIS_Z] = true;
+    stat_t status = cm_straight_traverse_mm(approach, flags, PROFILE_NORMAL);
+
+    // change tools with Z up, before the spindle is brought back on the new toolhead
+    if (status == STAT_OK && cm->seek.tool_select_set) {
+        status = cm_select_tool(cm->seek.tool_select);
+    }
+    if (status == STAT_OK && cm->seek.tool_change) {
+        status = cm_change_tool(cm->seek.tool_select);
+    }
+    if (status == STAT_OK) {
+        for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+            flags[axis] = (axis != AXIS_Z);
+        }
+        status = cm_straight_traverse_mm(approach, flags, PROFILE_NORMAL);
+    }
+
+    // bring the spindle and coolant back to the state the skipped blocks left them in
+    if (status == STAT_OK && cm->seek.spindle_speed_set) {
+        status = spindle_set_speed(cm->seek.spindle_speed);
+    }
+    if (status == STAT_OK) {
+        status = spindle_set_direction((spDirection)cm->seek.spindle_direction);
+    }
+    if (status == STAT_OK) {
+        status = coolant_control_sync(cm->seek.mist ? COOLANT_ON : COOLANT_OFF, COOLANT_MIST);
+    }
+    if (status == STAT_OK) {
+        status = coolant_control_sync(cm->seek.flood ? COOLANT_ON : COOLANT_OFF, COOLANT_FLOOD);
+    }
+
+    // plunge at the modal feed rate if there is a usable one
+    if (status == STAT_OK) {
+        for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+            flags[axis] = (axis == AXIS_Z);
+        }
+        if ((cm->gm.feed_rate_mode == UNITS_PER_MINUTE_MODE) && (cm->gm.feed_rate > 0)) {
+            status = cm_straight_feed_mm(target, flags, PROFILE_NORMAL);
+        } else {
+            status = cm_straight_traverse_mm(target, flags, PROFILE_NORMAL);
+        }
+    }
+
+    cm_set_absolute_override(MODEL, ABSOLUTE_OVERRIDE_OFF);
+    cm_set_distance_mode(saved_distance_mode);
+    cm->gm.motion_mode = saved_motion_mode;
+    return (status);
+}
+
 /****************************************************************************************
  * cm_set_model_target() - set target vector in GM model
  *
@@ -872,9 +1092,14 @@ static float _calc_ABC(const uint8_t axis, const float target[])
 
 void cm_set_model_target(const float target[], const bool flags[])
 {
+    static const float no_offset[] = INIT_AXES_ZEROES;
     uint8_t axis;
     float tmp = 0;
 
+    // resolve the work offsets once for the block - same as cm_get_combined_offset()
+    const float *offset = (cm->gm.absolute_override >= ABSOLUTE_OVERRIDE_ON_DISPLAY_WITH_OFFSETS) ?
+                          no_offset : _get_combined_offsets();
+
     // copy position to target so it always starts correctly
     copy_vector(cm->gm.target, cm->gmx.position);
 
@@ -884,7 +1109,7 @@ void cm_set_model_target(const float target[], const bool flags[])
             continue;        // skip axis if not flagged for update or its disabled
         } else if (cm->a[axis].axis_mode == AXIS_STANDARD) {
             if (cm->gm.distance_mode == ABSOLUTE_DISTANCE_MODE) {
-                cm->gm.target[axis] = cm_get_combined_offset(axis) + target[axis];
+                cm->gm.target[axis] = offset[axis] + target[axis];
             } else {
                 cm->gm.target[axis] += target[axis];
             }
@@ -898,7 +1123,7 @@ void cm_set_model_target(const float target[], const bool flags[])
             continue;        // skip axis if not flagged for update or its disabled
         } else if (cm->a[axis].axis_mode == AXIS_INHIBITED) {    ////##A special case axis_inhibited = flag means linear in ABC
             if (cm->gm.distance_mode == ABSOLUTE_DISTANCE_MODE) {
-                cm->gm.target[axis] = cm_get_combined_offset(axis) + target[axis];
+                cm->gm.target[axis] = offset[axis] + target[axis];
             } else {
                 cm->gm.target[axis] += target[axis];
             }
@@ -915,7 +1140,7 @@ void cm_set_model_target(const float target[], const bool flags[])
                 cm->gm.target[axis] += tmp;
             }
             else { // if (cm.gmx.extruder_mode == EXTRUDER_MOVES_NORMAL)
-                cm->gm.target[axis] = tmp + cm_get_combined_offset(axis);
+                cm->gm.target[axis] = tmp + offset[axis];
             }
             // TODO - volumetric filament conversion
             //  else {
@@ -926,7 +1151,7 @@ void cm_set_model_target(const float target[], const bool flags[])
 #endif // MARLIN_COMPAT_ENABLED
 
             if (cm->gm.distance_mode == ABSOLUTE_DISTANCE_MODE) {
-                cm->gm.target[axis] = tmp + cm_get_combined_offset(axis); // sacidu93's fix to Issue #22
+                cm->gm.target[axis] = tmp + offset[axis]; // sacidu93's fix to Issue #22
             }
             else {
                 cm->gm.target[axis] += tmp;
@@ -996,6 +1221,7 @@ stat_t cm_test_soft_limits(const float target[])
  *  cm_set_units_mode()         - G20, G21
  *  cm_set_distance_mode()      - G90, G91
  *  cm_set_arc_distance_mode()  - G90.1, G91.1
+ *  cm_set_retract_mode()       - G98, G99
  *  cm_set_g10_data()           - G10 (delayed persistence)
  *
  *  These functions assume input validation occurred upstream, most likely in gcode parser.
@@ -1026,6 +1252,12 @@ stat_t cm_set_arc_distance_mode(const uint8_t mode)
     return (STAT_OK);
 }
 
+stat_t cm_set_retract_mode(const uint8_t mode)
+{
+    cm->gmx.retract_mode = (cmRetractMode)mode;          // 0 = initial level (G98), 1 = R level (G99)
+    return (STAT_OK);
+}
+
 /****************************************************************************************
  * cm_set_g10_data() - G10 L1/L2/L10/L20 Pn (affects MODEL only)
  *
@@ -1105,6 +1337,7 @@ stat_t cm_set_g10_data(const uint8_t P_word, const bool P_flag,
     else {
         return (STAT_L_WORD_IS_INVALID);
     }
+    cm_invalidate_combined_offsets();
     cm_set_display_offsets(MODEL);
     return (STAT_OK);
 }
@@ -1141,6 +1374,7 @@ stat_t cm_set_tl_offset(const uint8_t H_word, const bool H_flag, const bool appl
             cm->tool_offset[axis] = tt.tt_offset[tool][axis];
         }
     }
+    cm_invalidate_combined_offsets();
     cm_set_display_offsets(MODEL);                      // display new offsets in the model right now
     return (STAT_OK);
 }
@@ -1150,6 +1384,7 @@ stat_t cm_cancel_tl_offset()
     for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
         cm->tool_offset[axis] = 0;
     }
+    cm_invalidate_combined_offsets();
     cm_set_display_offsets(MODEL);                      // display new offsets in the model right now
    return (STAT_OK);
 }
@@ -1268,6 +1503,7 @@ stat_t cm_set_g92_offsets(const float offset[], const bool flag[])
                                        _to_millimeters(offset[axis]);
         }
     }
+    cm_invalidate_combined_offsets();
     // now pass the offset to the callback - setting the coordinate system also applies the offsets
     cm_set_display_offsets(MODEL);
     return (STAT_OK);
@@ -1279,6 +1515,7 @@ stat_t cm_reset_g92_offsets()
     for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
         cm->gmx.g92_offset[axis] = 0;
     }
+    cm_invalidate_combined_offsets();
     cm_set_display_offsets(MODEL);
     return (STAT_OK);
 }
@@ -1575,7 +1812,12 @@ stat_t cm_straight_feed_mm(const float *target, const bool *flags, const cmMotio
     ritorno(cm_test_soft_limits(cm->gm.target));  // test soft limits; exit if thrown
     cm_set_display_offsets(MODEL);                // capture the fully resolved offsets to the state
     cm_cycle_start();                             // required for homing & other cycles
+    cm->gm.raster = raster_attach(cm->gmx.position, cm->gm.target); // claim a pending raster scanline, if any
     stat_t status = mp_aline(MODEL);              // send the move to the planner
+    if (cm->gm.raster && (status != STAT_OK)) {
+        raster_detach();                          // the scanline waits for the next G1
+    }
+    cm->gm.raster = 0;
     cm_update_model_position();                   // <-- ONLY safe because we don't care about status...
 
     if (status == STAT_MINIMUM_LENGTH_MOVE) {
@@ -2166,6 +2408,10 @@ char cm_get_axis_char(const int8_t axis)    // Uses internal axis numbering
  * cm_get_mline() - get model line number for status reports
  * cm_get_line()  - get active (model or runtime) line number for status reports
  * cm_get_vel()   - get runtime velocity
+ * cm_get_hlat()  - get latency of the last feedhold, request to motion stopped (ms)
+ * cm_get_hdst()  - get stopping distance of the last feedhold (mm)
+ * cm_get_hprd()  - get stopping distance the hold planner predicted for the last feedhold (mm)
+ * cm_get_frol()  - get latency of the last feed override change, request to running block reshaped (ms)
  * cm_get_ofs()   - get current work offset (runtime)
  * cm_get_pos()   - get current work position (runtime)
  * cm_get_mpos()  - get current machine position (runtime)
@@ -2406,6 +2652,12 @@ stat_t cm_get_feed(nvObj_t *nv) {
     
     return (get_float(nv, feed_rate));
 }
+
+stat_t cm_get_hlat(nvObj_t *nv) { return (get_float(nv, cm->hold_stats.latency)); }
+stat_t cm_get_hdst(nvObj_t *nv) { return (get_float(nv, cm->hold_stats.stop_length)); }
+stat_t cm_get_hprd(nvObj_t *nv) { return (get_float(nv, cm->hold_stats.predicted_length)); }
+stat_t cm_get_frol(nvObj_t *nv) { return (get_float(nv, mp->mfo_latency)); }
+
 stat_t cm_get_pos(nvObj_t *nv)  { return (get_float(nv, cm_get_display_position(RUNTIME, _axis(nv)))); }
 stat_t cm_get_mpo(nvObj_t *nv)  { return (get_float(nv, cm_get_absolute_position(ACTIVE_MODEL, _axis(nv)))); }
 stat_t cm_get_ofs(nvObj_t *nv)  { return (get_float(nv, cm_get_display_offset(ACTIVE_MODEL, _axis(nv)))); }
@@ -2420,7 +2672,11 @@ stat_t cm_get_probe_input(nvObj_t *nv) { return (get_integer(nv, cm->probe_input
 stat_t cm_set_probe_input(nvObj_t *nv) { return (set_integer(nv, cm->probe_input, 0, D_IN_CHANNELS)); }
 
 stat_t cm_get_coord(nvObj_t *nv) { return (get_float(nv, cm->coord_offset[_coord(nv)][_axis(nv)])); }
-stat_t cm_set_coord(nvObj_t *nv) { return (set_float(nv, cm->coord_offset[_coord(nv)][_axis(nv)])); }
+stat_t cm_set_coord(nvObj_t *nv)
+{
+    cm_invalidate_combined_offsets();
+    return (set_float(nv, cm->coord_offset[_coord(nv)][_axis(nv)]));
+}
 
 stat_t cm_get_g92e(nvObj_t *nv)  { return (get_integer(nv, cm->gmx.g92_offset_enable)); }
 stat_t cm_get_g92(nvObj_t *nv)   { return (get_float(nv, cm->gmx.g92_offset[_axis(nv)])); }
@@ -2440,7 +2696,11 @@ static uint8_t _tool(nvObj_t *nv)
 }
 
 stat_t cm_get_tof(nvObj_t *nv) { return (get_float(nv, cm->tool_offset[_axis(nv)])); }
-stat_t cm_set_tof(nvObj_t *nv) { return (set_float(nv, cm->tool_offset[_axis(nv)])); }
+stat_t cm_set_tof(nvObj_t *nv)
+{
+    cm_invalidate_combined_offsets();
+    return (set_float(nv, cm->tool_offset[_axis(nv)]));
+}
 
 stat_t cm_get_tt(nvObj_t *nv)
 {
@@ -2619,6 +2879,16 @@ stat_t cm_set_jh(nvObj_t *nv)
  * cm_set_lb() - set homing latch backoff
  * cm_get_zb() - get homing zero backoff
  * cm_set_zb() - set homing zero backoff
+ * cm_get_sg() - get sensorless homing stall threshold
+ * cm_set_sg() - set sensorless homing stall threshold
+ * cm_get_sgc() - get the lowest load reading of the current stall calibration
+ * cm_set_sgc() - start (1) or finish (0) a stall calibration
+ *
+ *  Stall calibration records the load readings of the axis' drivers while the axis is
+ *  moved by other means (e.g. jogged at the search velocity, clear of any obstruction).
+ *  Only readings taken near the search velocity count, so the move must reach it.
+ *  Finishing sets the stall threshold to a fraction of the lowest reading. The new
+ *  threshold is not persisted - read {xsg:n} back and set it to keep it.
  */
 
 stat_t cm_get_hi(nvObj_t *nv) { return (get_integer(nv, cm->a[_axis(nv)].homing_input)); }
@@ -2633,6 +2903,16 @@ stat_t cm_get_lb(nvObj_t *nv) { return (get_float(nv, cm->a[_axis(nv)].latch_bac
 stat_t cm_set_lb(nvObj_t *nv) { return (set_float(nv, cm->a[_axis(nv)].latch_backoff)); }
 stat_t cm_get_zb(nvObj_t *nv) { return (get_float(nv, cm->a[_axis(nv)].zero_backoff)); }
 stat_t cm_set_zb(nvObj_t *nv) { return (set_float(nv, cm->a[_axis(nv)].zero_backoff)); }
+stat_t cm_get_sg(nvObj_t *nv) { return (get_integer(nv, cm->a[_axis(nv)].stall_threshold)); }
+stat_t cm_set_sg(nvObj_t *nv) { return (set_int32(nv, cm->a[_axis(nv)].stall_threshold, 0, UINT16_MAX)); }
+stat_t cm_get_sgc(nvObj_t *nv) { return (get_integer(nv, cm_homing_stall_calibration_value(_axis(nv)))); }
+stat_t cm_set_sgc(nvObj_t *nv)
+{
+    if (nv->value_int) {
+        return (cm_homing_stall_calibration_start(_axis(nv)));
+    }
+    return (cm_homing_stall_calibration_end(_axis(nv)));
+}
 
 /*** Canonical Machine Global Settings ***/
 /*
@@ -2640,6 +2920,8 @@ stat_t cm_set_zb(nvObj_t *nv) { return (set_float(nv, cm->a[_axis(nv)].zero_back
  * cm_set_jt()  - set junction integration time
  * cm_get_ct()  - get chordal tolerance
  * cm_set_ct()  - set chordal tolerance
+ * cm_get_fhj() - get feedhold high jerk enable
+ * cm_set_fhj() - set feedhold high jerk enable
  * cm_get_sl()  - get soft limit enable
  * cm_set_sl()  - set soft limit enable
  * cm_get_lim() - get hard limit enable
@@ -2666,19 +2948,32 @@ stat_t cm_set_ct(nvObj_t *nv) { return(set_float_range(nv, cm->chordal_tolerance
 stat_t cm_get_zl(nvObj_t *nv) { return(get_float(nv, cm->feedhold_z_lift)); }
 stat_t cm_set_zl(nvObj_t *nv) { return(set_float(nv, cm->feedhold_z_lift)); }
 
+stat_t cm_get_fhj(nvObj_t *nv) { return(get_integer(nv, cm->feedhold_high_jerk)); }
+stat_t cm_set_fhj(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->feedhold_high_jerk, 0, 1)); }
+
 stat_t cm_get_sl(nvObj_t *nv) { return(get_integer(nv, cm->soft_limit_enable)); }
 stat_t cm_set_sl(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->soft_limit_enable, 0, 1)); }
 
 stat_t cm_get_lim(nvObj_t *nv) { return(get_integer(nv, cm->limit_enable)); }
 stat_t cm_set_lim(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->limit_enable, 0, 1)); }
 
+stat_t cm_get_hms(nvObj_t *nv) { return(get_integer(nv, cm->homing_simultaneous)); }
+stat_t cm_set_hms(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->homing_simultaneous, 0, 1)); }
+
 stat_t cm_get_m48(nvObj_t *nv) { return(get_integer(nv, cm->gmx.m48_enable)); }
 stat_t cm_set_m48(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->gmx.m48_enable, 0, 1)); }
 
 stat_t cm_get_froe(nvObj_t *nv) { return(get_integer(nv, cm->gmx.mfo_enable)); }
 stat_t cm_set_froe(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->gmx.mfo_enable, 0, 1)); }
 stat_t cm_get_fro(nvObj_t *nv)  { return(get_float(nv, cm->gmx.mfo_factor)); }
-stat_t cm_set_fro(nvObj_t *nv)  { return(set_float_range(nv, cm->gmx.mfo_factor, FEED_OVERRIDE_MIN, FEED_OVERRIDE_MAX)); }
+stat_t cm_set_fro(nvObj_t *nv)
+{
+    ritorno(set_float_range(nv, cm->gmx.mfo_factor, FEED_OVERRIDE_MIN, FEED_OVERRIDE_MAX));
+    if (cm->gmx.m48_enable && cm->gmx.mfo_enable) {
+        mp_start_feed_override(FEED_OVERRIDE_RAMP_TIME, cm->gmx.mfo_factor);   // timestamps the change for {frol:}
+    }
+    return (STAT_OK);
+}
 
 stat_t cm_get_troe(nvObj_t *nv) { return(get_integer(nv, cm->gmx.mto_enable)); }
 stat_t cm_set_troe(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->gmx.mto_enable, 0, 1)); }
@@ -2733,6 +3028,7 @@ stat_t cm_set_gdi(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)cm->default_d
  * getOfsConfig_1() - offsets in play
  * getHomConfig_1() - homing info (should be in cycle_home)
  * getPrbConfig_1() - probing info (should in in cycle_probe)
+ * getGprbConfig_1() - grid probing parameters
  * getJogConfig_1() - control jogging (should be in cycle_jog)
  * getAxisConfig_1() - axis specific info
  */
@@ -2795,6 +3091,10 @@ constexpr cfgItem_t cm_config_items_1[] = {
     {"",  "line",  _ii, 0, cm_print_line, cm_get_line,  set_ro,        nullptr, 0},  // Active line number - model or runtime line number
     {"",  "vel",   _f0, 2, cm_print_vel,  cm_get_vel,   set_ro,        nullptr, 0},  // current velocity
     {"",  "feed",  _f0, 2, cm_print_feed, cm_get_feed,  set_ro,        nullptr, 0},  // feed rate
+    {"",  "hlat",  _f0, 1, cm_print_hlat, cm_get_hlat,  set_ro,        nullptr, 0},  // last feedhold stop latency (ms)
+    {"",  "hdst",  _f0, 3, cm_print_hdst, cm_get_hdst,  set_ro,        nullptr, 0},  // last feedhold stopping distance (mm)
+    {"",  "hprd",  _f0, 3, cm_print_hprd, cm_get_hprd,  set_ro,        nullptr, 0},  // last feedhold predicted stopping distance (mm)
+    {"",  "frol",  _f0, 1, cm_print_frol, cm_get_frol,  set_ro,        nullptr, 0},  // last feed override latency (ms)
     {"",  "macs",  _i0, 0, cm_print_macs, cm_get_macs,  set_ro,        nullptr, 0},  // raw machine state
     {"",  "cycs",  _i0, 0, cm_print_cycs, cm_get_cycs,  set_ro,        nullptr, 0},  // cycle state
     {"",  "mots",  _i0, 0, cm_print_mots, cm_get_mots,  set_ro,        nullptr, 0},  // motion state
@@ -2950,6 +3250,23 @@ constexpr cfgItem_t prb_config_items_1[] = {
 constexpr cfgSubtableFromStaticArray prb_config_1{prb_config_items_1};
 const configSubtable *const getPrbConfig_1() { return &prb_config_1; }
 
+// Grid probing: {"gprb":{"x0":..,"y0":..,"x1":..,"y1":..,"nx":..,"ny":..,"z":..,"c":..,"f":..,"go":1}}
+constexpr cfgItem_t gprb_config_items_1[] = {
+    {"gprb", "gprbx0", _f0, 4, tx_print_nul, cm_get_gprbx0, cm_set_gprbx0, nullptr, 0},  // first corner X
+    {"gprb", "gprby0", _f0, 4, tx_print_nul, cm_get_gprby0, cm_set_gprby0, nullptr, 0},  // first corner Y
+    {"gprb", "gprbx1", _f0, 4, tx_print_nul, cm_get_gprbx1, cm_set_gprbx1, nullptr, 0},  // opposite corner X
+    {"gprb", "gprby1", _f0, 4, tx_print_nul, cm_get_gprby1, cm_set_gprby1, nullptr, 0},  // opposite corner Y
+    {"gprb", "gprbnx", _i0, 0, tx_print_nul, cm_get_gprbnx, cm_set_gprbnx, nullptr, 0},  // points along X
+    {"gprb", "gprbny", _i0, 0, tx_print_nul, cm_get_gprbny, cm_set_gprbny, nullptr, 0},  // points along Y
+    {"gprb", "gprbz",  _f0, 4, tx_print_nul, cm_get_gprbz, cm_set_gprbz, nullptr, 0},    // probe target level
+    {"gprb", "gprbc",  _f0, 4, tx_print_nul, cm_get_gprbc, cm_set_gprbc, nullptr, 0},    // clearance level
+    {"gprb", "gprbf",  _f0, 2, tx_print_nul, cm_get_gprbf, cm_set_gprbf, nullptr, 0},    // probing feed rate
+    {"gprb", "gprbe",  _i0, 0, tx_print_nul, cm_get_gprbe, set_ro, nullptr, 0},          // 1 if the last grid completed
+    {"gprb", "gprbgo", _i0, 0, tx_print_nul, cm_get_gprbgo, cm_set_gprbgo, nullptr, 0},  // start the grid cycle
+};
+constexpr cfgSubtableFromStaticArray gprb_config_1{gprb_config_items_1};
+const configSubtable *const getGprbConfig_1() { return &gprb_config_1; }
+
 // constexpr cfgItem_t jog_config_items_1[] = {
 //     {"jog", "jogx", _f0, 0, tx_print_nul, get_nul, cm_run_jog, nullptr, 0},  // jog in X axis
 //     {"jog", "jogy", _f0, 0, tx_print_nul, get_nul, cm_run_jog, nullptr, 0},  // jog in Y axis
@@ -2998,6 +3315,8 @@ constexpr cfgItem_t axis_config_items_1[] = {
     {"x", "xlv", _fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, X_LATCH_VELOCITY},
     {"x", "xlb", _fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, X_LATCH_BACKOFF},
     {"x", "xzb", _fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, X_ZERO_BACKOFF},
+    {"x", "xsg", _iip, 0, cm_print_sg, cm_get_sg, cm_set_sg, nullptr, X_HOMING_STALL_THRESHOLD},
+    {"x", "xsgc", _i0, 0, cm_print_sgc, cm_get_sgc, cm_set_sgc, nullptr, 0},
 
     {"y", "yam", _iip, 0, cm_print_am, cm_get_am, cm_set_am, nullptr, Y_AXIS_MODE},
     {"y", "yvm", _fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, Y_VELOCITY_MAX},
@@ -3012,6 +3331,8 @@ constexpr cfgItem_t axis_config_items_1[] = {
     {"y", "ylv", _fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, Y_LATCH_VELOCITY},
     {"y", "ylb", _fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, Y_LATCH_BACKOFF},
     {"y", "yzb", _fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, Y_ZERO_BACKOFF},
+    {"y", "ysg", _iip, 0, cm_print_sg, cm_get_sg, cm_set_sg, nullptr, Y_HOMING_STALL_THRESHOLD},
+    {"y", "ysgc", _i0, 0, cm_print_sgc, cm_get_sgc, cm_set_sgc, nullptr, 0},
 
     {"z", "zam", _iip, 0, cm_print_am, cm_get_am, cm_set_am, nullptr, Z_AXIS_MODE},
     {"z", "zvm", _fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, Z_VELOCITY_MAX},
@@ -3026,6 +3347,8 @@ constexpr cfgItem_t axis_config_items_1[] = {
     {"z", "zlv", _fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, Z_LATCH_VELOCITY},
     {"z", "zlb", _fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, Z_LATCH_BACKOFF},
     {"z", "zzb", _fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, Z_ZERO_BACKOFF},
+    {"z", "zsg", _iip, 0, cm_print_sg, cm_get_sg, cm_set_sg, nullptr, Z_HOMING_STALL_THRESHOLD},
+    {"z", "zsgc", _i0, 0, cm_print_sgc, cm_get_sgc, cm_set_sgc, nullptr, 0},
 
 #if (AXES == 9)
     {"u", "uam", _iip, 0, cm_print_am, cm_get_am, cm_set_am, nullptr, U_AXIS_MODE},
@@ -3041,6 +3364,8 @@ constexpr cfgItem_t axis_config_items_1[] = {
     {"u", "ulv", _fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, U_LATCH_VELOCITY},
     {"u", "ulb", _fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, U_LATCH_BACKOFF},
     {"u", "uzb", _fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, U_ZERO_BACKOFF},
+    {"u", "usg", _iip, 0, cm_print_sg, cm_get_sg, cm_set_sg, nullptr, U_HOMING_STALL_THRESHOLD},
+    {"u", "usgc", _i0, 0, cm_print_sgc, cm_get_sgc, cm_set_sgc, nullptr, 0},
 
     {"v", "vam", _iip, 0, cm_print_am, cm_get_am, cm_set_am, nullptr, V_AXIS_MODE},
     {"v", "vvm", _fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, V_VELOCITY_MAX},
@@ -3055,6 +3380,8 @@ constexpr cfgItem_t axis_config_items_1[] = {
     {"v", "vlv", _fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, V_LATCH_VELOCITY},
     {"v", "vlb", _fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, V_LATCH_BACKOFF},
     {"v", "vzb", _fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, V_ZERO_BACKOFF},
+    {"v", "vsg", _iip, 0, cm_print_sg, cm_get_sg, cm_set_sg, nullptr, V_HOMING_STALL_THRESHOLD},
+    {"v", "vsgc", _i0, 0, cm_print_sgc, cm_get_sgc, cm_set_sgc, nullptr, 0},
 
     {"w", "wam", _iip, 0, cm_print_am, cm_get_am, cm_set_am, nullptr, W_AXIS_MODE},
     {"w", "wvm", _fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, W_VELOCITY_MAX},
@@ -3069,6 +3396,8 @@ constexpr cfgItem_t axis_config_items_1[] = {
     {"w", "wlv", _fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, W_LATCH_VELOCITY},
     {"w", "wlb", _fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, W_LATCH_BACKOFF},
     {"w", "wzb", _fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, W_ZERO_BACKOFF},
+    {"w", "wsg", _iip, 0, cm_print_sg, cm_get_sg, cm_set_sg, nullptr, W_HOMING_STALL_THRESHOLD},
+    {"w", "wsgc", _i0, 0, cm_print_sgc, cm_get_sgc, cm_set_sgc, nullptr, 0},
 #endif
 
     {"a", "aam", _iip, 0, cm_print_am, cm_get_am, cm_set_am, nullptr, A_AXIS_MODE},
@@ -3085,6 +3414,8 @@ constexpr cfgItem_t axis_config_items_1[] = {
     {"a", "alv", _fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, A_LATCH_VELOCITY},
     {"a", "alb", _fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, A_LATCH_BACKOFF},
     {"a", "azb", _fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, A_ZERO_BACKOFF},
+    {"a", "asg", _iip, 0, cm_print_sg, cm_get_sg, cm_set_sg, nullptr, A_HOMING_STALL_THRESHOLD},
+    {"a", "asgc", _i0, 0, cm_print_sgc, cm_get_sgc, cm_set_sgc, nullptr, 0},
 
     {"b", "bam", _iip, 0, cm_print_am, cm_get_am, cm_set_am, nullptr, B_AXIS_MODE},
     {"b", "bvm", _fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, B_VELOCITY_MAX},
@@ -3100,6 +3431,8 @@ constexpr cfgItem_t axis_config_items_1[] = {
     {"b", "blv", _fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, B_LATCH_VELOCITY},
     {"b", "blb", _fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, B_LATCH_BACKOFF},
     {"b", "bzb", _fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, B_ZERO_BACKOFF},
+    {"b", "bsg", _iip, 0, cm_print_sg, cm_get_sg, cm_set_sg, nullptr, B_HOMING_STALL_THRESHOLD},
+    {"b", "bsgc", _i0, 0, cm_print_sgc, cm_get_sgc, cm_set_sgc, nullptr, 0},
 
     {"c", "cam", _iip, 0, cm_print_am, cm_get_am, cm_set_am, nullptr, C_AXIS_MODE},
     {"c", "cvm", _fipc, 0, cm_print_vm, cm_get_vm, cm_set_vm, nullptr, C_VELOCITY_MAX},
@@ -3115,6 +3448,8 @@ constexpr cfgItem_t axis_config_items_1[] = {
     {"c", "clv", _fipc, 2, cm_print_lv, cm_get_lv, cm_set_lv, nullptr, C_LATCH_VELOCITY},
     {"c", "clb", _fipc, 5, cm_print_lb, cm_get_lb, cm_set_lb, nullptr, C_LATCH_BACKOFF},
     {"c", "czb", _fipc, 5, cm_print_zb, cm_get_zb, cm_set_zb, nullptr, C_ZERO_BACKOFF},
+    {"c", "csg", _iip, 0, cm_print_sg, cm_get_sg, cm_set_sg, nullptr, C_HOMING_STALL_THRESHOLD},
+    {"c", "csgc", _i0, 0, cm_print_sgc, cm_get_sgc, cm_set_sgc, nullptr, 0},
 };
 constexpr cfgSubtableFromStaticArray axis_config_1 {axis_config_items_1};
 const configSubtable * const getAxisConfig_1() { return &axis_config_1; }
@@ -3161,6 +3496,10 @@ stat_t cm_dam(nvObj_t *nv)
 
 static const char fmt_vel[]  = "Velocity:%17.3f%s/min\n";
 static const char fmt_feed[] = "Feed rate:%16.3f%s/min\n";
+static const char fmt_hlat[] = "Hold latency:%13.1f ms\n";
+static const char fmt_hdst[] = "Hold distance:%12.3f mm\n";
+static const char fmt_hprd[] = "Hold predicted:%11.3f mm\n";
+static const char fmt_frol[] = "Override latency:%9.1f ms\n";
 static const char fmt_line[] = "Line number:%10lu\n";
 static const char fmt_stat[] = "Machine state:       %s\n"; // combined machine state
 static const char fmt_macs[] = "Raw machine state:   %s\n"; // raw machine state
@@ -3181,6 +3520,10 @@ static const char fmt_g92e[] = "G92 enabled          %d\n";
 
 void cm_print_vel(nvObj_t *nv) { text_print_flt_units(nv, fmt_vel, GET_UNITS(ACTIVE_MODEL));}
 void cm_print_feed(nvObj_t *nv) { text_print_flt_units(nv, fmt_feed, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_hlat(nvObj_t *nv) { text_print(nv, fmt_hlat);}     // TYPE_FLOAT
+void cm_print_hdst(nvObj_t *nv) { text_print(nv, fmt_hdst);}     // TYPE_FLOAT
+void cm_print_hprd(nvObj_t *nv) { text_print(nv, fmt_hprd);}     // TYPE_FLOAT
+void cm_print_frol(nvObj_t *nv) { text_print(nv, fmt_frol);}     // TYPE_FLOAT
 void cm_print_line(nvObj_t *nv) { text_print(nv, fmt_line);}     // TYPE_INT
 void cm_print_tool(nvObj_t *nv) { text_print(nv, fmt_tool);}     // TYPE_INT
 void cm_print_g92e(nvObj_t *nv) { text_print(nv, fmt_g92e);}     // TYPE_INT
@@ -3216,15 +3559,19 @@ void cm_print_gdi(nvObj_t *nv) { text_print(nv, fmt_gdi);}  // TYPE_INT
 static const char fmt_jt[] = "[jt]  junction integration time%7.2f\n";
 static const char fmt_ct[] = "[ct]  chordal tolerance%17.4f%s\n";
 static const char fmt_zl[] = "[zl]  Z lift on feedhold%16.3f%s\n";
+static const char fmt_fhj[] ="[fhj] feedhold high jerk%11d [0=block jerk,1=jerk_high]\n";
 static const char fmt_sl[] = "[sl]  soft limit enable%12d [0=disable,1=enable]\n";
 static const char fmt_lim[] ="[lim] limit switch enable%10d [0=disable,1=enable]\n";
+static const char fmt_hms[] ="[hms] simultaneous homing%10d [0=axis by axis,1=Z then others together]\n";
 static const char fmt_saf[] ="[saf] safety interlock enable%6d [0=disable,1=enable]\n";
 
 void cm_print_jt(nvObj_t *nv) { text_print(nv, fmt_jt);}        // TYPE FLOAT
 void cm_print_ct(nvObj_t *nv) { text_print_flt_units(nv, fmt_ct, GET_UNITS(ACTIVE_MODEL));}
 void cm_print_zl(nvObj_t *nv) { text_print_flt_units(nv, fmt_zl, GET_UNITS(ACTIVE_MODEL));}
+void cm_print_fhj(nvObj_t *nv){ text_print(nv, fmt_fhj);}       // TYPE_INT
 void cm_print_sl(nvObj_t *nv) { text_print(nv, fmt_sl);}        // TYPE_INT
 void cm_print_lim(nvObj_t *nv){ text_print(nv, fmt_lim);}       // TYPE_INT
+void cm_print_hms(nvObj_t *nv){ text_print(nv, fmt_hms);}       // TYPE_INT
 void cm_print_saf(nvObj_t *nv){ text_print(nv, fmt_saf);}       // TYPE_INT
 
 static const char fmt_m48[]  = "[m48] overrides enabled%12d [0=disable,1=enable]\n";
@@ -3237,6 +3584,8 @@ static const char fmt_tro[]  = "[tro]  traverse override%15.3f [0.05 < mto < 1.0
 static const char fmt_plmo[] = "[plmo] 2d/3d planning mode%9d [2=2d, 3=3d]\n";
 
 static const char fmt_tram[] = "[tram] is coordinate space rotated to be tram %s\n";
+static const char fmt_mesh[] = "[mesh] is height-map compensation active %s\n";
+static const char fmt_seek[] = "[seek] seeking to line %lu\n";
 static const char fmt_nxln[] = "[nxln] next line number %lu\n";
 
 void cm_print_m48(nvObj_t *nv)  { text_print(nv, fmt_m48);}    // TYPE_INT
@@ -3246,6 +3595,8 @@ void cm_print_troe(nvObj_t *nv) { text_print(nv, fmt_troe);}    // TYPE INT
 void cm_print_tro(nvObj_t *nv)  { text_print(nv, fmt_tro);}     // TYPE FLOAT
 void cm_print_plmo(nvObj_t *nv)  { text_print(nv, fmt_plmo);}    // TYPE_INT
 void cm_print_tram(nvObj_t *nv) { text_print(nv, fmt_tram);};   // TYPE BOOL
+void cm_print_mesh(nvObj_t *nv) { text_print(nv, fmt_mesh);};   // TYPE BOOL
+void cm_print_seek(nvObj_t *nv) { text_print(nv, fmt_seek);};   // TYPE INT
 void cm_print_nxln(nvObj_t *nv) { text_print(nv, fmt_nxln);};   // TYPE INT
 
 /*
@@ -3268,6 +3619,8 @@ void cm_print_nxln(nvObj_t *nv) { text_print(nv, fmt_nxln);};   // TYPE INT
  *    cm_print_lv()
  *    cm_print_lb()
  *    cm_print_zb()
+ *    cm_print_sg()
+ *    cm_print_sgc()
  *
  *    cm_print_pos() - print position with unit displays for MM or Inches
  *    cm_print_mpo() - print position with fixed unit display - always in Degrees or MM
@@ -3288,6 +3641,8 @@ static const char fmt_Xsv[] = "[%s%s] %s search velocity%12.0f%s/min\n";
 static const char fmt_Xlv[] = "[%s%s] %s latch velocity%13.2f%s/min\n";
 static const char fmt_Xlb[] = "[%s%s] %s latch backoff%18.3f%s\n";
 static const char fmt_Xzb[] = "[%s%s] %s zero backoff%19.3f%s\n";
+static const char fmt_Xsg[] = "[%s%s] %s homing stall threshold%9d [load reading, or 0 to home to the switch]\n";
+static const char fmt_Xsgc[] = "[%s%s] %s stall calibration%14d [lowest load reading]\n";
 static const char fmt_cofs[] = "[%s%s] %s %s offset%20.3f%s\n";
 static const char fmt_cpos[] = "[%s%s] %s %s position%18.3f%s\n";
 
@@ -3368,6 +3723,8 @@ void cm_print_sv(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xsv);}
 void cm_print_lv(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xlv);}
 void cm_print_lb(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xlb);}
 void cm_print_zb(nvObj_t *nv) { _print_axis_flt(nv, fmt_Xzb);}
+void cm_print_sg(nvObj_t *nv) { _print_axis_ui8(nv, fmt_Xsg);}
+void cm_print_sgc(nvObj_t *nv) { _print_axis_ui8(nv, fmt_Xsgc);}
 
 void cm_print_cofs(nvObj_t *nv) { _print_axis_coord_flt(nv, fmt_cofs);}
 void cm_print_cpos(nvObj_t *nv) { _print_axis_coord_flt(nv, fmt_cpos);}
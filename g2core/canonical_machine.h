@@ -54,6 +54,7 @@
 #define JERK_INPUT_MIN      (0.01)          // minimum allowable jerk setting in millions mm/min^3
 #define JERK_INPUT_MAX      (1000000)       // maximum allowable jerk setting in millions mm/min^3
 #define PROBES_STORED       3               // we store three probes for coordinate rotation computation
+#define PROBE_GRID_MAX      21              // max points along each axis of a grid probe ({"gprb":...})
 #define MAX_LINENUM         2000000000      // set 2 billion as max line number
 #define BASE_STATE_SPINDLE_STOPPED 0.0f
 #define BASE_STATE_MFO_FACTOR 1.0f
@@ -117,6 +118,11 @@ typedef enum {
 //  ...
 } cmCycleType;
 
+typedef enum {                      // velocity-mode jog runtime ($jgvmd)
+    JGV_MODE_QUEUED = 0,            // stream short segments through the planner
+    JGV_MODE_DIRECT                 // bypass the planner - prep segments from the exec runtime
+} cmJgvMode;
+
 typedef enum {                      // feedhold type parameter
     FEEDHOLD_TYPE_HOLD,             // simple feedhold at max jerk with no actions
     FEEDHOLD_TYPE_ACTIONS,          // feedhold at max jerk with hold entry actions
@@ -217,6 +223,7 @@ typedef struct cmAxis {
     float latch_velocity;                   // homing latch velocity
     float latch_backoff;                    // backoff sufficient to clear a switch
     float zero_backoff;                     // backoff from switches for machine zero
+    int32_t stall_threshold;                // sensorless homing: stall at or below this load reading. 0 uses the homing input
 } cfgAxis_t;
 
 typedef struct cmArc {                      // planner and runtime variables for arc generation
@@ -250,6 +257,65 @@ typedef struct cmArc {                      // planner and runtime variables for
     magic_t magic_end;
 } cmArc_t;
 
+typedef struct cmDrill {                    // canned drilling cycle generation (G73, G81, G82, G83)
+    magic_t magic_start;
+    uint8_t run_state;                      // BLOCK_INACTIVE when no cycle is being generated
+    uint8_t step;                           // next move of the hole sequence to queue
+    cmMotionMode motion_mode;               // active drilling cycle
+
+    cmAxes plane_axis_0;                    // hole position axes - e.g. X and Y for G17
+    cmAxes plane_axis_1;
+    cmAxes drill_axis;                      // axis normal to the plane - e.g. Z for G17
+
+    float position[AXES];                   // position at the end of the last queued move
+    float hole[AXES];                       // absolute target of the current hole
+    float increment_0;                      // hole spacing for G91 L repeats
+    float increment_1;
+    uint8_t holes;                          // holes remaining including the current one
+
+    float clear_level;                      // absolute drill axis level between holes (G98/G99)
+    float r_level;                          // absolute R level
+    float bottom_level;                     // absolute bottom of the hole
+    float depth_level;                      // deepest level reached by pecking so far
+    float peck;                             // peck increment in mm (Q)
+    float dwell;                            // dwell at the bottom in seconds (P)
+
+    float R_word;                           // sticky cycle words (Gcode units) retained while the
+    float Z_word;                           // ...motion mode stays in a drilling cycle
+    float Q_word;
+    float P_word;
+    bool R_word_f;
+    bool Z_word_f;
+
+    GCodeState_t gm;                        // Gcode state struct is passed for each cycle move
+    magic_t magic_end;
+} cmDrill_t;
+
+typedef struct cmSeek {                     // seek to line (fast job restart) - see cm_seek_start()
+    bool active;                            // blocks before target_line only update the Gcode model
+    int32_t target_line;                    // line at which real execution resumes
+    int32_t line;                           // line of the current block - the last N word seen
+    float spindle_speed;                    // last S word seen while seeking
+    bool spindle_speed_set;                 // an S word was seen while seeking
+    uint8_t spindle_direction;              // last M3/M4/M5 seen while seeking (spDirection)
+    uint8_t tool_select;                    // last T word seen while seeking
+    bool tool_select_set;                   // a T word was seen while seeking
+    bool tool_change;                       // an M6 was seen while seeking
+    bool mist;                              // mist coolant state from the last M7/M9
+    bool flood;                             // flood coolant state from the last M8/M9
+} cmSeek_t;
+
+typedef struct cmHoldStats {                // feedhold stop instrumentation (see _exec_aline_feedhold())
+    uint32_t request_time;                  // SysTick ms of cm_request_feedhold(), 0 if not requested that way
+    bool synced;                            // the runtime has picked up the hold
+    bool predicted;                         // predicted_length is valid for this hold
+    float start_position[AXES];             // runtime position when the hold was picked up
+    float committed_length;                 // length of the segment already running when the hold was picked up
+    float predicted_length;                 // minimum stopping distance computed by the hold planner (mm)
+    float latency;                          // ms from the request to motion stopped
+    float stop_length;                      // distance travelled from the request to motion stopped (mm)
+} cmHoldStats_t;
+
 typedef struct cmMachine {                  // struct to manage canonical machine globals and state
     magic_t magic_start;                    // magic number to test memory integrity
 
@@ -259,8 +325,10 @@ typedef struct cmMachine {                  // struct to manage canonical machin
     float junction_integration_time;        // how aggressively will the machine corner? 1.6 or so is about the upper limit
     float chordal_tolerance;                // arc chordal accuracy setting in mm
     float feedhold_z_lift;                  // mm to move Z axis on feedhold, or 0 to disable
+    bool feedhold_high_jerk;                // true to brake feedholds at jerk_high instead of the block's jerk
     bool soft_limit_enable;                 // true to enable soft limit testing on Gcode inputs
     bool limit_enable;                      // true to enable limit switches (disabled is same as override)
+    bool homing_simultaneous;               // true to home the non-Z axes of a G28.2 together
 
     // Coordinate systems and offsets
     float coord_offset[COORDS+1][AXES];     // persistent coordinate offsets: absolute (G53) + G54,G55,G56,G57,G58,G59
@@ -288,6 +356,8 @@ typedef struct cmMachine {                  // struct to manage canonical machin
     cmFeedholdExit    hold_exit;                      // hold: final state of hold on exit
     cmFeedholdState   hold_state;                     // hold: feedhold state machine
     cmMotionProfile   hold_saved_motion_profile;      // hold: original profile saved before SCRAM override
+    bool              hold_profile_saved;             // hold: running block's profile was overridden for a fast stop
+    cmHoldStats_t     hold_stats;                     // hold: stop latency and distance of the last feedhold
 
     cmFlushState    queue_flush_state;      // queue flush state machine
     cmCycleState    cycle_start_state;      // used to manage cycle starts and restarts
@@ -310,12 +380,20 @@ typedef struct cmMachine {                  // struct to manage canonical machin
 
     float rotation_matrix[3][3];            // three-by-three rotation matrix. We ignore UVW and ABC axes
     float rotation_z_offset;                // separately handle a z-offset to maintain consistent distance to bed
+    bool rotation_active;                   // rotation matrix or z-offset is not identity - skip the transform if false
+
+    float combined_offset[AXES];            // cached coord + tool + G92 offsets. See cm_get_combined_offset()
+    cmCoordSystem combined_offset_coord;    // coordinate system the cached offsets were computed for
+    bool combined_offset_g92;               // G92 enable the cached offsets were computed for
+    bool combined_offset_valid;             // false forces the cached offsets to be recomputed
 
     float jogging_dest;                     // jogging destination as a relative move from current position
 
   /**** Model state structures ****/
     void *mp;                               // linked mpPlanner_t - use a void pointer to avoid circular header files
     cmArc_t arc;                            // arc parameters
+    cmDrill_t drill;                        // canned drilling cycle parameters
+    cmSeek_t seek;                          // seek to line (fast job restart)
     GCodeState_t *am;                       // active Gcode model is maintained by state management
 
     GCodeState_t  gm;                       // core gcode model state
@@ -376,6 +454,7 @@ stat_t cm_check_linenum();
 
 // Coordinate systems and offsets
 float cm_get_combined_offset(const uint8_t axis);
+void cm_invalidate_combined_offsets(void);
 float cm_get_display_offset(const GCodeState_t *gcode_state, const uint8_t axis);
 void cm_set_display_offsets(GCodeState_t *gcode_state);
 float cm_get_display_position(const GCodeState_t *gcode_state, const uint8_t axis);
@@ -407,6 +486,7 @@ stat_t cm_select_plane(const uint8_t plane);                                // G
 stat_t cm_set_units_mode(const uint8_t mode);                               // G20, G21
 stat_t cm_set_distance_mode(const uint8_t mode);                            // G90, G91
 stat_t cm_set_arc_distance_mode(const uint8_t mode);                        // G90.1, G91.1
+stat_t cm_set_retract_mode(const uint8_t mode);                             // G98, G99
 stat_t cm_set_tl_offset(const uint8_t H_word, const bool H_flag,            // G43, G43.2
                         const bool apply_additional);
 stat_t cm_cancel_tl_offset(void);                                           // G49
@@ -491,6 +571,12 @@ stat_t cm_json_command(char *json_string);                      // M100
 stat_t cm_json_command_immediate(char *json_string);            // M100.1
 stat_t cm_json_wait(char *json_string);                         // M102
 
+// Seek to line (fast job restart)
+stat_t cm_seek_start(const int32_t line);                       // run blocks before line model-only
+stat_t cm_seek_move_global(const float *target, const bool *flags, const cmMotionMode motion_mode); // model-only G0-G3
+stat_t cm_seek_goto_position(const float position[]);           // model-only G28, G30
+stat_t cm_seek_finish(void);                                    // approach the restart point and resume
+
 /**** Cycles and External FIles ****/
 
 // Feedhold and related functions (cycle_feedhold.cpp)
@@ -512,6 +598,9 @@ stat_t cm_homing_cycle_start(const float axes[], const bool flags[]);        //
 stat_t cm_homing_cycle_start_no_set(const float axes[], const bool flags[]); // G28.4
 stat_t cm_homing_cycle_callback(void);                          // G28.2/.4 main loop callback
 void cm_abort_homing(cmMachine_t *_cm); // called from the queue flush sequence to clean up
+stat_t cm_homing_stall_calibration_start(const uint8_t axis);    // record free-running load for an axis
+stat_t cm_homing_stall_calibration_end(const uint8_t axis);      // ...and set its stall threshold from it
+int32_t cm_homing_stall_calibration_value(const uint8_t axis);   // lowest load reading recorded so far
 
 // Probe cycles
 stat_t cm_straight_probe_global(float target[], bool flags[],   // G38.x, global (Gcode) units - for external use
@@ -521,6 +610,46 @@ void cm_abort_probing(cmMachine_t *_cm); // called from the queue flush sequence
 
 stat_t cm_get_prbr(nvObj_t *nv);                                // enable/disable probe report
 stat_t cm_set_prbr(nvObj_t *nv);
+stat_t cm_probe_grid_start(void);                               // grid probing cycle - see cycle_probing.cpp
+stat_t cm_get_gprbx0(nvObj_t *nv);                              // grid probe parameters - {"gprb":{...}}
+stat_t cm_set_gprbx0(nvObj_t *nv);
+stat_t cm_get_gprby0(nvObj_t *nv);
+stat_t cm_set_gprby0(nvObj_t *nv);
+stat_t cm_get_gprbx1(nvObj_t *nv);
+stat_t cm_set_gprbx1(nvObj_t *nv);
+stat_t cm_get_gprby1(nvObj_t *nv);
+stat_t cm_set_gprby1(nvObj_t *nv);
+stat_t cm_get_gprbnx(nvObj_t *nv);
+stat_t cm_set_gprbnx(nvObj_t *nv);
+stat_t cm_get_gprbny(nvObj_t *nv);
+stat_t cm_set_gprbny(nvObj_t *nv);
+stat_t cm_get_gprbz(nvObj_t *nv);
+stat_t cm_set_gprbz(nvObj_t *nv);
+stat_t cm_get_gprbc(nvObj_t *nv);
+stat_t cm_set_gprbc(nvObj_t *nv);
+stat_t cm_get_gprbf(nvObj_t *nv);
+stat_t cm_set_gprbf(nvObj_t *nv);
+stat_t cm_get_gprbe(nvObj_t *nv);                               // 1 if the last grid completed
+stat_t cm_get_gprbgo(nvObj_t *nv);                              // grid cycle running
+stat_t cm_set_gprbgo(nvObj_t *nv);                              // start the grid cycle
+const float *cm_get_probe_grid(uint8_t *nx, uint8_t *ny, float origin[], float step[]); // last completed grid
+
+// Canned drilling cycles (cycle_drilling.cpp)
+void cm_drill_cycle_init(cmMachine_t *_cm);
+stat_t cm_drill_cycle_global(const float target[], const bool target_f[],   // G73, G81, G82, G83
+                             const float R_word, const bool R_word_f,       // retract level
+                             const float Q_word, const bool Q_word_f,       // peck increment
+                             const float P_word, const bool P_word_f,       // dwell seconds
+                             const uint8_t L_word, const bool L_word_f,     // repeats
+                             const cmMotionMode motion_mode);
+stat_t cm_drill_cycle_seek(const float target[], const bool target_f[],     // model-only, while seeking
+                           const float R_word, const bool R_word_f,
+                           const float Q_word, const bool Q_word_f,
+                           const float P_word, const bool P_word_f,
+                           const uint8_t L_word, const bool L_word_f,
+                           const cmMotionMode motion_mode);
+stat_t cm_drill_cycle_callback(cmMachine_t *_cm);               // main loop callback that queues the cycle moves
+void cm_abort_drill_cycle(cmMachine_t *_cm);                    // called from the queue flush sequence to clean up
 
 // Jogging cycle (cycle_jogging.cpp)
 stat_t cm_jogging_cycle_callback(void);                         // jogging cycle main loop
@@ -533,6 +662,12 @@ stat_t cm_set_jgv(nvObj_t *nv);                                  // JSON setter
 stat_t cm_get_jgvto(nvObj_t *nv);                                // watchdog timeout getter
 stat_t cm_set_jgvto(nvObj_t *nv);                                // watchdog timeout setter
 void cm_jgv_abort(void);                                       // external abort (called from feedhold/alarm paths)
+bool cm_jgv_exec(void);                                         // direct runtime: prep a segment if the planner is empty
+bool cm_jgv_direct_active(void);                                // a direct-runtime cycle owns the runtime
+stat_t cm_get_jgvmd(nvObj_t *nv);                                // runtime mode getter
+stat_t cm_set_jgvmd(nvObj_t *nv);                                // runtime mode setter
+stat_t cm_get_jgvlt(nvObj_t *nv);                                // last input-to-motion latency (ms)
+stat_t cm_get_jgvlx(nvObj_t *nv);                                // worst input-to-motion latency this cycle (ms)
 
 // Alarm management (alarm.cpp)
 stat_t cm_alrm(nvObj_t *nv);                                    // trigger alarm from command input
@@ -561,6 +696,7 @@ const configSubtable *const getPosConfig_1();
 const configSubtable *const getOfsConfig_1();
 const configSubtable * const getHomConfig_1();
 const configSubtable * const getPrbConfig_1();
+const configSubtable * const getGprbConfig_1();
 const configSubtable * const getJogConfig_1();
 const configSubtable * const getJgvConfig_1();
 const configSubtable *const getAxisConfig_1();
@@ -596,6 +732,10 @@ stat_t cm_get_pwr(nvObj_t *nv);         // get motor power enable state
 
 stat_t cm_get_vel(nvObj_t *nv);         // get runtime velocity
 stat_t cm_get_feed(nvObj_t *nv);        // get feed rate, converted to units
+stat_t cm_get_hlat(nvObj_t *nv);        // get latency of the last feedhold stop
+stat_t cm_get_hdst(nvObj_t *nv);        // get stopping distance of the last feedhold
+stat_t cm_get_hprd(nvObj_t *nv);        // get predicted stopping distance of the last feedhold
+stat_t cm_get_frol(nvObj_t *nv);        // get latency of the last feed override change
 stat_t cm_get_pos(nvObj_t *nv);         // get runtime work position
 stat_t cm_get_mpo(nvObj_t *nv);         // get runtime machine position
 stat_t cm_get_ofs(nvObj_t *nv);         // get runtime work offset
@@ -651,6 +791,10 @@ void cm_set_axis_high_jerk(const uint8_t axis, const float jerk);
 // stat_t cm_set_lb(nvObj_t *nv);          // set homing latch backoff
 // stat_t cm_get_zb(nvObj_t *nv);          // get homing zero backoff
 // stat_t cm_set_zb(nvObj_t *nv);          // set homing zero backoff
+// stat_t cm_get_sg(nvObj_t *nv);          // get sensorless homing stall threshold
+// stat_t cm_set_sg(nvObj_t *nv);          // set sensorless homing stall threshold
+// stat_t cm_get_sgc(nvObj_t *nv);         // get stall calibration reading
+// stat_t cm_set_sgc(nvObj_t *nv);         // start (1) or finish (0) stall calibration
 
 stat_t cm_get_jt(nvObj_t *nv);          // get junction integration time constant
 stat_t cm_set_jt(nvObj_t *nv);          // set junction integration time constant
@@ -658,10 +802,14 @@ stat_t cm_get_ct(nvObj_t *nv);          // get chordal tolerance
 stat_t cm_set_ct(nvObj_t *nv);          // set chordal tolerance
 stat_t cm_get_zl(nvObj_t *nv);          // get feedhold Z lift
 stat_t cm_set_zl(nvObj_t *nv);          // set feedhold Z lift
+stat_t cm_get_fhj(nvObj_t *nv);         // get feedhold high jerk enable
+stat_t cm_set_fhj(nvObj_t *nv);         // set feedhold high jerk enable
 stat_t cm_get_sl(nvObj_t *nv);          // get soft limit enable
 stat_t cm_set_sl(nvObj_t *nv);          // set soft limit enable
 stat_t cm_get_lim(nvObj_t *nv);         // get hard limit enable
 stat_t cm_set_lim(nvObj_t *nv);         // set hard limit enable
+stat_t cm_get_hms(nvObj_t *nv);         // get simultaneous homing enable
+stat_t cm_set_hms(nvObj_t *nv);         // set simultaneous homing enable
 
 stat_t cm_get_m48(nvObj_t *nv);         // get M48 value (enable/disable overrides)
 stat_t cm_set_m48(nvObj_t *nv);         // set M48 value (enable/disable overrides)
@@ -684,6 +832,11 @@ stat_t cm_set_probe(nvObj_t *nv);       // store current position as the latest
 
 stat_t cm_set_tram(nvObj_t *nv);        // attempt setting the rotation matrix
 stat_t cm_get_tram(nvObj_t *nv);        // return if the rotation matrix is non-identity
+stat_t cm_set_mesh(nvObj_t *nv);        // load the last grid probe as the height map, or clear it
+stat_t cm_get_mesh(nvObj_t *nv);        // return if height-map compensation is active
+
+stat_t cm_set_seek(nvObj_t *nv);        // start seeking to line N, or cancel with 0
+stat_t cm_get_seek(nvObj_t *nv);        // return the line being sought, 0 if not seeking
 
 stat_t cm_set_nxln(nvObj_t *nv);    // set what value we expect the next line number to have
 stat_t cm_get_nxln(nvObj_t *nv);    // return what value we expect the next line number to have
@@ -705,6 +858,10 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
 
     void cm_print_vel(nvObj_t *nv);       // model state reporting
     void cm_print_feed(nvObj_t *nv);
+    void cm_print_hlat(nvObj_t *nv);
+    void cm_print_hdst(nvObj_t *nv);
+    void cm_print_hprd(nvObj_t *nv);
+    void cm_print_frol(nvObj_t *nv);
     void cm_print_line(nvObj_t *nv);
     void cm_print_stat(nvObj_t *nv);
     void cm_print_macs(nvObj_t *nv);
@@ -739,8 +896,10 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     void cm_print_jt(nvObj_t *nv);          // global CM settings
     void cm_print_ct(nvObj_t *nv);
     void cm_print_zl(nvObj_t *nv);
+    void cm_print_fhj(nvObj_t *nv);
     void cm_print_sl(nvObj_t *nv);
     void cm_print_lim(nvObj_t *nv);
+    void cm_print_hms(nvObj_t *nv);
     void cm_print_saf(nvObj_t *nv);
 
     void cm_print_m48(nvObj_t *nv);
@@ -753,6 +912,8 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     void cm_print_plmo(nvObj_t *nv);
 
     void cm_print_tram(nvObj_t *nv);        // print if the axis has been rotated
+    void cm_print_mesh(nvObj_t *nv);        // print if height-map compensation is active
+    void cm_print_seek(nvObj_t *nv);        // print the line being sought
     void cm_print_nxln(nvObj_t *nv);    // print the value of the next line number expected
 
     void cm_print_am(nvObj_t *nv);          // axis print functions
@@ -770,6 +931,8 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     void cm_print_lv(nvObj_t *nv);
     void cm_print_lb(nvObj_t *nv);
     void cm_print_zb(nvObj_t *nv);
+    void cm_print_sg(nvObj_t *nv);
+    void cm_print_sgc(nvObj_t *nv);
     void cm_print_cofs(nvObj_t *nv);
     void cm_print_cpos(nvObj_t *nv);
 
@@ -777,6 +940,10 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
 
     #define cm_print_vel tx_print_stub      // model state reporting
     #define cm_print_feed tx_print_stub
+    #define cm_print_hlat tx_print_stub
+    #define cm_print_hdst tx_print_stub
+    #define cm_print_hprd tx_print_stub
+    #define cm_print_frol tx_print_stub
     #define cm_print_line tx_print_stub
     #define cm_print_stat tx_print_stub
     #define cm_print_macs tx_print_stub
@@ -810,8 +977,10 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     #define cm_print_jt tx_print_stub       // global CM settings
     #define cm_print_ct tx_print_stub
     #define cm_print_zl tx_print_stub
+    #define cm_print_fhj tx_print_stub
     #define cm_print_sl tx_print_stub
     #define cm_print_lim tx_print_stub
+    #define cm_print_hms tx_print_stub
     #define cm_print_saf tx_print_stub
 
     #define cm_print_m48 tx_print_stub
@@ -826,6 +995,8 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     #define cm_print_tram tx_print_stub
 
     #define cm_print_tram tx_print_stub
+    #define cm_print_mesh tx_print_stub
+    #define cm_print_seek tx_print_stub
     #define cm_print_nxln tx_print_stub
 
     #define cm_print_am tx_print_stub    // axis print functions
@@ -843,6 +1014,8 @@ stat_t cm_set_gdi(nvObj_t *nv);         // set gcode default distance mode
     #define cm_print_lv tx_print_stub
     #define cm_print_lb tx_print_stub
     #define cm_print_zb tx_print_stub
+    #define cm_print_sg tx_print_stub
+    #define cm_print_sgc tx_print_stub
     #define cm_print_cofs tx_print_stub
     #define cm_print_cpos tx_print_stub
 
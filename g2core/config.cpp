@@ -104,13 +104,24 @@ stat_t nv_persist(nvObj_t *nv)
  *  (1) if persistence is set up or out-of-rev load RAM and NVM with settings.h defaults
  *  (2) if persistence is set up and at current config version use NVM data for config
  *
+ *  The time spent opening the NVM and loading/applying values is kept for the
+ *  boot report ($btnv, $btld, $btn).
+ *
  *  You can assume the cfg struct has been zeroed by a hard reset.
  *  Do not clear it as the version and build numbers have already been set by tg_init()
  *
  * NOTE: Config assertions are handled from the controller
  */
+static void _restore_value(nvObj_t *nv)
+{
+    strncpy(nv->token, cfgArray[nv->index].token, TOKEN_LEN); // read the token from the array
+    cfgArray[nv->index].set(nv);                // bulk read keeps index in range, skip nv_set()
+    cfg.boot_values++;
+}
+
 void config_init()
 {
+    uint32_t start = Motate::SysTickTimer.getValue();
     nvObj_t *nv = nv_reset_nv_list();
     config_init_assertions();
     js.json_mode = JSON_MODE;                    // initial value until persistence is read
@@ -118,19 +129,18 @@ void config_init()
     cm_set_units_mode(MILLIMETERS);             // must do inits in millimeter mode
     nv->index = 0;                              // this will read the first record in NVM
 
-    read_persistent_value(nv);
+    read_persistent_value(nv);                  // also opens and validates the NVM
+    uint32_t opened = Motate::SysTickTimer.getValue();
+    cfg.boot_values = 0;
     if (fp_NE(nv->value_flt, G2CORE_FIRMWARE_BUILD)) {   // case (1) NVM is not setup or not in revision
         _set_defa(nv, false);
     } else {
-        for (nv->index=0; nv_index_is_single(nv->index); nv->index++) {
-            if (GET_TABLE_BYTE(flags) & F_INITIALIZE) {
-                strncpy(nv->token, cfgArray[nv->index].token, TOKEN_LEN); // read the token from the array
-                read_persistent_value(nv);
-                nv_set(nv);
-            }
-        }
+        read_persistent_values(nv, _restore_value); // one pass over the whole NVM image
         sr_init_status_report();                    // reset status reports
     }
+    uint32_t done = Motate::SysTickTimer.getValue();
+    cfg.boot_nvm_ms = opened - start;
+    cfg.boot_load_ms = done - opened;
     rpt_print_loading_configs_message();
 }
 
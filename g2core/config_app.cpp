@@ -49,6 +49,7 @@
 #include "xio.h"
 #include "kinematics.h"
 #include "safety_manager.h"
+#include "raster.h"
 
 /*** structures ***/
 
@@ -271,6 +272,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "1","1ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M1_ENABLE_POLARITY },
     { "1","1sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M1_STEP_POLARITY },
     { "1","1pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M1_POWER_LEVEL_IDLE },
+    { "1","1cp", _fip,  3, st_print_cp, st_get_cp, st_set_cp, nullptr, M1_CORRECTION_KP },
+    { "1","1ci", _fip,  3, st_print_ci, st_get_ci, st_set_ci, nullptr, M1_CORRECTION_KI },
 //  { "1","1mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M1_MOTOR_TIMEOUT },
     { "1","1scn", _iip,  0, st_print_scn, st_get_scn, st_set_sc, nullptr, 0 },
     { "1","1scu", _iip,  0, st_print_scu, st_get_scu, st_set_sc, nullptr, 0 },
@@ -284,6 +287,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "1","1sgr", _i0,  0, tx_print_nul, motor_1.get_sgr_fn, set_ro,              &motor_1, 0 },
     { "1","1csa", _i0,  0, tx_print_nul, motor_1.get_csa_fn, set_ro,              &motor_1, 0 },
     { "1","1sgs", _i0,  0, tx_print_nul, motor_1.get_sgs_fn, set_ro,              &motor_1, 0 },
+    { "1","1ot",  _i0,  0, tx_print_nul, motor_1.get_ot_fn,  set_ro,              &motor_1, 0 },
+    { "1","1ol",  _i0,  0, tx_print_nul, motor_1.get_ol_fn,  set_ro,              &motor_1, 0 },
     { "1","1tbl", _iip, 0, tx_print_nul, motor_1.get_tbl_fn, motor_1.set_tbl_fn,  &motor_1, M1_TMC2130_TBL },
     { "1","1pgrd",_iip, 0, tx_print_nul, motor_1.get_pgrd_fn,motor_1.set_pgrd_fn, &motor_1, M1_TMC2130_PWM_GRAD },
     { "1","1pamp",_iip, 0, tx_print_nul, motor_1.get_pamp_fn,motor_1.set_pamp_fn, &motor_1, M1_TMC2130_PWM_AMPL },
@@ -308,6 +313,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "2","2ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M2_ENABLE_POLARITY },
     { "2","2sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M2_STEP_POLARITY },
     { "2","2pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M2_POWER_LEVEL_IDLE },
+    { "2","2cp", _fip,  3, st_print_cp, st_get_cp, st_set_cp, nullptr, M2_CORRECTION_KP },
+    { "2","2ci", _fip,  3, st_print_ci, st_get_ci, st_set_ci, nullptr, M2_CORRECTION_KI },
 //  { "2","2mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M2_MOTOR_TIMEOUT },
     { "2","2scn", _iip,  0, st_print_scn, st_get_scn, st_set_sc, nullptr, 0 },
     { "2","2scu", _iip,  0, st_print_scu, st_get_scu, st_set_sc, nullptr, 0 },
@@ -321,6 +328,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "2","2sgr", _i0,  0, tx_print_nul, motor_2.get_sgr_fn, set_ro,              &motor_2, 0 },
     { "2","2csa", _i0,  0, tx_print_nul, motor_2.get_csa_fn, set_ro,              &motor_2, 0 },
     { "2","2sgs", _i0,  0, tx_print_nul, motor_2.get_sgs_fn, set_ro,              &motor_2, 0 },
+    { "2","2ot",  _i0,  0, tx_print_nul, motor_2.get_ot_fn,  set_ro,              &motor_2, 0 },
+    { "2","2ol",  _i0,  0, tx_print_nul, motor_2.get_ol_fn,  set_ro,              &motor_2, 0 },
     { "2","2tbl", _iip, 0, tx_print_nul, motor_2.get_tbl_fn, motor_2.set_tbl_fn,  &motor_2, M2_TMC2130_TBL },
     { "2","2pgrd",_iip, 0, tx_print_nul, motor_2.get_pgrd_fn,motor_2.set_pgrd_fn, &motor_2, M2_TMC2130_PWM_GRAD },
     { "2","2pamp",_iip, 0, tx_print_nul, motor_2.get_pamp_fn,motor_2.set_pamp_fn, &motor_2, M2_TMC2130_PWM_AMPL },
@@ -345,6 +354,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "3","3ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M3_ENABLE_POLARITY },
     { "3","3sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M3_STEP_POLARITY },
     { "3","3pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M3_POWER_LEVEL_IDLE },
+    { "3","3cp", _fip,  3, st_print_cp, st_get_cp, st_set_cp, nullptr, M3_CORRECTION_KP },
+    { "3","3ci", _fip,  3, st_print_ci, st_get_ci, st_set_ci, nullptr, M3_CORRECTION_KI },
 //  { "3","3mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M3_MOTOR_TIMEOUT },
     { "3","3scn", _iip,  0, st_print_scn, st_get_scn, st_set_sc, nullptr, 0 },
     { "3","3scu", _iip,  0, st_print_scu, st_get_scu, st_set_sc, nullptr, 0 },
@@ -358,6 +369,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "3","3sgr", _i0,  0, tx_print_nul, motor_3.get_sgr_fn, set_ro,              &motor_3, 0 },
     { "3","3csa", _i0,  0, tx_print_nul, motor_3.get_csa_fn, set_ro,              &motor_3, 0 },
     { "3","3sgs", _i0,  0, tx_print_nul, motor_3.get_sgs_fn, set_ro,              &motor_3, 0 },
+    { "3","3ot",  _i0,  0, tx_print_nul, motor_3.get_ot_fn,  set_ro,              &motor_3, 0 },
+    { "3","3ol",  _i0,  0, tx_print_nul, motor_3.get_ol_fn,  set_ro,              &motor_3, 0 },
     { "3","3tbl", _iip, 0, tx_print_nul, motor_3.get_tbl_fn, motor_3.set_tbl_fn,  &motor_3, M3_TMC2130_TBL },
     { "3","3pgrd",_iip, 0, tx_print_nul, motor_3.get_pgrd_fn,motor_3.set_pgrd_fn, &motor_3, M3_TMC2130_PWM_GRAD },
     { "3","3pamp",_iip, 0, tx_print_nul, motor_3.get_pamp_fn,motor_3.set_pamp_fn, &motor_3, M3_TMC2130_PWM_AMPL },
@@ -382,6 +395,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "4","4ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M4_ENABLE_POLARITY },
     { "4","4sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M4_STEP_POLARITY },
     { "4","4pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M4_POWER_LEVEL_IDLE },
+    { "4","4cp", _fip,  3, st_print_cp, st_get_cp, st_set_cp, nullptr, M4_CORRECTION_KP },
+    { "4","4ci", _fip,  3, st_print_ci, st_get_ci, st_set_ci, nullptr, M4_CORRECTION_KI },
 //  { "4","4mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M4_MOTOR_TIMEOUT },
     { "4","4scn", _iip,  0, st_print_scn, st_get_scn, st_set_sc, nullptr, 0 },
     { "4","4scu", _iip,  0, st_print_scu, st_get_scu, st_set_sc, nullptr, 0 },
@@ -395,6 +410,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "4","4sgr", _i0,  0, tx_print_nul, motor_4.get_sgr_fn, set_ro,              &motor_4, 0 },
     { "4","4csa", _i0,  0, tx_print_nul, motor_4.get_csa_fn, set_ro,              &motor_4, 0 },
     { "4","4sgs", _i0,  0, tx_print_nul, motor_4.get_sgs_fn, set_ro,              &motor_4, 0 },
+    { "4","4ot",  _i0,  0, tx_print_nul, motor_4.get_ot_fn,  set_ro,              &motor_4, 0 },
+    { "4","4ol",  _i0,  0, tx_print_nul, motor_4.get_ol_fn,  set_ro,              &motor_4, 0 },
     { "4","4tbl", _iip, 0, tx_print_nul, motor_4.get_tbl_fn, motor_4.set_tbl_fn,  &motor_4, M4_TMC2130_TBL },
     { "4","4pgrd",_iip, 0, tx_print_nul, motor_4.get_pgrd_fn,motor_4.set_pgrd_fn, &motor_4, M4_TMC2130_PWM_GRAD },
     { "4","4pamp",_iip, 0, tx_print_nul, motor_4.get_pamp_fn,motor_4.set_pamp_fn, &motor_4, M4_TMC2130_PWM_AMPL },
@@ -419,6 +436,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "5","5ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M5_ENABLE_POLARITY },
     { "5","5sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M5_STEP_POLARITY },
     { "5","5pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M5_POWER_LEVEL_IDLE },
+    { "5","5cp", _fip,  3, st_print_cp, st_get_cp, st_set_cp, nullptr, M5_CORRECTION_KP },
+    { "5","5ci", _fip,  3, st_print_ci, st_get_ci, st_set_ci, nullptr, M5_CORRECTION_KI },
 //  { "5","5mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M5_MOTOR_TIMEOUT },
     { "5","5scn", _iip,  0, st_print_scn, st_get_scn, st_set_sc, nullptr, 0 },
     { "5","5scu", _iip,  0, st_print_scu, st_get_scu, st_set_sc, nullptr, 0 },
@@ -432,6 +451,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "5","5sgr", _i0,  0, tx_print_nul, motor_5.get_sgr_fn, set_ro,              &motor_5, 0 },
     { "5","5csa", _i0,  0, tx_print_nul, motor_5.get_csa_fn, set_ro,              &motor_5, 0 },
     { "5","5sgs", _i0,  0, tx_print_nul, motor_5.get_sgs_fn, set_ro,              &motor_5, 0 },
+    { "5","5ot",  _i0,  0, tx_print_nul, motor_5.get_ot_fn,  set_ro,              &motor_5, 0 },
+    { "5","5ol",  _i0,  0, tx_print_nul, motor_5.get_ol_fn,  set_ro,              &motor_5, 0 },
     { "5","5tbl", _iip, 0, tx_print_nul, motor_5.get_tbl_fn, motor_5.set_tbl_fn,  &motor_5, M5_TMC2130_TBL },
     { "5","5pgrd",_iip, 0, tx_print_nul, motor_5.get_pgrd_fn,motor_5.set_pgrd_fn, &motor_5, M5_TMC2130_PWM_GRAD },
     { "5","5pamp",_iip, 0, tx_print_nul, motor_5.get_pamp_fn,motor_5.set_pamp_fn, &motor_5, M5_TMC2130_PWM_AMPL },
@@ -456,6 +477,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "6","6ep", _iip,  0, st_print_ep, st_get_ep, st_set_ep, nullptr, M6_ENABLE_POLARITY },
     { "6","6sp", _iip,  0, st_print_sp, st_get_sp, st_set_sp, nullptr, M6_STEP_POLARITY },
     { "6","6pi", _fip,  3, st_print_pi, st_get_pi, st_set_pi, nullptr, M6_POWER_LEVEL_IDLE },
+    { "6","6cp", _fip,  3, st_print_cp, st_get_cp, st_set_cp, nullptr, M6_CORRECTION_KP },
+    { "6","6ci", _fip,  3, st_print_ci, st_get_ci, st_set_ci, nullptr, M6_CORRECTION_KI },
 //  { "6","6mt", _fip,  2, st_print_mt, st_get_mt, st_set_mt, nullptr, M6_MOTOR_TIMEOUT },
     { "6","6scn", _iip,  0, st_print_scn, st_get_scn, st_set_sc, nullptr, 0 },
     { "6","6scu", _iip,  0, st_print_scu, st_get_scu, st_set_sc, nullptr, 0 },
@@ -469,6 +492,8 @@ constexpr cfgItem_t motor_config_items_1[] = {
     { "6","6sgr", _i0,  0, tx_print_nul, motor_6.get_sgr_fn, set_ro,              &motor_6, 0 },
     { "6","6csa", _i0,  0, tx_print_nul, motor_6.get_csa_fn, set_ro,              &motor_6, 0 },
     { "6","6sgs", _i0,  0, tx_print_nul, motor_6.get_sgs_fn, set_ro,              &motor_6, 0 },
+    { "6","6ot",  _i0,  0, tx_print_nul, motor_6.get_ot_fn,  set_ro,              &motor_6, 0 },
+    { "6","6ol",  _i0,  0, tx_print_nul, motor_6.get_ol_fn,  set_ro,              &motor_6, 0 },
     { "6","6tbl", _iip, 0, tx_print_nul, motor_6.get_tbl_fn, motor_6.set_tbl_fn,  &motor_6, M6_TMC2130_TBL },
     { "6","6pgrd",_iip, 0, tx_print_nul, motor_6.get_pgrd_fn,motor_6.set_pgrd_fn, &motor_6, M6_TMC2130_PWM_GRAD },
     { "6","6pamp",_iip, 0, tx_print_nul, motor_6.get_pamp_fn,motor_6.set_pamp_fn, &motor_6, M6_TMC2130_PWM_AMPL },
@@ -845,6 +870,8 @@ constexpr cfgItem_t he_config_items_1[] = {
     { "he1","he1i", _fip, 5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        nullptr, H1_DEFAULT_I },
     { "he1","he1d", _fip, 5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        nullptr, H1_DEFAULT_D },
     { "he1","he1f", _fi,  5, tx_print_nul, cm_get_heater_f,        cm_set_heater_f,        nullptr, H1_DEFAULT_F },
+    { "he1","he1tu",_f0,  1, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, nullptr, 0 },   // relay autotune at temp
+    { "he1","he1tp",_b0,  0, tx_print_nul, cm_get_heater_autotune_persist, cm_set_heater_autotune_persist, nullptr, 0 },
     { "he1","he1st",_fi,  1, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, nullptr, 0 },
     { "he1","he1t", _fi,  1, tx_print_nul, cm_get_temperature,     set_ro,                 nullptr, 0 },
     { "he1","he1op",_fi,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 nullptr, 0 },
@@ -862,6 +889,8 @@ constexpr cfgItem_t he_config_items_1[] = {
     { "he2","he2i", _fip, 5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        nullptr, H2_DEFAULT_I },
     { "he2","he2d", _fip, 5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        nullptr, H2_DEFAULT_D },
     { "he2","he2f", _fi,  5, tx_print_nul, cm_get_heater_f,        cm_set_heater_f,        nullptr, H2_DEFAULT_F },
+    { "he2","he2tu",_f0,  1, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, nullptr, 0 },   // relay autotune at temp
+    { "he2","he2tp",_b0,  0, tx_print_nul, cm_get_heater_autotune_persist, cm_set_heater_autotune_persist, nullptr, 0 },
     { "he2","he2st",_fi,  0, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, nullptr, 0 },
     { "he2","he2t", _fi,  1, tx_print_nul, cm_get_temperature,     set_ro,                 nullptr, 0 },
     { "he2","he2op",_fi,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 nullptr, 0 },
@@ -879,6 +908,8 @@ constexpr cfgItem_t he_config_items_1[] = {
     { "he3","he3i", _fip, 5, tx_print_nul, cm_get_heater_i,        cm_set_heater_i,        nullptr, H3_DEFAULT_I },
     { "he3","he3d", _fip, 5, tx_print_nul, cm_get_heater_d,        cm_set_heater_d,        nullptr, H3_DEFAULT_D },
     { "he3","he3f", _fi,  5, tx_print_nul, cm_get_heater_f,        cm_set_heater_f,        nullptr, H3_DEFAULT_F },
+    { "he3","he3tu",_f0,  1, tx_print_nul, cm_get_heater_autotune, cm_set_heater_autotune, nullptr, 0 },   // relay autotune at temp
+    { "he3","he3tp",_b0,  0, tx_print_nul, cm_get_heater_autotune_persist, cm_set_heater_autotune_persist, nullptr, 0 },
     { "he3","he3st",_fi,  0, tx_print_nul, cm_get_set_temperature, cm_set_set_temperature, nullptr, 0 },
     { "he3","he3t", _fi,  1, tx_print_nul, cm_get_temperature,     set_ro,                 nullptr, 0 },
     { "he3","he3op",_fi,  3, tx_print_nul, cm_get_heater_output,   set_ro,                 nullptr, 0 },
@@ -1050,10 +1081,15 @@ constexpr cfgItem_t sys_config_items_2[] = {
     { "sys","jt",  _fipn, 2, cm_print_jt,  cm_get_jt,  cm_set_jt,  nullptr, JUNCTION_INTEGRATION_TIME },
     { "sys","ct",  _fipnc,4, cm_print_ct,  cm_get_ct,  cm_set_ct,  nullptr, CHORDAL_TOLERANCE },
     { "sys","zl",  _fipnc,3, cm_print_zl,  cm_get_zl,  cm_set_zl,  nullptr, FEEDHOLD_Z_LIFT },
+    { "sys","fhj", _bipn, 0, cm_print_fhj, cm_get_fhj, cm_set_fhj, nullptr, FEEDHOLD_HIGH_JERK },
     { "sys","sl",  _bipn, 0, cm_print_sl,  cm_get_sl,  cm_set_sl,  nullptr, SOFT_LIMIT_ENABLE },
     { "sys","lim", _bipn, 0, cm_print_lim, cm_get_lim, cm_set_lim, nullptr, HARD_LIMIT_ENABLE },
+    { "sys","hms", _bipn, 0, cm_print_hms, cm_get_hms, cm_set_hms, nullptr, HOMING_SIMULTANEOUS },
     { "sys","saf", _bipn, 0, cm_print_saf, cm_get_saf, cm_set_saf, nullptr, SAFETY_INTERLOCK_ENABLE },
     { "sys","jgvto", _iipn, 0, tx_print_int, cm_get_jgvto, cm_set_jgvto, nullptr, 500 },  // velocity-jog watchdog timeout (ms)
+    { "sys","jgvmd", _iipn, 0, tx_print_int, cm_get_jgvmd, cm_set_jgvmd, nullptr, JGV_MODE_DIRECT },  // velocity-jog runtime: 0=queued, 1=direct
+    { "sys","jgvlt", _fn,   1, tx_print_flt, cm_get_jgvlt, set_ro,       nullptr, 0 },    // velocity-jog last input-to-motion latency (ms)
+    { "sys","jgvlx", _fn,   1, tx_print_flt, cm_get_jgvlx, set_ro,       nullptr, 0 },    // velocity-jog worst latency this cycle (ms)
     { "sys","m48", _bin, 0, cm_print_m48,  cm_get_m48, cm_get_m48, nullptr, 1 },   // M48/M49 feedrate & spindle override enable
     { "sys","froe",_bin, 0, cm_print_froe, cm_get_froe,cm_get_froe,nullptr, FEED_OVERRIDE_ENABLE},
     { "sys","fro", _fin, 3, cm_print_fro,  cm_get_fro, cm_set_fro, nullptr, FEED_OVERRIDE_FACTOR},
@@ -1110,8 +1146,12 @@ constexpr cfgItem_t sys_config_items_2[] = {
     { "sys","ej", _iipn, 0, js_print_ej,  js_get_ej, js_set_ej, nullptr, COMM_MODE },
     { "sys","jv", _iipn, 0, js_print_jv,  js_get_jv, js_set_jv, nullptr, JSON_VERBOSITY },
     { "sys","qv", _iipn, 0, qr_print_qv,  qr_get_qv, qr_set_qv, nullptr, QUEUE_REPORT_VERBOSITY },
+    { "sys","qrl",_iipn, 0, qr_print_qrl, qr_get_qrl,qr_set_qrl,nullptr, QUEUE_REPORT_LOW_WATER },
+    { "sys","qrh",_iipn, 0, qr_print_qrh, qr_get_qrh,qr_set_qrh,nullptr, QUEUE_REPORT_HIGH_WATER },
+    { "sys","qri",_iipn, 0, qr_print_qri, qr_get_qri,qr_set_qri,nullptr, QUEUE_REPORT_INTERVAL_MS },
     { "sys","sv", _iipn, 0, sr_print_sv,  sr_get_sv, sr_set_sv, nullptr, STATUS_REPORT_VERBOSITY },
     { "sys","si", _iipn, 0, sr_print_si,  sr_get_si, sr_set_si, nullptr, STATUS_REPORT_INTERVAL_MS },
+    { "sys","sf", _in,   0, sr_print_sf,  sr_get_sf, sr_set_sf, nullptr, 0 },   // per channel - not persisted
 
     // Gcode defaults
     // NOTE: The ordering within the gcode defaults is important for token resolution. gc must follow gco
@@ -1128,6 +1168,7 @@ constexpr cfgItem_t sys_config_items_2[] = {
     { "", "qr",   _n0, 0, qr_print_qr,   qr_get,    set_nul,   nullptr, 0 },    // get queue value - planner buffers available
     { "", "qi",   _n0, 0, qr_print_qi,   qi_get,    set_nul,   nullptr, 0 },    // get queue value - buffers added to queue
     { "", "qo",   _n0, 0, qr_print_qo,   qo_get,    set_nul,   nullptr, 0 },    // get queue value - buffers removed from queue
+    { "", "qt",   _n0, 0, qr_print_qt,   qt_get,    set_nul,   nullptr, 0 },    // get queue value - planned time in queue (ms)
     { "", "er",   _n0, 0, tx_print_nul,  rpt_er,    set_nul,   nullptr, 0 },    // get bogus exception report for testing
     { "", "rx",   _n0, 0, tx_print_int,  get_rx,    set_nul,   nullptr, 0 },    // get RX buffer bytes or packets
     { "", "dw",   _i0, 0, tx_print_int,  st_get_dw, set_noop,  nullptr, 0 },    // get dwell time remaining
@@ -1139,8 +1180,13 @@ constexpr cfgItem_t sys_config_items_2[] = {
     { "", "clr",  _n0, 0, tx_print_nul,  cm_clr,    cm_clr,    nullptr, 0 },    // synonym for "clear"
     { "", "tick", _n0, 0, tx_print_int,  get_tick,  set_nul,   nullptr, 0 },    // get system time tic
     { "", "tram", _b0, 0, cm_print_tram,cm_get_tram,cm_set_tram,nullptr,0 },    // SET to attempt setting rotation matrix from probes
+    { "", "mesh", _b0, 0, cm_print_mesh,cm_get_mesh,cm_set_mesh,nullptr,0 },    // SET to apply the last grid probe as a height map
+    { "", "seek", _i0, 0, cm_print_seek,cm_get_seek,cm_set_seek,nullptr,0 },    // SET to N to restart the job stream at line N, 0 to cancel
     { "", "defa", _b0, 0, tx_print_nul,  help_defa,set_defaults,nullptr,0 },    // set/print defaults / help screen
     { "", "mark", _i0, 0, tx_print_nul,  get_int32, set_int32, &cfg.mark, 0 },
+    { "", "btnv", _i0, 0, tx_print_int,  get_int32, set_ro,    &cfg.boot_nvm_ms, 0 },  // boot: ms to open NVM
+    { "", "btld", _i0, 0, tx_print_int,  get_int32, set_ro,    &cfg.boot_load_ms, 0 }, // boot: ms to load configs
+    { "", "btn",  _i0, 0, tx_print_int,  get_int32, set_ro,    &cfg.boot_values, 0 },  // boot: values restored
     { "", "flash",_b0, 0, tx_print_nul,  help_flash,hw_flash,  nullptr, 0 },
 
 #ifdef __HELP_SCREENS
@@ -1713,10 +1759,11 @@ constexpr const configSubtable * const getSrPersistenceConfig_1() { return &sr_p
     // *** COUNT STARTS FROM HERE ***
 
 constexpr cfgItem_t groups_config_items_1[] = {
-#define FIXED_GROUPS 4
+#define FIXED_GROUPS 5
     { "","sys",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // system group
     { "","p1", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // PWM 1 group
     { "","sp", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // Spindle group
+    { "","rst",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // Raster engraving group
     { "","co", _f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // Coolant group
 
 #define AXIS_GROUPS AXES
@@ -1898,12 +1945,13 @@ constexpr cfgItem_t groups_config_items_1[] = {
     { "","tt32",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // tt offsets
 #endif
 
-#define MACHINE_STATE_GROUPS 9
+#define MACHINE_STATE_GROUPS 10
     { "","mpo",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // machine position group
     { "","pos",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // work position group
     { "","ofs",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // work offset group
     { "","hom",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // axis homing state group
     { "","prb",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // probing state group
+    { "","gprb",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },   // grid probing group
     { "","pwr",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // motor power enagled group
     { "","jog",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // axis jogging state group
     { "","jid",_f0, 0, tx_print_nul, get_grp, set_grp, nullptr, 0 },    // job ID group
@@ -1958,9 +2006,9 @@ constexpr const configSubtable * const getUberGroupsConfig_1() { return &uber_gr
 
 auto nodes = makeSubtableNodes(
     0, getSysConfig_1(), getCmConfig_1(), getMpoConfig_1(), getPosConfig_1(), getOfsConfig_1(), getHomConfig_1(),
-    getPrbConfig_1(), getJogConfig_1(), getJgvConfig_1(), getPwrConfig_1(), getMotorConfig_1(), getAxisConfig_1(), getDIConfig_1(),
+    getPrbConfig_1(), getGprbConfig_1(), getJogConfig_1(), getJgvConfig_1(), getPwrConfig_1(), getMotorConfig_1(), getAxisConfig_1(), getDIConfig_1(),
     getINConfig_1(), getDOConfig_1(), getOUTConfig_1(), getAIConfig_1(), getAINConfig_1(), getP1Config_1(), getPIDConfig_1(),
-    getHEConfig_1(), getCoorConfig_1(), getJobIDConfig_1(), getFixturingConfig_1(), getSpindleConfig_1(),
+    getHEConfig_1(), getCoorConfig_1(), getJobIDConfig_1(), getFixturingConfig_1(), getSpindleConfig_1(), getRasterConfig_1(),
     getCoolantConfig_1(), getSysConfig_2(), getSysConfig_3(), getUserDataConfig_1(), getToolConfig_1(), getDiagnosticConfig_1(),
     getMotorDiagnosticConfig_1(), getSrPersistenceConfig_1(), getGroupsConfig_1(), getUberGroupsConfig_1());
 
@@ -2271,6 +2319,7 @@ static void _do_group(nvObj_t *nv, char *group)   // helper to a group
     nv_reset_nv_list();
     nv = nv_body;
     strncpy(nv->token, group, TOKEN_LEN);
+    nv->token[TOKEN_LEN] = NUL;
     nv->index = nv_get_index((const char *)"", nv->token);
     nv_get_nvObj(nv);
     nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_RESPONSE_FORMAT);
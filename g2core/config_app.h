@@ -58,6 +58,11 @@ typedef struct cfgParameters {  // mostly communications variables at this point
 
     uint32_t mark;            // just a rtransient value to return when asked
 
+    // boot time breakdown, filled in by config_init()
+    uint32_t boot_nvm_ms;     // ms to open and validate persistence
+    uint32_t boot_load_ms;    // ms to read and apply all persisted values (or defaults)
+    uint32_t boot_values;     // number of values restored from persistence
+
     uint16_t magic_end;
 } cfgParameters_t;
 extern cfgParameters_t cfg;
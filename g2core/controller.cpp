@@ -46,7 +46,9 @@
 #include "xio.h"
 #include "settings.h"
 #include "persistence.h"
+#include "trace.h"
 #include "safety_manager.h"
+#include "raster.h"
 
 #include "MotatePower.h"
 
@@ -189,6 +191,7 @@ static void _controller_HSM()
     DISPATCH(mp_planner_callback());            // motion planner
     DISPATCH(cm_operation_runner_callback());   // operation action runner
     DISPATCH(cm_arc_callback(cm));              // arc generation runs as a cycle above lines
+    DISPATCH(cm_drill_cycle_callback(cm));      // canned drilling cycles also run above lines
 
     DISPATCH(cm_homing_cycle_callback());       // homing cycle operation (G28.2)
     DISPATCH(cm_probing_cycle_callback());      // probing cycle operation (G38.2)
@@ -201,6 +204,9 @@ static void _controller_HSM()
     DISPATCH(marlin_callback());                // handle Marlin stuff - may return EAGAIN, must be after planner_callback!
 #endif
     DISPATCH(write_persistent_values_callback());
+#ifdef __TRACE
+    DISPATCH(trace_callback());                 // drain event trace to the secondary channel
+#endif
 
 //----- command readers and parsers --------------------------------------------------//
 
@@ -236,7 +242,7 @@ static stat_t _dispatch_command()
 {
     if (cs.controller_state == CONTROLLER_READY) {
         devflags_t flags = DEV_IS_BOTH | DEV_IS_MUTED; // expressly state we'll handle muted devices
-        if ((!mp_planner_is_full(mp)) && (cs.bufp = xio_readline(flags, cs.linelen)) != NULL) {
+        if ((!mp_planner_is_full(mp)) && (!raster_is_full()) && (cs.bufp = xio_readline(flags, cs.linelen)) != NULL) {
             _dispatch_kernel(flags);
         }
     }
@@ -93,7 +93,7 @@ void coolant_reset() {
 stat_t coolant_control_immediate(coControl control, coSelect select)
 {
     float value[] = { (float)control };
-    bool flags[] = { (select & COOLANT_MIST), (select & COOLANT_FLOOD) };
+    bool flags[] = { (select & COOLANT_MIST) != 0, (select & COOLANT_FLOOD) != 0 };
     _exec_coolant_control(value, flags);
     return(STAT_OK);
 }
@@ -108,7 +108,7 @@ stat_t coolant_control_sync(coControl control, coSelect select)
 
     // queue the coolant control
     float value[] = { (float)control };
-    bool flags[]  = { (select & COOLANT_MIST), (select & COOLANT_FLOOD) };
+    bool flags[]  = { (select & COOLANT_MIST) != 0, (select & COOLANT_FLOOD) != 0 };
     mp_queue_command(_exec_coolant_control, value, flags);
     return(STAT_OK);
 }
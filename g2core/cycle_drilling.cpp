@@ -0,0 +1,468 @@
+/*
+ * cycle_drilling.cpp - canned drilling cycles (G73, G81, G82, G83)
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2026 FabMo
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "canonical_machine.h"
+#include "planner.h"
+#include "util.h"
+
+/*
+ * Canned drilling cycles are expanded into ordinary traverses, feeds and dwells here in
+ * the canonical machine, the same way arcs are expanded into line segments. The setup
+ * function validates the block and computes the cycle levels; the main-loop callback then
+ * queues one move per call until the hole pattern is complete, so the planner is never
+ * asked for more buffers than it has and the moves get full lookahead.
+ *
+ * Levels are measured along the drill axis, which is the axis normal to the selected
+ * plane (Z for G17, Y for G18, X for G19). The cycle drills in the negative direction:
+ *
+ *  - the "initial level" is the drill axis position when the cycle is entered
+ *  - the R level is the retract plane; rapid moves go no lower than this
+ *  - the bottom level is the Z word (or the Y or X word for G18/G19)
+ *  - the clear level is where the tool goes between holes: the higher of the initial
+ *    level and R for G98, or R for G99
+ *
+ *  G81 - feed to the bottom, rapid out
+ *  G82 - feed to the bottom, dwell P seconds, rapid out
+ *  G83 - feed in by Q, rapid out to R, rapid back to just above the previous depth, repeat
+ *  G73 - feed in by Q, rapid back a small chip-breaking distance, repeat
+ *
+ *  R, Z, Q and P are sticky while the motion mode stays in a drilling cycle, so a pattern
+ *  of holes can be given as a list of X Y positions after the first block. L repeats the
+ *  cycle; in G91 the plane axis words are applied as an increment for each repeat, in G90
+ *  the same hole is drilled L times.
+ */
+
+#define DRILL_PECK_CLEARANCE ((float)0.254)     // mm - G83 return / G73 chip break distance (0.010")
+
+enum cmDrillStep {
+    DRILL_STEP_PRELIMINARY = 0,                 // rapid up to R if the cycle is entered below it
+    DRILL_STEP_TO_HOLE,                         // rapid the plane axes over the hole
+    DRILL_STEP_TO_R,                            // rapid the drill axis down to R
+    DRILL_STEP_FEED,                            // feed to the next peck depth or to the bottom
+    DRILL_STEP_PECK_RETRACT,                    // G83 rapid out to R, G73 rapid back the chip break distance
+    DRILL_STEP_PECK_RETURN,                     // G83 rapid back down to just above the previous depth
+    DRILL_STEP_DWELL,                           // G82 dwell at the bottom
+    DRILL_STEP_RETRACT                          // rapid out to the clear level, then the next hole
+};
+
+// Local functions
+
+static stat_t _drill_cycle_setup(const float target[], const bool target_f[],
+                                 const float R_word, const bool R_word_f,
+                                 const float Q_word, const bool Q_word_f,
+                                 const float P_word, const bool P_word_f,
+                                 const uint8_t L_word, const bool L_word_f,
+                                 const cmMotionMode motion_mode,
+                                 float final_position[]);
+static bool _is_drill_cycle(const cmMotionMode motion_mode);
+static bool _is_peck_cycle(const cmMotionMode motion_mode);
+static void _drill_move(cmDrill_t *d, const float target[], const cmMotionMode motion_mode);
+
+/*****************************************************************************
+ * Canned drilling cycle functions
+ *
+ * cm_drill_cycle_init()     - initialize drilling cycle structures
+ * cm_drill_cycle_global()   - canonical machine entry point for G73, G81, G82, G83
+ * cm_drill_cycle_seek()     - model-only G73, G81, G82, G83 for blocks skipped by a seek
+ * cm_drill_cycle_callback() - main-loop callback for drilling cycle move generation
+ * cm_abort_drill_cycle()    - stop a drilling cycle in process
+ */
+
+/*
+ * cm_drill_cycle_init() - initialize drilling cycle structures
+ */
+void cm_drill_cycle_init(cmMachine_t *_cm)
+{
+    _cm->drill.magic_start = MAGICNUM;
+    _cm->drill.magic_end = MAGICNUM;
+}
+
+/*
+ * cm_abort_drill_cycle() - stop drilling cycle movement without maintaining position
+ *
+ *  OK to call if no drilling cycle is running
+ */
+
+void cm_abort_drill_cycle(cmMachine_t *_cm)
+{
+    _cm->drill.run_state = BLOCK_INACTIVE;
+}
+
+/*
+ * _drill_cycle_setup() - set the sticky words, validate the block and compute the cycle
+ *
+ *  Shared by cm_drill_cycle_global() and cm_drill_cycle_seek(). Leaves the levels, the
+ *  first hole and the increment in cm->drill and the end of the last hole in final_position.
+ *  Returns STAT_NOOP for a block with no axis words, which only sets the mode and the words.
+ */
+
+static stat_t _drill_cycle_setup(const float target[], const bool target_f[],
+                                 const float R_word, const bool R_word_f,
+                                 const float Q_word, const bool Q_word_f,
+                                 const float P_word, const bool P_word_f,
+                                 const uint8_t L_word, const bool L_word_f,
+                                 const cmMotionMode motion_mode,
+                                 float final_position[])
+{
+    cmDrill_t *d = &cm->drill;
+
+    // trap some precondition cases where the cycle cannot be run
+    if (cm->gm.feed_rate_mode == INVERSE_TIME_MODE) {
+        return (STAT_INVERSE_TIME_MODE_CANNOT_BE_USED);
+    }
+    if (target_f[AXIS_A] || target_f[AXIS_B] || target_f[AXIS_C]) {
+        return (STAT_ROTARY_AXIS_CANNOT_BE_USED);
+    }
+
+    // set the plane and drill axes from the active plane
+    if (cm->gm.select_plane == CANON_PLANE_XY) {
+        d->plane_axis_0 = AXIS_X;
+        d->plane_axis_1 = AXIS_Y;
+        d->drill_axis = AXIS_Z;
+    } else if (cm->gm.select_plane == CANON_PLANE_XZ) {
+        d->plane_axis_0 = AXIS_X;
+        d->plane_axis_1 = AXIS_Z;
+        d->drill_axis = AXIS_Y;
+    } else if (cm->gm.select_plane == CANON_PLANE_YZ) {
+        d->plane_axis_0 = AXIS_Y;
+        d->plane_axis_1 = AXIS_Z;
+        d->drill_axis = AXIS_X;
+    } else {
+        return (cm_panic(STAT_ACTIVE_PLANE_IS_MISSING, "cm_drill_cycle_global()"));
+    }
+
+    // Sticky words are forgotten when a drilling cycle is entered from another motion mode
+    if (!_is_drill_cycle(cm->gm.motion_mode)) {
+        d->R_word_f = false;
+        d->Z_word_f = false;
+        d->Q_word = 0;
+        d->P_word = 0;
+    }
+    if (R_word_f) {
+        d->R_word = R_word;
+        d->R_word_f = true;
+    }
+    if (target_f[d->drill_axis]) {
+        d->Z_word = target[d->drill_axis];
+        d->Z_word_f = true;
+    }
+    if (Q_word_f) {
+        d->Q_word = Q_word;
+    }
+    if (P_word_f) {
+        d->P_word = P_word;
+    }
+
+    // a cycle block with no axis words only sets the mode and the sticky words
+    if (!target_f[d->plane_axis_0] && !target_f[d->plane_axis_1] && !target_f[d->drill_axis]) {
+        cm->gm.motion_mode = motion_mode;
+        return (STAT_NOOP);
+    }
+
+    // validate the words the cycle needs - a rejected block leaves the motion mode alone,
+    // so a later bare axis word doesn't start a cycle that was never accepted
+    if (fp_ZERO(cm->gm.feed_rate)) {
+        return (STAT_FEEDRATE_NOT_SPECIFIED);
+    }
+    if (!d->R_word_f) {
+        return (STAT_R_WORD_IS_MISSING);
+    }
+    if (!d->Z_word_f) {
+        return (STAT_AXIS_IS_MISSING);
+    }
+    if (_is_peck_cycle(motion_mode)) {
+        if (fp_ZERO(d->Q_word)) {
+            return (STAT_Q_WORD_IS_MISSING);
+        }
+        if (d->Q_word < 0) {
+            return (STAT_Q_WORD_IS_INVALID);
+        }
+    }
+    if (d->P_word < 0) {
+        return (STAT_P_WORD_IS_NEGATIVE);
+    }
+    if (L_word_f && (L_word == 0)) {
+        return (STAT_L_WORD_IS_INVALID);
+    }
+
+    // compute the drill axis levels in absolute machine coordinates
+    float initial_level = cm->gmx.position[d->drill_axis];
+    if (cm->gm.distance_mode == INCREMENTAL_DISTANCE_MODE) {
+        d->r_level = initial_level + _to_millimeters(d->R_word);
+        d->bottom_level = d->r_level + _to_millimeters(d->Z_word);
+    } else {
+        float offset = cm_get_combined_offset(d->drill_axis);
+        d->r_level = offset + _to_millimeters(d->R_word);
+        d->bottom_level = offset + _to_millimeters(d->Z_word);
+    }
+    if (d->bottom_level > d->r_level) {
+        return (STAT_R_WORD_IS_INVALID);                        // R level must not be below the bottom
+    }
+    cm->gm.motion_mode = motion_mode;
+    d->clear_level = d->r_level;
+    if ((cm->gmx.retract_mode == RETRACT_TO_INITIAL_LEVEL) && (initial_level > d->r_level)) {
+        d->clear_level = initial_level;
+    }
+    d->peck = _to_millimeters(d->Q_word);
+    d->dwell = d->P_word;
+
+    // compute the first hole position and the increment for L repeats
+    copy_vector(d->hole, cm->gmx.position);
+    d->increment_0 = 0;
+    d->increment_1 = 0;
+    if (cm->gm.distance_mode == INCREMENTAL_DISTANCE_MODE) {
+        if (target_f[d->plane_axis_0]) {
+            d->increment_0 = _to_millimeters(target[d->plane_axis_0]);
+        }
+        if (target_f[d->plane_axis_1]) {
+            d->increment_1 = _to_millimeters(target[d->plane_axis_1]);
+        }
+        d->hole[d->plane_axis_0] += d->increment_0;
+        d->hole[d->plane_axis_1] += d->increment_1;
+    } else {
+        if (target_f[d->plane_axis_0]) {
+            d->hole[d->plane_axis_0] = cm_get_combined_offset(d->plane_axis_0) + _to_millimeters(target[d->plane_axis_0]);
+        }
+        if (target_f[d->plane_axis_1]) {
+            d->hole[d->plane_axis_1] = cm_get_combined_offset(d->plane_axis_1) + _to_millimeters(target[d->plane_axis_1]);
+        }
+    }
+    d->holes = (L_word_f ? L_word : 1);
+
+    // final position is the last hole at the clear level
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        final_position[axis] = d->hole[axis];                  // final_position is a pointer - no copy_vector()
+    }
+    final_position[d->plane_axis_0] += d->increment_0 * (d->holes - 1);
+    final_position[d->plane_axis_1] += d->increment_1 * (d->holes - 1);
+    final_position[d->drill_axis] = d->clear_level;
+    return (STAT_OK);
+}
+
+/*
+ * cm_drill_cycle_global() - canonical machine entry point for canned drilling cycles
+ *
+ *  Target and words are in Gcode units and are interpreted according to the distance mode.
+ *  R_word is the R level, Q_word the peck increment (G73, G83), P_word the dwell in seconds
+ *  (G82) and L_word the repeat count. The model position is advanced to the end of the last
+ *  hole before any moves are queued; the moves themselves are queued by the callback.
+ */
+
+stat_t cm_drill_cycle_global(const float target[], const bool target_f[],
+                             const float R_word, const bool R_word_f,
+                             const float Q_word, const bool Q_word_f,
+                             const float P_word, const bool P_word_f,
+                             const uint8_t L_word, const bool L_word_f,
+                             const cmMotionMode motion_mode)
+{
+    cmDrill_t *d = &cm->drill;
+    float final_position[AXES];
+
+    stat_t status = _drill_cycle_setup(target, target_f, R_word, R_word_f, Q_word, Q_word_f,
+                                       P_word, P_word_f, L_word, L_word_f, motion_mode, final_position);
+    if (status != STAT_OK) {
+        return ((status == STAT_NOOP) ? STAT_OK : status);
+    }
+    float initial_level = cm->gmx.position[d->drill_axis];      // the setup doesn't move the model
+
+    // test soft limits at the extremes of the pattern - holes are in a straight line
+    float test_position[AXES];
+    for (uint8_t i=0; i<4; i++) {
+        copy_vector(test_position, (i < 2) ? d->hole : final_position);
+        test_position[d->drill_axis] = (i & 1) ? d->bottom_level : std::max(d->clear_level, initial_level);
+        if ((status = cm_test_soft_limits(test_position)) != STAT_OK) {
+            cm->gm.motion_mode = MOTION_MODE_CANCEL_MOTION_MODE;
+            return (cm_alarm(status, "drill cycle soft limits"));   // throw an alarm
+        }
+    }
+
+    // capture the Gcode state for the cycle moves and start the cycle
+    cm_set_display_offsets(MODEL);
+    memcpy(&d->gm, MODEL, sizeof(GCodeState_t));
+    copy_vector(d->position, cm->gmx.position);
+    d->motion_mode = motion_mode;
+    d->step = DRILL_STEP_PRELIMINARY;
+
+    copy_vector(cm->gm.target, final_position);
+    cm_cycle_start();                                           // if not already started
+    d->run_state = BLOCK_ACTIVE;                                // enable cycle to be run from the callback
+    cm_update_model_position();
+    return (STAT_OK);
+}
+
+/*
+ * cm_drill_cycle_seek() - model-only canned drilling cycle, for blocks skipped by a seek
+ *
+ *  Records the sticky words and moves the model to the end of the last hole at the clear
+ *  level, exactly as cm_drill_cycle_global() would, but queues nothing. Soft limits are
+ *  left to the blocks that actually run.
+ */
+
+stat_t cm_drill_cycle_seek(const float target[], const bool target_f[],
+                           const float R_word, const bool R_word_f,
+                           const float Q_word, const bool Q_word_f,
+                           const float P_word, const bool P_word_f,
+                           const uint8_t L_word, const bool L_word_f,
+                           const cmMotionMode motion_mode)
+{
+    float final_position[AXES];
+
+    stat_t status = _drill_cycle_setup(target, target_f, R_word, R_word_f, Q_word, Q_word_f,
+                                       P_word, P_word_f, L_word, L_word_f, motion_mode, final_position);
+    if (status != STAT_OK) {
+        return ((status == STAT_NOOP) ? STAT_OK : status);
+    }
+    copy_vector(cm->gm.target, final_position);
+    cm_update_model_position();
+    return (STAT_OK);
+}
+
+/*
+ * cm_drill_cycle_callback() - generate drilling cycle moves
+ *
+ *  Called from the controller main loop. Each call queues at most one move of the hole
+ *  sequence and returns EAGAIN until the last hole has been retracted from.
+ */
+
+stat_t cm_drill_cycle_callback(cmMachine_t *_cm)
+{
+    cmDrill_t *d = &_cm->drill;
+
+    if (d->run_state == BLOCK_INACTIVE) {
+        return (STAT_NOOP);
+    }
+    if (mp_planner_is_full(mp)) {
+        return (STAT_EAGAIN);
+    }
+
+    float target[AXES];
+    copy_vector(target, d->position);
+
+    switch (d->step) {
+        case DRILL_STEP_PRELIMINARY: {
+            if (d->position[d->drill_axis] < d->r_level) {
+                target[d->drill_axis] = d->r_level;
+                _drill_move(d, target, MOTION_MODE_STRAIGHT_TRAVERSE);
+            }
+            d->step = DRILL_STEP_TO_HOLE;
+            break;
+        }
+        case DRILL_STEP_TO_HOLE: {
+            target[d->plane_axis_0] = d->hole[d->plane_axis_0];
+            target[d->plane_axis_1] = d->hole[d->plane_axis_1];
+            _drill_move(d, target, MOTION_MODE_STRAIGHT_TRAVERSE);
+            d->step = DRILL_STEP_TO_R;
+            break;
+        }
+        case DRILL_STEP_TO_R: {
+            target[d->drill_axis] = d->r_level;
+            _drill_move(d, target, MOTION_MODE_STRAIGHT_TRAVERSE);
+            d->depth_level = d->r_level;
+            d->step = DRILL_STEP_FEED;
+            break;
+        }
+        case DRILL_STEP_FEED: {
+            float level = d->bottom_level;
+            if (_is_peck_cycle(d->motion_mode)) {
+                level = std::max(d->depth_level - d->peck, d->bottom_level);
+            }
+            target[d->drill_axis] = level;
+            _drill_move(d, target, MOTION_MODE_STRAIGHT_FEED);
+            d->depth_level = level;
+            if (level > d->bottom_level) {
+                d->step = DRILL_STEP_PECK_RETRACT;
+            } else if ((d->motion_mode == MOTION_MODE_CANNED_CYCLE_82) && (d->dwell > 0)) {
+                d->step = DRILL_STEP_DWELL;
+            } else {
+                d->step = DRILL_STEP_RETRACT;
+            }
+            break;
+        }
+        case DRILL_STEP_PECK_RETRACT: {
+            if (d->motion_mode == MOTION_MODE_CANNED_CYCLE_83) {
+                target[d->drill_axis] = d->r_level;
+                d->step = DRILL_STEP_PECK_RETURN;
+            } else {
+                target[d->drill_axis] = std::min(d->depth_level + DRILL_PECK_CLEARANCE, d->r_level);
+                d->step = DRILL_STEP_FEED;
+            }
+            _drill_move(d, target, MOTION_MODE_STRAIGHT_TRAVERSE);
+            break;
+        }
+        case DRILL_STEP_PECK_RETURN: {
+            target[d->drill_axis] = std::min(d->depth_level + DRILL_PECK_CLEARANCE, d->r_level);
+            _drill_move(d, target, MOTION_MODE_STRAIGHT_TRAVERSE);
+            d->step = DRILL_STEP_FEED;
+            break;
+        }
+        case DRILL_STEP_DWELL: {
+            mp_dwell(d->dwell);
+            d->step = DRILL_STEP_RETRACT;
+            break;
+        }
+        case DRILL_STEP_RETRACT: {
+            target[d->drill_axis] = d->clear_level;
+            _drill_move(d, target, MOTION_MODE_STRAIGHT_TRAVERSE);
+            if (--(d->holes) == 0) {
+                d->run_state = BLOCK_INACTIVE;
+                return (STAT_OK);
+            }
+            d->hole[d->plane_axis_0] += d->increment_0;
+            d->hole[d->plane_axis_1] += d->increment_1;
+            d->step = DRILL_STEP_TO_HOLE;
+            break;
+        }
+    }
+    return (STAT_EAGAIN);
+}
+
+/*
+ * _drill_move() - queue one traverse or feed of the cycle and advance the cycle position
+ *
+ *  Zero length moves (e.g. a hole under the current position) are dropped by mp_aline().
+ */
+
+static void _drill_move(cmDrill_t *d, const float target[], const cmMotionMode motion_mode)
+{
+    copy_vector(d->gm.target, target);
+    d->gm.motion_mode = motion_mode;
+    mp_aline(&d->gm);
+    copy_vector(d->position, target);
+}
+
+static bool _is_drill_cycle(const cmMotionMode motion_mode)
+{
+    return ((motion_mode == MOTION_MODE_CANNED_CYCLE_73) || (motion_mode == MOTION_MODE_CANNED_CYCLE_81) ||
+            (motion_mode == MOTION_MODE_CANNED_CYCLE_82) || (motion_mode == MOTION_MODE_CANNED_CYCLE_83));
+}
+
+static bool _is_peck_cycle(const cmMotionMode motion_mode)
+{
+    return ((motion_mode == MOTION_MODE_CANNED_CYCLE_73) || (motion_mode == MOTION_MODE_CANNED_CYCLE_83));
+}
@@ -37,6 +37,8 @@
 #include "spindle.h"
 #include "coolant.h"
 #include "util.h"
+#include "trace.h"
+#include "raster.h"
 #include "xio.h"
 
 //static void _start_feedhold(void);
@@ -534,9 +536,13 @@ stat_t _run_queue_flush()            // typically runs from cm1 planner
     // resetting the planner, but ALSO updating the planner position - do before aborts
     planner_reset((mpPlanner_t *)cm->mp);   // reset primary planner. also resets the mr under the planner
     cm_reset_position_to_absolute_position(cm);
+    if (cm == &cm1) {
+        raster_reset();                     // raster scanlines only ride on the primary planner
+    }
 
     // now that the planner is reset, if the code in these aborts uses planner position, it'll be correct(ish)
     cm_abort_arc(cm);                       // kill arcs so they don't just create more alines
+    cm_abort_drill_cycle(cm);               // ...same for canned drilling cycles
     cm_abort_homing(cm);                    // kill homing so it can reset cleanly
     cm_abort_probing(cm);                   // kill probing so it can exit cleanly
     cm1.queue_flush_state = QUEUE_FLUSH_OFF;
@@ -675,7 +681,10 @@ void cm_request_feedhold(cmFeedholdType type, cmFeedholdExit exit)
 
             cm1.hold_type = type;
             cm1.hold_exit = exit;
+            cm1.hold_stats.request_time = SysTickTimer.getValue();  // start the latency clock
+            cm1.hold_stats.synced = false;
             cm1.hold_state = FEEDHOLD_SYNC;  // mark immediately so % sees pending hold
+            TRACE(TRACE_FEEDHOLD, FEEDHOLD_SYNC, type);
 
             switch (cm1.hold_type) {
                 case FEEDHOLD_TYPE_HOLD:     { op.add_action(_feedhold_no_actions); break; }
@@ -767,6 +776,7 @@ void _enter_p2()
     cm2.queue_flush_state = QUEUE_FLUSH_OFF;
     cm2.gm.feed_rate = 0;
     cm2.arc.run_state = BLOCK_INACTIVE;     // Stop a running p1 arc from continuing to execute in p2
+    cm2.drill.run_state = BLOCK_INACTIVE;   // ...and a running drilling cycle
 
     // Set mp planner to p2 and reset it
     cm2.mp = &mp2;
@@ -829,6 +839,7 @@ void _check_motion_stopped()
         mr->reset();                                    // reset MR for next use and for forward planning
         cm_set_motion_state(MOTION_STOP);
         cm->hold_state = FEEDHOLD_MOTION_STOPPED;
+        cm->hold_stats.request_time = 0;                // nothing was moving - no stop to measure
         sr_request_status_report(SR_REQUEST_IMMEDIATE);
     }
 }
@@ -1200,11 +1211,21 @@ stat_t _run_restart_cycle(void)
             }
         }
     }
+    // Same for a suspended drilling cycle
+    if (cm1.drill.run_state != BLOCK_INACTIVE) {
+        if (!mp_has_runnable_buffer(&mp1)) {
+            stat_t drill_status = cm_drill_cycle_callback(&cm1);
+            if (!mp_has_runnable_buffer(&mp1)) {
+                return ((drill_status == STAT_OK) ? STAT_EAGAIN : drill_status);
+            }
+        }
+    }
 
     // Only clear the hold if a new feedhold hasn't been requested between
     // _dispatch_control() and here (race: ! sets SYNC, then this overwrites it).
     if (cm1.hold_state != FEEDHOLD_SYNC) {
         cm1.hold_state = FEEDHOLD_OFF;      // must precede st_request_exec_move()
+        TRACE(TRACE_FEEDHOLD, FEEDHOLD_OFF, cm1.hold_type);
     }
 
     // ... second place where we are cleanly starting a new block ... 
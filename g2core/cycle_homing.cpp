@@ -37,10 +37,24 @@
 #include "kinematics.h"
 #include "gpio.h"
 #include "report.h"
+#include "stepper.h"
 #include "util.h"
 
+// Sensorless homing: load readings are only meaningful once the motor is up to speed
+#define HOMING_STALL_ARM_FRACTION       0.9     // fraction of search velocity before stall readings are trusted
+#define HOMING_STALL_CALIBRATION_FACTOR 0.5     // calibrated threshold as a fraction of the lowest free-running reading
+
 /**** Homing singleton structure ****/
 
+struct hmAxisParams {               // per-axis parameters computed from the axis settings
+    float search_travel;            // signed distance to travel in search
+    float search_velocity;          // search speed as positive number
+    float latch_backoff;            // max distance to back off switch during latch phase
+    float latch_velocity;           // latch speed as positive number
+    float zero_backoff;             // distance to back off switch before setting zero
+    float setpoint;                 // ultimate setpoint, usually zero, but not always
+};
+
 struct hmHomingSingleton {          // persistent homing runtime variables
                                     // controls for homing cycle
     bool   waiting_for_motion_end;  // true when waiting for motion to complete.
@@ -61,6 +75,31 @@ struct hmHomingSingleton {          // persistent homing runtime variables
     float max_clear_backoff;        // maximum distance of switch clearing backoffs before erring out
     float setpoint;                 // ultimate setpoint, usually zero, but not always
 
+    // sensorless homing ($xsg > 0)
+    bool     sensorless;            // current axis is homed by stall detection instead of its switch
+    bool     stall_seeking;         // a sensorless search move is running
+    bool     stalled;               // the search was stopped by a stall
+    uint32_t stall_samples;         // sample count of the last load reading examined
+
+    // stall calibration ($xsgc)
+    bool     cal_active;            // recording load readings for cal_axis
+    uint8_t  cal_axis;
+    uint32_t cal_samples;           // sample count of the last load reading recorded
+    uint32_t cal_readings;          // number of readings taken at search velocity
+    uint16_t cal_min;               // lowest reading taken at search velocity
+    float    cal_velocity;          // the axis' search velocity
+
+    // simultaneous homing ($hms=1) - the axes after Z are homed together as a group
+    bool   group_done;              // true once the group has been homed in this cycle
+    bool   group_active;            // true while the group is being homed
+    bool   group[AXES];             // axes in the group
+    bool   seeking[AXES];           // axes whose switch is sought by the current group move
+    volatile bool hit[AXES];        // set by the input handler when a seeking axis' switch fires
+    bool   failed[AXES];            // axis did not find its switch in the search travel
+    float  remaining[AXES];         // signed travel left for each seeking axis
+    float  start[AXES];             // runtime position at the start of the current group move
+    hmAxisParams ap[AXES];          // per-axis parameters for the group
+
     // state saved from gcode model
     cmCoordSystem  saved_coord_system;    // G54 - G59 setting
     cmDistanceMode saved_distance_mode;   // G90, G91 global setting
@@ -80,10 +119,26 @@ static stat_t _homing_axis_latch(int8_t axis);
 static stat_t _homing_axis_setpoint_backoff(int8_t axis);
 static stat_t _homing_axis_set_position(int8_t axis);
 static stat_t _homing_axis_move(int8_t axis, float target, float velocity);
+static stat_t _homing_axis_params(int8_t axis, hmAxisParams *p);
+static stat_t _homing_group_init(int8_t axis);
+static stat_t _homing_group_clear_init(int8_t axis);
+static stat_t _homing_group_search_start(int8_t axis);
+static stat_t _homing_group_search(int8_t axis);
+static stat_t _homing_group_clear(int8_t axis);
+static stat_t _homing_group_latch_start(int8_t axis);
+static stat_t _homing_group_latch(int8_t axis);
+static stat_t _homing_group_setpoint_backoff(int8_t axis);
+static stat_t _homing_group_set_position(int8_t axis);
+static void _homing_group_seek_init(const bool latch);
+static stat_t _homing_group_seek(const bool latch);
+static stat_t _homing_group_move(const float travel[], const bool flags[], const float velocity[], const bool seek);
 static stat_t _homing_error_exit(int8_t axis, stat_t status);
+static void _homing_group_failures(char *msg);
 static stat_t _homing_finalize_exit(int8_t axis);
 static int8_t _get_next_axis(int8_t axis);
 static void _homing_axis_move_callback(float* vect, bool* flag);
+static void _homing_stall_check(void);
+static void _homing_stall_calibrate(void);
 
 /**** HELPERS ***************************************************************************
  * _set_homing_func() - a convenience for setting the next dispatch vector and exiting
@@ -101,9 +156,24 @@ static stat_t _set_homing_func(stat_t (*func)(int8_t axis)) {
 gpioDigitalInputHandler _homing_handler {
     [](const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
         if (cm->cycle_type != CYCLE_HOMING) { return GPIO_NOT_HANDLED; }
-        if (triggering_pin_number != hm.homing_input) { return GPIO_NOT_HANDLED; }
         if (edge != INPUT_EDGE_LEADING) { return GPIO_NOT_HANDLED; }
+        if (hm.group_active) {
+            bool seeking = false;
+            for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+                if (hm.seeking[axis] && (cm->a[axis].homing_input == triggering_pin_number)) {
+                    hm.hit[axis] = true;
+                    seeking = true;
+                }
+            }
+            if (!seeking) { return GPIO_NOT_HANDLED; }
+        } else if (triggering_pin_number != hm.homing_input) {
+            return GPIO_NOT_HANDLED;
+        }
 
+        if (hm.sensorless) {                    // a DIAG pin on the homing input - the driver saw the stall
+            hm.stall_seeking = false;
+            hm.stalled = true;
+        }
         en_take_encoder_snapshot();
         cm_request_feedhold(FEEDHOLD_TYPE_SKIP, FEEDHOLD_EXIT_RESET_POSITION);
 
@@ -158,6 +228,38 @@ gpioDigitalInputHandler _homing_handler {
  *  When a homing cycle is initiated the homing state is set to HOMING_NOT_HOMED
  *  When homing completes successfully this is set to HOMING_HOMED, otherwise it
  *  remains HOMING_NOT_HOMED.
+ *
+ *  --- Simultaneous homing ($hms=1) ---
+ *
+ *  Z is homed on its own first as above, then all the remaining axes of a G28.2 are
+ *  homed as one group: each phase (clear, search, latch, zero backoff) is a single
+ *  move of all the axes in the group, with each axis moving at its own velocity.
+ *  The planner can only stop all axes together, so when one axis hits its switch
+ *  the group move is stopped, that axis drops out of the phase, and the phase is
+ *  re-issued for the remaining axes with their remaining travel. The phase ends
+ *  when every axis has found its switch or run out of travel.
+ *
+ *  An axis that exhausts its search travel without finding its switch fails; the
+ *  rest of the group still completes. Axes that share a homing input with an axis
+ *  already in the group are homed one at a time after the group, as is everything in
+ *  a G28.4 cycle - this happens whether or not a group axis failed. The failed group
+ *  axes are reported together when the cycle ends (with any axis that fails after the
+ *  group), and the cycle then fails. Per-axis outcomes are also visible in the homed
+ *  flags ({hom:n}).
+ *
+ *  --- Sensorless homing ($xsg > 0) ---
+ *
+ *  An axis with a stall threshold is homed without a switch, on drivers that can sense
+ *  motor load (Trinamic stallGuard). The search stops when the load reading of any of
+ *  the axis' motors drops to the threshold (lower reading is more load) or the driver
+ *  flags a stall, then the axis backs off by the zero backoff and sets its position.
+ *  There is no clear or latch move. If a driver's DIAG output is wired to an input,
+ *  set that as the homing input and the stall will also arrive through it, without
+ *  waiting on the next load reading. Sensorless axes are always homed one at a time.
+ *
+ *  To calibrate, set {xsgc:1}, move the axis at its search velocity clear of any end
+ *  stop, then set {xsgc:0}. The threshold is set to half of the lowest reading seen
+ *  while the axis was close to search velocity, the same readings the search trusts.
  */
 /*  --- Some further details ---
  *
@@ -190,6 +292,8 @@ stat_t cm_homing_cycle_start(const float axes[], const bool flags[]) {
     cm_set_feed_rate_mode(UNITS_PER_MINUTE_MODE);
     hm.set_coordinates = true;
     hm.waiting_for_motion_end = false;
+    hm.group_done = false;
+    hm.group_active = false;
 
     // clear rotation matrix
     canonical_machine_reset_rotation(cm);
@@ -213,6 +317,9 @@ stat_t cm_homing_cycle_start_no_set(const float axes[], const bool flags[]) {
  */
 
 stat_t cm_homing_cycle_callback(void) {
+    if (hm.cal_active) {
+        _homing_stall_calibrate();
+    }
     if (cm->cycle_type != CYCLE_HOMING) {   // exit if not in a homing cycle
         return (STAT_NOOP);
     }
@@ -223,6 +330,7 @@ stat_t cm_homing_cycle_callback(void) {
             cm_abort_homing(cm);
             return (STAT_OK);
         }
+        _homing_stall_check();
         return (STAT_EAGAIN);
     }
     return (hm.func(hm.axis));              // execute the current homing move
@@ -262,24 +370,76 @@ static stat_t _homing_axis_start(int8_t axis) {
     // get the first or next axis
     if ((axis = _get_next_axis(axis)) < 0) {  // axes are done or error
         if (axis == -1) {                     // -1 is done
+            char msg[NV_MESSAGE_LEN] = "";
+            _homing_group_failures(msg);
+            if (msg[0] != 0) {              // a group axis failed - the others have been homed
+                nv_reset_nv_list();
+                nv_add_conditional_message(msg);
+                nv_print_list(STAT_HOMING_CYCLE_FAILED, TEXT_MULTILINE_FORMATTED, JSON_RESPONSE_FORMAT);
+                _homing_finalize_exit(axis);
+                return (STAT_HOMING_CYCLE_FAILED);  // homing state remains HOMING_NOT_HOMED
+            }
             cm->homing_state = HOMING_HOMED;
             return (_set_homing_func(_homing_finalize_exit));
         } else if (axis == -2) {  // -2 is error
             return (_homing_error_exit(-2, STAT_HOMING_ERROR_BAD_OR_NO_AXIS));
         }
     }
+    // hms=1: Z is homed on its own, the axes after it are homed together
+    if (cm->homing_simultaneous && hm.set_coordinates && !hm.group_done && (axis != AXIS_Z) &&
+        (cm->a[axis].stall_threshold == 0)) {
+        return (_homing_group_init(axis));
+    }
+
     // clear the homed flag for axis so we'll be able to move w/o triggering soft limits
     cm->homed[axis] = false;
 
+    hmAxisParams p;
+    stat_t status = _homing_axis_params(axis, &p);
+    if (status != STAT_OK) {
+        return (_homing_error_exit(axis, status));
+    }
+
+    // Nothing to do about direction now that direction is explicit
+    // However, here's a good place to stash the homing_switch:
+    hm.homing_input = cm->a[axis].homing_input;
+    din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_homing_handler);
+    hm.sensorless = (cm->a[axis].stall_threshold > 0);
+    hm.stalled = false;
+
+    hm.axis            = axis;                                  // persist the axis
+    hm.search_travel   = p.search_travel;
+    hm.search_velocity = p.search_velocity;
+    hm.latch_backoff   = p.latch_backoff;
+    hm.latch_velocity  = p.latch_velocity;
+    hm.zero_backoff    = p.zero_backoff;
+    hm.setpoint        = p.setpoint;
+
+    // if homing is disabled for the axis then skip to the next axis
+    return (_set_homing_func(_homing_axis_clear_init));         // perform an initial clear
+}
+
+/***********************************************************************************
+ * _homing_axis_params() - validate the axis settings and compute its homing parameters
+ */
+static stat_t _homing_axis_params(int8_t axis, hmAxisParams *p) {
+
     // trap axis mis-configurations
-    if (fp_ZERO(cm->a[axis].homing_input)) {
-        return (_homing_error_exit(axis, STAT_HOMING_ERROR_HOMING_INPUT_MISCONFIGURED));
+    if (cm->a[axis].stall_threshold > 0) {              // sensorless - the homing input is optional (DIAG)
+        stLoad_t load;
+        if (!st_get_axis_load(axis, load)) {
+            return (STAT_HOMING_ERROR_NO_STALL_DETECTION);
+        }
+    } else {
+        if (fp_ZERO(cm->a[axis].homing_input)) {
+            return (STAT_HOMING_ERROR_HOMING_INPUT_MISCONFIGURED);
+        }
+        if (fp_ZERO(cm->a[axis].latch_velocity)) {
+            return (STAT_HOMING_ERROR_ZERO_LATCH_VELOCITY);
+        }
     }
     if (fp_ZERO(cm->a[axis].search_velocity)) {
-        return (_homing_error_exit(axis, STAT_HOMING_ERROR_ZERO_SEARCH_VELOCITY));
-    }
-    if (fp_ZERO(cm->a[axis].latch_velocity)) {
-        return (_homing_error_exit(axis, STAT_HOMING_ERROR_ZERO_LATCH_VELOCITY));
+        return (STAT_HOMING_ERROR_ZERO_SEARCH_VELOCITY);
     }
 
     // Calculate and test travel distance
@@ -292,39 +452,31 @@ static stat_t _homing_axis_start(int8_t axis) {
         travel_distance = std::abs(cm->a[axis].travel_max - cm->a[axis].travel_min) + cm->a[axis].latch_backoff;
     }
     if (fp_ZERO(travel_distance)) {
-        return (_homing_error_exit(axis, STAT_HOMING_ERROR_TRAVEL_MIN_MAX_IDENTICAL));
+        return (STAT_HOMING_ERROR_TRAVEL_MIN_MAX_IDENTICAL);
     }
 
-    // Nothing to do about direction now that direction is explicit
-    // However, here's a good place to stash the homing_switch:
-    hm.homing_input = cm->a[axis].homing_input;
-    din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_homing_handler);
-
-    hm.axis            = axis;                                  // persist the axis
-    hm.search_velocity = std::abs(cm->a[axis].search_velocity);     // search velocity is always positive
-    hm.latch_velocity  = std::abs(cm->a[axis].latch_velocity);      // latch velocity is always positive
+    p->search_velocity = std::abs(cm->a[axis].search_velocity);     // search velocity is always positive
+    p->latch_velocity  = std::abs(cm->a[axis].latch_velocity);      // latch velocity is always positive
 
     bool homing_to_max = cm->a[axis].homing_dir;
 
     // setup parameters for positive or negative travel (homing to the max or min switch)
     if (homing_to_max) {
-        hm.search_travel = travel_distance;                     // search travels in positive direction
-        hm.latch_backoff = std::abs(cm->a[axis].latch_backoff);     // latch travels in positive direction
-        hm.zero_backoff  = -std::max(0.0f, cm->a[axis].zero_backoff);// zero backoff is negative direction (or zero)
-                                                                // will set the maximum position
-                                                                //     (plus any negative backoff)
-        hm.setpoint = cm->a[axis].travel_max + (std::max(0.0f, -cm->a[axis].zero_backoff));
+        p->search_travel = travel_distance;                         // search travels in positive direction
+        p->latch_backoff = std::abs(cm->a[axis].latch_backoff);     // latch travels in positive direction
+        p->zero_backoff  = -std::max(0.0f, cm->a[axis].zero_backoff);// zero backoff is negative direction (or zero)
+                                                                    // will set the maximum position
+                                                                    //     (plus any negative backoff)
+        p->setpoint = cm->a[axis].travel_max + (std::max(0.0f, -cm->a[axis].zero_backoff));
     } else {
-        hm.search_travel = -travel_distance;                    // search travels in negative direction
-        hm.latch_backoff = -std::abs(cm->a[axis].latch_backoff);    // latch travels in negative direction
-        hm.zero_backoff  = std::max(0.0f, cm->a[axis].zero_backoff); // zero backoff is positive direction (or zero)
-                                                                // will set the minimum position
-                                                                //     (minus any negative backoff)
-        hm.setpoint = cm->a[axis].travel_min + (std::max(0.0f, -cm->a[axis].zero_backoff));
+        p->search_travel = -travel_distance;                        // search travels in negative direction
+        p->latch_backoff = -std::abs(cm->a[axis].latch_backoff);    // latch travels in negative direction
+        p->zero_backoff  = std::max(0.0f, cm->a[axis].zero_backoff); // zero backoff is positive direction (or zero)
+                                                                    // will set the minimum position
+                                                                    //     (minus any negative backoff)
+        p->setpoint = cm->a[axis].travel_min + (std::max(0.0f, -cm->a[axis].zero_backoff));
     }
-
-    // if homing is disabled for the axis then skip to the next axis
-    return (_set_homing_func(_homing_axis_clear_init));         // perform an initial clear
+    return (STAT_OK);
 }
 
 /***********************************************************************************
@@ -332,10 +484,11 @@ static stat_t _homing_axis_start(int8_t axis) {
  *
  *  Handle an initial switch closure by backing off the closed switch
  *  NOTE: clear_init() relies on independent switches per axis (not shared)
+ *  A sensorless axis has no switch to clear, so it goes straight to the search.
  */
 static stat_t _homing_axis_clear_init(int8_t axis)  // first clear move
 {
-    if (gpio_read_input(hm.homing_input) == INPUT_ACTIVE) {  // the switch is closed at startup
+    if (!hm.sensorless && (gpio_read_input(hm.homing_input) == INPUT_ACTIVE)) {  // the switch is closed at startup
 
         // determine if the input switch for this axis is shared w/other axes
         for (uint8_t check_axis = AXIS_X; check_axis < AXES; check_axis++) {
@@ -351,9 +504,22 @@ static stat_t _homing_axis_clear_init(int8_t axis)  // first clear move
 
 /***********************************************************************************
  * _homing_axis_search() - fast search for switch, closes switch
+ *
+ *  A sensorless search stops on a stall (see _homing_stall_check()). Stall detection
+ *  doesn't work at latch speeds, so the stall position is taken as is and the clear and
+ *  latch moves are skipped.
  */
 static stat_t _homing_axis_search(int8_t axis)  // drive to switch
 {
+    if (hm.sensorless) {
+        stLoad_t load;
+        st_get_axis_load(axis, load);
+        hm.stall_samples = load.samples;
+        hm.stall_seeking = true;
+        st_set_axis_stall_output(axis, true);                   // for a DIAG pin wired to the homing input
+        _homing_axis_move(axis, hm.search_travel, hm.search_velocity);
+        return (_set_homing_func(_homing_axis_setpoint_backoff));
+    }
     _homing_axis_move(axis, hm.search_travel, hm.search_velocity);
     return (_set_homing_func(_homing_axis_clear));
 }
@@ -381,6 +547,13 @@ static stat_t _homing_axis_latch(int8_t axis)  // drive to switch at low speed
  */
 static stat_t _homing_axis_setpoint_backoff(int8_t axis)  //
 {
+    if (hm.sensorless) {
+        hm.stall_seeking = false;
+        st_set_axis_stall_output(axis, false);
+        if (!hm.stalled) {
+            return (_homing_error_exit(axis, STAT_HOMING_ERROR_SWITCH_NOT_FOUND));
+        }
+    }
     _homing_axis_move(axis, hm.zero_backoff, hm.search_velocity);
     return (_set_homing_func(_homing_axis_set_position));
 }
@@ -432,6 +605,385 @@ static stat_t _homing_axis_move(int8_t axis, float target, float velocity) {
 
 static void _homing_axis_move_callback(float* vect, bool* flag) { hm.waiting_for_motion_end = false; }
 
+/***********************************************************************************
+ * _homing_stall_check() - stop a sensorless search when the axis' drivers report a stall
+ *
+ *  Called from the main loop while a homing move runs. Each new load reading (see
+ *  st_get_axis_load()) is compared to the axis' stall threshold, but only once the axis
+ *  is close to search velocity - readings while accelerating or decelerating are not
+ *  reliable. A stall stops the move the same way the homing switch does.
+ */
+static void _homing_stall_check() {
+    if (!hm.stall_seeking) {
+        return;
+    }
+    stLoad_t load;
+    if (!st_get_axis_load(hm.axis, load) || (load.samples == hm.stall_samples)) {
+        return;                                                 // no new reading
+    }
+    hm.stall_samples = load.samples;
+    if (load.standstill || (mp_get_runtime_velocity() < hm.search_velocity * HOMING_STALL_ARM_FRACTION)) {
+        return;
+    }
+    if (load.stalled || (load.load <= cm->a[hm.axis].stall_threshold)) {
+        hm.stall_seeking = false;
+        hm.stalled = true;
+        en_take_encoder_snapshot();
+        cm_request_feedhold(FEEDHOLD_TYPE_SKIP, FEEDHOLD_EXIT_RESET_POSITION);
+    }
+}
+
+/***********************************************************************************
+ * cm_homing_stall_calibration_start() - start recording free-running load readings for an axis
+ * cm_homing_stall_calibration_end()   - stop, and set the axis' stall threshold from the readings
+ * cm_homing_stall_calibration_value() - the lowest reading recorded for the axis, or 0
+ * _homing_stall_calibrate()           - main loop part - record a new reading if the axis is at speed
+ *
+ *  Only readings taken once the axis is close to its search velocity are recorded, using
+ *  the same test as _homing_stall_check(). Readings on the accel and decel ramps are
+ *  lower than at cruise, and would set a threshold the search never reaches.
+ */
+stat_t cm_homing_stall_calibration_start(const uint8_t axis) {
+    stLoad_t load;
+    if (!st_get_axis_load(axis, load)) {
+        return (STAT_HOMING_ERROR_NO_STALL_DETECTION);
+    }
+    if (fp_ZERO(cm->a[axis].search_velocity)) {
+        return (STAT_HOMING_ERROR_ZERO_SEARCH_VELOCITY);
+    }
+    hm.cal_axis = axis;
+    hm.cal_velocity = std::abs(cm->a[axis].search_velocity);
+    hm.cal_samples = load.samples;
+    hm.cal_readings = 0;
+    hm.cal_min = UINT16_MAX;
+    hm.cal_active = true;
+    return (STAT_OK);
+}
+
+stat_t cm_homing_stall_calibration_end(const uint8_t axis) {
+    if (!hm.cal_active || (hm.cal_axis != axis)) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    hm.cal_active = false;
+    if (hm.cal_readings == 0) {                                 // the axis never reached search velocity
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    cm->a[axis].stall_threshold = std::max((int32_t)1, (int32_t)(hm.cal_min * HOMING_STALL_CALIBRATION_FACTOR));
+    return (STAT_OK);
+}
+
+int32_t cm_homing_stall_calibration_value(const uint8_t axis) {
+    if ((hm.cal_axis != axis) || (hm.cal_readings == 0)) {
+        return (0);
+    }
+    return (hm.cal_min);
+}
+
+static void _homing_stall_calibrate() {
+    stLoad_t load;
+    if (!st_get_axis_load(hm.cal_axis, load) || (load.samples == hm.cal_samples)) {
+        return;
+    }
+    hm.cal_samples = load.samples;
+    if (load.standstill || (mp_get_runtime_velocity() < hm.cal_velocity * HOMING_STALL_ARM_FRACTION)) {
+        return;
+    }
+    hm.cal_min = std::min(hm.cal_min, load.load);
+    hm.cal_readings++;
+}
+
+/***********************************************************************************
+ * Simultaneous homing ($hms=1) - these execute once for the whole group of axes
+ ***********************************************************************************/
+
+/***********************************************************************************
+ * _homing_group_init() - collect the group, initialize variables, call the clear
+ *
+ *  Starts with the axis passed in and takes every later axis flagged for homing,
+ *  except those that share a homing input with an axis already in the group.
+ */
+static stat_t _homing_group_init(int8_t axis) {
+
+    hm.axis = axis;                                             // the sequence continues from here after the group
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        hm.group[a] = false;
+        hm.seeking[a] = false;
+        hm.failed[a] = false;
+    }
+    for (int8_t a = axis; a >= 0; a = _get_next_axis(a)) {
+        bool shared = false;
+        for (uint8_t g = AXIS_X; g < AXES; g++) {
+            if (hm.group[g] && (cm->a[g].homing_input == cm->a[a].homing_input)) {
+                shared = true;
+            }
+        }
+        if (shared || (cm->a[a].stall_threshold > 0)) {
+            continue;                                           // homed on its own after the group
+        }
+        cm->homed[a] = false;
+        stat_t status = _homing_axis_params(a, &hm.ap[a]);
+        if (status != STAT_OK) {
+            return (_homing_error_exit(a, status));
+        }
+        hm.group[a] = true;
+    }
+    hm.group_active = true;
+    din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_homing_handler);
+    return (_set_homing_func(_homing_group_clear_init));
+}
+
+/***********************************************************************************
+ * _homing_group_clear_init() - back off any group switches that are thrown at the start
+ *
+ *  NOTE: like _homing_axis_clear_init() this relies on independent switches per axis
+ */
+static stat_t _homing_group_clear_init(int8_t axis) {
+    float travel[]   = INIT_AXES_ZEROES;
+    bool  flags[]    = INIT_AXES_ZEROES;
+    float velocity[] = INIT_AXES_ZEROES;
+    bool  clear = false;
+
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (!hm.group[a] || (gpio_read_input(cm->a[a].homing_input) != INPUT_ACTIVE)) {
+            continue;
+        }
+        for (uint8_t check_axis = AXIS_X; check_axis < AXES; check_axis++) {
+            if (a != check_axis && cm->a[check_axis].homing_input == cm->a[a].homing_input) {
+                return (_homing_error_exit(a, STAT_HOMING_ERROR_MUST_CLEAR_SWITCHES_BEFORE_HOMING));
+            }
+        }
+        travel[a]   = -hm.ap[a].latch_backoff;
+        flags[a]    = true;
+        velocity[a] = hm.ap[a].search_velocity;
+        clear = true;
+    }
+    if (clear) {
+        _set_homing_func(_homing_group_search_start);
+        return (_homing_group_move(travel, flags, velocity, false));
+    }
+    return (_set_homing_func(_homing_group_search_start));
+}
+
+/***********************************************************************************
+ * _homing_group_search_start() - fast search for all switches in the group
+ * _homing_group_search()       - continue the search for axes that have not found their switch
+ */
+static stat_t _homing_group_search_start(int8_t axis) {
+    _homing_group_seek_init(false);
+    return (_homing_group_search(axis));
+}
+
+static stat_t _homing_group_search(int8_t axis) {
+    _set_homing_func(_homing_group_search);
+    stat_t status = _homing_group_seek(false);
+    if (status == STAT_OK) {                                    // every axis has found its switch or failed
+        return (_set_homing_func(_homing_group_clear));
+    }
+    return (status);
+}
+
+/***********************************************************************************
+ * _homing_group_clear() - clear all axes off their switches
+ */
+static stat_t _homing_group_clear(int8_t axis) {
+    float travel[]   = INIT_AXES_ZEROES;
+    bool  flags[]    = INIT_AXES_ZEROES;
+    float velocity[] = INIT_AXES_ZEROES;
+    bool  clear = false;
+
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (hm.group[a] && !hm.failed[a]) {
+            travel[a]   = -hm.ap[a].latch_backoff;
+            flags[a]    = true;
+            velocity[a] = hm.ap[a].search_velocity;
+            clear = true;
+        }
+    }
+    if (!clear) {                                               // every axis in the group failed
+        return (_set_homing_func(_homing_group_set_position));
+    }
+    _set_homing_func(_homing_group_latch_start);
+    return (_homing_group_move(travel, flags, velocity, false));
+}
+
+/***********************************************************************************
+ * _homing_group_latch_start() - slow drive until all switches close again
+ * _homing_group_latch()       - continue the latch for axes that have not found their switch
+ */
+static stat_t _homing_group_latch_start(int8_t axis) {
+    _homing_group_seek_init(true);
+    return (_homing_group_latch(axis));
+}
+
+static stat_t _homing_group_latch(int8_t axis) {
+    _set_homing_func(_homing_group_latch);
+    stat_t status = _homing_group_seek(true);
+    if (status == STAT_OK) {
+        return (_set_homing_func(_homing_group_setpoint_backoff));
+    }
+    return (status);
+}
+
+/***********************************************************************************
+ * _homing_group_setpoint_backoff() - backoff all axes to their zero or max setpoint positions
+ */
+static stat_t _homing_group_setpoint_backoff(int8_t axis) {
+    float travel[]   = INIT_AXES_ZEROES;
+    bool  flags[]    = INIT_AXES_ZEROES;
+    float velocity[] = INIT_AXES_ZEROES;
+    bool  backoff = false;
+
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (hm.group[a] && !hm.failed[a] && !fp_ZERO(hm.ap[a].zero_backoff)) {
+            travel[a]   = hm.ap[a].zero_backoff;
+            flags[a]    = true;
+            velocity[a] = hm.ap[a].search_velocity;
+            backoff = true;
+        }
+    }
+    _set_homing_func(_homing_group_set_position);
+    if (backoff) {
+        return (_homing_group_move(travel, flags, velocity, false));
+    }
+    return (STAT_EAGAIN);
+}
+
+/***********************************************************************************
+ * _homing_group_set_position() - set zero / max for the axes that homed
+ * _homing_group_failures()     - append the group axes that didn't home to msg
+ *
+ *  Failed axes are left unhomed and reported when the cycle ends, so the axes left out
+ *  of the group are still homed.
+ */
+static stat_t _homing_group_set_position(int8_t axis) {
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (!hm.group[a]) {
+            continue;
+        }
+        if (!hm.failed[a]) {
+            cm_set_position_by_axis(a, hm.ap[a].setpoint);
+            cm->homed[a] = true;
+        }
+        hm.axis_flags[a] = false;                               // done - don't home it again
+    }
+    hm.group_active = false;
+    hm.group_done = true;
+    din_handlers[INPUT_ACTION_INTERNAL].deregisterHandler(&_homing_handler);
+
+    return (_set_homing_func(_homing_axis_start));              // home any axes left out of the group
+}
+
+static void _homing_group_failures(char *msg) {
+    char failed_axes[AXES+1];
+    uint8_t failed = 0;
+
+    if (!hm.group_done) {
+        return;
+    }
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (hm.group[a] && hm.failed[a]) {
+            failed_axes[failed++] = cm_get_axis_char(a);
+        }
+    }
+    failed_axes[failed] = 0;
+    if (failed) {
+        size_t len = strlen(msg);
+        snprintf(msg + len, NV_MESSAGE_LEN - len, "%s%s axis %s", (len ? ", " : ""), failed_axes,
+                 get_status_message(STAT_HOMING_ERROR_SWITCH_NOT_FOUND));
+    }
+}
+
+/***********************************************************************************
+ * _homing_group_seek_init() - start a search or latch phase for all group axes still in play
+ * _homing_group_seek()      - queue the next move of the phase, or return STAT_OK when it's done
+ *
+ *  After each move the travel actually made (from the runtime position) is taken off each
+ *  axis' remaining travel. Axes whose switch fired drop out; the rest carry on.
+ */
+static void _homing_group_seek_init(const bool latch) {
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        hm.seeking[a] = hm.group[a] && !hm.failed[a];
+        hm.hit[a] = false;
+        hm.remaining[a] = latch ? hm.ap[a].latch_backoff : hm.ap[a].search_travel;
+        hm.start[a] = cm_get_absolute_position(RUNTIME, a);
+    }
+}
+
+static stat_t _homing_group_seek(const bool latch) {
+    float travel[]   = INIT_AXES_ZEROES;
+    bool  flags[]    = INIT_AXES_ZEROES;
+    float velocity[] = INIT_AXES_ZEROES;
+    bool  seek = false;
+
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (!hm.seeking[a]) {
+            continue;
+        }
+        hm.remaining[a] -= cm_get_absolute_position(RUNTIME, a) - hm.start[a];
+        if (hm.hit[a]) {                                        // found the switch
+            hm.seeking[a] = false;
+            continue;
+        }
+        float planned = latch ? hm.ap[a].latch_backoff : hm.ap[a].search_travel;
+        if ((std::abs(hm.remaining[a]) < EPSILON) || ((hm.remaining[a] * planned) < 0)) {
+            hm.seeking[a] = false;                              // out of travel: a missed latch is
+            hm.failed[a] = !latch;                              // ...tolerated as in axis-by-axis homing
+            continue;
+        }
+        travel[a]   = hm.remaining[a];
+        flags[a]    = true;
+        velocity[a] = latch ? hm.ap[a].latch_velocity : hm.ap[a].search_velocity;
+        seek = true;
+    }
+    if (!seek) {
+        return (STAT_OK);
+    }
+    return (_homing_group_move(travel, flags, velocity, true));
+}
+
+/***********************************************************************************
+ * _homing_group_move() - helper that executes a move of several axes, each at its own velocity
+ *
+ *  A seek move lasts until the first axis would run out of travel, so every axis moves
+ *  at its own velocity for the whole move. Other moves run every axis to its target and
+ *  take as long as the slowest axis needs.
+ */
+static stat_t _homing_group_move(const float travel[], const bool flags[], const float velocity[], const bool seek) {
+    float vect[] = INIT_AXES_ZEROES;
+    float zero[] = INIT_AXES_ZEROES;
+    float time = 0;                                             // minutes
+
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (flags[a]) {
+            float axis_time = std::abs(travel[a]) / velocity[a];
+            if ((time == 0) || (seek ? (axis_time < time) : (axis_time > time))) {
+                time = axis_time;
+            }
+        }
+    }
+    if (fp_ZERO(time)) {                                        // nothing to move (e.g. zero latch backoff)
+        return (STAT_EAGAIN);
+    }
+    for (uint8_t a = AXIS_X; a < AXES; a++) {
+        if (flags[a]) {
+            vect[a] = seek ? std::copysign(velocity[a] * time, travel[a]) : travel[a];
+            hm.start[a] = cm_get_absolute_position(RUNTIME, a);
+            hm.hit[a] = false;
+        }
+    }
+
+    hm.waiting_for_motion_end = true;
+    cm_set_feed_rate_mm(get_axis_vector_length(vect, zero) / time);
+
+    stat_t status = cm_straight_feed_mm(vect, flags, PROFILE_FAST);
+    if (status != STAT_OK) {
+        rpt_exception(status, "Homing move failed. Check min/max settings");
+        return (_homing_error_exit(hm.axis, STAT_HOMING_CYCLE_FAILED));
+    }
+    mp_queue_command(_homing_axis_move_callback, nullptr, nullptr);
+    return (STAT_EAGAIN);
+}
+
 
 /***********************************************************************************
  * _homing_error_exit()
@@ -447,6 +999,7 @@ static stat_t _homing_error_exit(int8_t axis, stat_t status) {
     } else {
         char msg[NV_MESSAGE_LEN];
         sprintf(msg, "%c axis %s", cm_get_axis_char(axis), get_status_message(status));
+        _homing_group_failures(msg);        // group axes that failed before this one
         nv_add_conditional_message(msg);
     }
     nv_print_list(STAT_HOMING_CYCLE_FAILED, TEXT_MULTILINE_FORMATTED, JSON_RESPONSE_FORMAT);
@@ -467,6 +1020,11 @@ static stat_t _homing_finalize_exit(int8_t axis)  // third part of return to hom
     cm_set_feed_rate_mode(hm.saved_feed_rate_mode);
     cm_set_motion_mode(MODEL, MOTION_MODE_CANCEL_MOTION_MODE);
     cm_canned_cycle_end();
+    hm.group_active = false;
+    if (hm.stall_seeking) {
+        hm.stall_seeking = false;
+        st_set_axis_stall_output(hm.axis, false);
+    }
 
     // This is idempotent - if it's not there, no worries
     din_handlers[INPUT_ACTION_INTERNAL].deregisterHandler(&_homing_handler);  // end homing mode
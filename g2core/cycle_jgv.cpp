@@ -31,6 +31,19 @@
 // Internally everything is in mm/min. Cycle stays active until all targets are zero
 // AND motion has ramped to a stop, the watchdog fires, or an alarm/queue-flush
 // kills it. See docs/velocity_jog_design.md for the full design rationale.
+//
+// There are two ways to run the cycle, selected by $jgvmd and latched on cycle entry:
+//
+//   JGV_MODE_QUEUED - cm_jgv_callback() streams short G1 segments into the planner. Safe and
+//                     smooth, but a direction change waits behind the queued segments.
+//   JGV_MODE_DIRECT - the planner is bypassed. mp_exec_move() offers cm_jgv_exec() the runtime
+//                     whenever the planner is empty, and it preps one jerk-limited segment at a
+//                     time straight from v_target. A new target reaches the steppers in the next
+//                     segment, so input-to-motion latency is a segment or two, not the queue.
+//                     Not used while a tram (rotation) is active - the cycle runs queued then.
+//
+// Either way the latency of each target change (host message to the first segment carrying it
+// starting to run) is measured and reported as $jgvlt (last) and $jgvlx (worst this cycle).
 
 #include "g2core.h"
 #include "config.h"
@@ -38,6 +51,8 @@
 #include "text_parser.h"
 #include "canonical_machine.h"
 #include "planner.h"
+#include "kinematics.h"
+#include "stepper.h"
 #include "util.h"
 #include "report.h"
 #include "xio.h"
@@ -48,6 +63,7 @@
 #define JGV_RAMP_TIME_S        0.25f     // 0→velocity_max ramp time, sets accel_max per axis
 #define JGV_WATCHDOG_DEFAULT   500       // ms of host silence before auto-stop
 #define JGV_STOP_EPSILON       0.01f     // mm/min — below this we treat velocity as zero (slower than this isn't useful jogging)
+#define JGV_DIRECT_SEGMENT_MS  NOM_SEGMENT_MS  // direct runtime segment duration in ms - same as a planned move's segments
 
 struct jgvSingleton {
     bool      active;                   // true while CYCLE_JGV is running
@@ -68,6 +84,19 @@ struct jgvSingleton {
     uint8_t   saved_feed_rate_mode;
     uint8_t   saved_path_control;
     float     saved_feed_rate;
+
+    // direct runtime (JGV_MODE_DIRECT). v_current, a_current and moving are owned by the exec
+    // interrupt while the cycle is direct; the main loop only reads them.
+    uint8_t   mode;                     // $jgvmd - mode used by the next cycle
+    bool      direct;                   // mode latched for the running cycle
+    bool      moving;                   // true while cm_jgv_exec() is prepping segments
+    float     a_current[AXES];          // per-axis acceleration (mm/min^2, signed)
+
+    // latency measurement
+    bool      input_pending;            // a target change has not reached the steppers yet
+    uint32_t  input_time;               // SysTick ms of that target change
+    float     latency_ms;               // input-to-motion latency of the last target change ($jgvlt)
+    float     latency_max_ms;           // worst latency since the cycle was entered ($jgvlx)
 };
 static struct jgvSingleton jgv = {
     .active = false,
@@ -83,6 +112,14 @@ static struct jgvSingleton jgv = {
     .saved_feed_rate_mode = 0,
     .saved_path_control = 0,
     .saved_feed_rate = 0,
+    .mode = JGV_MODE_DIRECT,
+    .direct = false,
+    .moving = false,
+    .a_current = {0},
+    .input_pending = false,
+    .input_time = 0,
+    .latency_ms = 0,
+    .latency_max_ms = 0,
 };
 
 static void   _jgv_enter_cycle(void);
@@ -91,6 +128,11 @@ static bool   _jgv_all_targets_zero(void);
 static bool   _jgv_all_current_zero(void);
 static float  _jgv_accel_max(uint8_t axis);
 static void   _jgv_apply_axis_softlimit(uint8_t axis, float planned_pos);
+static bool   _jgv_softlimit_enabled(uint8_t axis);
+static float  _jgv_softlimit_velocity(uint8_t axis, float pos, float v_cur, float v_tgt, float accel_max);
+static float  _jgv_jerk_limited_velocity(uint8_t axis, float v_cur, float v_tgt, float accel_max, float segment_time);
+static void   _jgv_record_latency(float lead_ms);
+static void   _jgv_sync_position(void);
 
 /*****************************************************************************
  * cm_set_jgv() - JSON setter for {"jgvx":N}, {"jgvy":N}, etc.
@@ -135,6 +177,13 @@ stat_t cm_set_jgv(nvObj_t *nv)
     if (v_canonical >  vmax) v_canonical =  vmax;
     if (v_canonical < -vmax) v_canonical = -vmax;
 
+    // Start the latency clock on a real change. Repeats of the same target (host keep-alives)
+    // don't count, and a change that lands before the last one reached the steppers is
+    // measured from the earlier one.
+    if (!jgv.input_pending && fabsf(v_canonical - jgv.v_target[axis]) > JGV_STOP_EPSILON) {
+        jgv.input_time = SysTickTimer.getValue();
+        jgv.input_pending = true;
+    }
     jgv.v_target[axis] = v_canonical;
     jgv.last_msg_time  = SysTickTimer.getValue();
     jgv.watchdog_tripped = false;        // any new message clears the watchdog flag
@@ -174,6 +223,11 @@ stat_t cm_set_jgv(nvObj_t *nv)
         _jgv_enter_cycle();
     }
 
+    // The direct runtime stops asking for exec interrupts when it comes to rest, so wake it
+    // up. If it's already running this just preps the next segment a little early.
+    if (jgv.active && jgv.direct) {
+        st_request_exec_move();
+    }
     return (STAT_OK);
 }
 
@@ -191,6 +245,18 @@ stat_t cm_set_jgvto(nvObj_t *nv)
     return (STAT_OK);
 }
 
+/*****************************************************************************
+ * cm_get_jgvmd() / cm_set_jgvmd() - runtime mode, takes effect on the next cycle
+ * cm_get_jgvlt() / cm_get_jgvlx() - last and worst input-to-motion latency (ms)
+ * cm_jgv_direct_active()         - true while a direct-runtime cycle owns the runtime
+ */
+stat_t cm_get_jgvmd(nvObj_t *nv) { return (get_integer(nv, jgv.mode)); }
+stat_t cm_set_jgvmd(nvObj_t *nv) { return (set_integer(nv, jgv.mode, JGV_MODE_QUEUED, JGV_MODE_DIRECT)); }
+stat_t cm_get_jgvlt(nvObj_t *nv) { return (get_float(nv, jgv.latency_ms)); }
+stat_t cm_get_jgvlx(nvObj_t *nv) { return (get_float(nv, jgv.latency_max_ms)); }
+
+bool cm_jgv_direct_active(void) { return (jgv.active && jgv.direct); }
+
 /*****************************************************************************
  * cm_jgv_abort() - external abort
  *
@@ -228,6 +294,9 @@ stat_t cm_jgv_callback(void)
     // restarting the cycle. Detect the desync and reset state so the next
     // {"jgvx":...} can re-enter cleanly.
     if (cm->cycle_type != CYCLE_JGV) {
+        if (jgv.direct) {
+            _jgv_sync_position();       // cm_jgv_exec() has already stopped prepping segments
+        }
         jgv.active = false;
         for (uint8_t a = 0; a < AXES; a++) {
             jgv.v_target[a]  = 0;
@@ -255,10 +324,40 @@ stat_t cm_jgv_callback(void)
             jgv.v_target[a]  = 0;
             jgv.v_current[a] = 0;
         }
+        if (jgv.direct && (jgv.moving || st_runtime_isbusy())) {
+            return (STAT_EAGAIN);       // let the segment in the steppers finish so the position is settled
+        }
         _jgv_finalize_exit();
         return (STAT_OK);
     }
 
+    // The direct runtime does the motion from the exec interrupt. All that's left to do
+    // here is to finish feedholds and the cycle exit once the steppers have come to rest,
+    // and to restart the runtime when there's something to do after a hold.
+    if (jgv.direct) {
+        if (jgv.moving || st_runtime_isbusy()) {
+            return (STAT_EAGAIN);
+        }
+        if (cm->hold_state != FEEDHOLD_OFF) {
+            // The planner is empty, so _exec_aline_feedhold() never sees this hold. The
+            // runtime has already ramped to zero (cm_jgv_exec), so declare it stopped.
+            if (cm->hold_state < FEEDHOLD_MOTION_STOPPED) {
+                _jgv_sync_position();
+                cm_set_motion_state(MOTION_STOP);
+                cm->hold_state = FEEDHOLD_MOTION_STOPPED;
+                cm->hold_stats.request_time = 0;
+                sr_request_status_report(SR_REQUEST_IMMEDIATE);
+            }
+            return (STAT_EAGAIN);
+        }
+        if (_jgv_all_targets_zero()) {
+            _jgv_finalize_exit();
+            return (STAT_OK);
+        }
+        st_request_exec_move();         // e.g. resumed from a hold with targets still set
+        return (STAT_EAGAIN);
+    }
+
     // Exit condition: all targets zero AND no residual velocity AND planner is
     // drained. The runtime busy check mirrors cm_jogging_cycle_callback's exit
     // handshake — we don't tear down state until queued motion has played out.
@@ -274,6 +373,7 @@ stat_t cm_jgv_callback(void)
     if (mp_planner_is_full(mp)) {
         return (STAT_EAGAIN);
     }
+    uint8_t queued = (uint8_t)(mp->q.queue_size - mp_get_planner_buffers(mp));
 
     // Two-mode throttling. While the planner is still in PLANNER_STARTUP we
     // need spacing > BLOCK_TIMEOUT_MS (30 ms) between commits so the
@@ -296,7 +396,6 @@ stat_t cm_jgv_callback(void)
             return (STAT_EAGAIN);
         }
     } else {
-        uint8_t queued = (uint8_t)(mp->q.queue_size - mp_get_planner_buffers(mp));
         if (queued >= JGV_TARGET_QUEUE_DEPTH) {
             return (STAT_EAGAIN);
         }
@@ -382,6 +481,15 @@ stat_t cm_jgv_callback(void)
         jgv.v_current[a]  = v_end[a];
         jgv.planned_pos[a] = target_pos[a];
     }
+    // This segment starts once the ones queued ahead of it have played out. They're
+    // all about JGV_SEGMENT_TIME_MS long, which is close enough for the estimate. A
+    // planner that's still starting up also waits out its block timeout first.
+    float lead_ms = queued * JGV_SEGMENT_TIME_MS;
+    if (mp->planner_state == PLANNER_STARTUP || mp->planner_state == PLANNER_IDLE) {
+        lead_ms += BLOCK_TIMEOUT_MS;
+    }
+    _jgv_record_latency(lead_ms);
+
     // Set the STARTUP-mode pace. Once the planner moves past STARTUP the
     // depth-based gate takes over and this timestamp is ignored.
     jgv.next_commit_time = SysTickTimer.getValue() + JGV_STARTUP_PACE_MS;
@@ -389,6 +497,126 @@ stat_t cm_jgv_callback(void)
     return (STAT_EAGAIN);               // stay in the cycle
 }
 
+/*****************************************************************************
+ * cm_jgv_exec() - direct runtime: prep the next segment straight from v_target
+ *
+ * Called from mp_exec_move() (exec interrupt) when the planner has nothing to run.
+ * Returns true if a segment was prepped, false if there's nothing to move - in which
+ * case the caller preps a null and the exec interrupt goes quiet until cm_set_jgv()
+ * or cm_jgv_callback() requests it again.
+ *
+ * Each axis runs its own jerk-limited velocity profile towards its target, the same
+ * way kinematics idle tasks drive joints. The segment is one NOM_SEGMENT_MS long, and
+ * it's prepped while the previous one runs, so a target change set by the host shows
+ * up in motion within two segments. Feedholds and soft limits are handled here too,
+ * since nothing goes through the planner: a hold ramps every axis to zero (the main
+ * loop callback then completes it), and an axis approaching a soft limit is ramped to
+ * a stop at the envelope.
+ */
+bool cm_jgv_exec(void)
+{
+    if (!jgv.active || !jgv.direct || (cm != &cm1) || (cm->cycle_type != CYCLE_JGV)) {
+        return (false);
+    }
+    if (cm->machine_state != MACHINE_CYCLE) {   // alarm, shutdown or panic - stop dead
+        for (uint8_t a = 0; a < AXES; a++) {
+            jgv.v_current[a] = 0;
+            jgv.a_current[a] = 0;
+        }
+        jgv.moving = false;
+        return (false);
+    }
+
+    const float segment_time = JGV_DIRECT_SEGMENT_MS / 60000.0f;
+    const bool  hold = (cm->hold_state != FEEDHOLD_OFF);
+
+    float v_end[AXES];
+    float target[AXES];
+    float v_start_sq = 0;
+    float v_end_sq = 0;
+    bool  moving = false;
+
+    for (uint8_t a = 0; a < AXES; a++) {
+        float v_cur = jgv.v_current[a];
+        float pos = mr->position[a];
+        float accel_max = _jgv_accel_max(a);
+
+        if (accel_max <= 0) {                   // disabled axis
+            v_end[a] = 0;
+            jgv.a_current[a] = 0;
+            target[a] = pos;
+            continue;
+        }
+        float v_tgt = _jgv_softlimit_velocity(a, pos, v_cur, (hold ? 0 : jgv.v_target[a]), accel_max);
+        v_end[a] = _jgv_jerk_limited_velocity(a, v_cur, v_tgt, accel_max, segment_time);
+        if (fabsf(v_end[a]) < JGV_STOP_EPSILON && fabsf(v_tgt) < JGV_STOP_EPSILON) {
+            v_end[a] = 0;
+            jgv.a_current[a] = 0;
+        }
+        target[a] = pos + (v_cur + v_end[a]) * 0.5f * segment_time;
+
+        // last resort - if the ramp couldn't stop in time, stop on the envelope
+        if (_jgv_softlimit_enabled(a)) {
+            if (target[a] > cm->a[a].travel_max) {
+                target[a] = fmaxf(pos, cm->a[a].travel_max);
+                v_end[a] = 0;
+                jgv.a_current[a] = 0;
+            } else if (target[a] < cm->a[a].travel_min) {
+                target[a] = fminf(pos, cm->a[a].travel_min);
+                v_end[a] = 0;
+                jgv.a_current[a] = 0;
+            }
+        }
+        if ((fabsf(v_cur) > JGV_STOP_EPSILON) || (fabsf(v_end[a]) > JGV_STOP_EPSILON)) {
+            moving = true;
+        }
+        v_start_sq += v_cur * v_cur;
+        v_end_sq += v_end[a] * v_end[a];
+    }
+
+    if (!moving) {
+        for (uint8_t a = 0; a < AXES; a++) {
+            jgv.v_current[a] = 0;
+            jgv.a_current[a] = 0;
+        }
+        mr->segment_velocity = 0;
+        jgv.moving = false;
+        return (false);
+    }
+
+    // No block has handed the runtime a gcode state, so give it the model's for reporting
+    // (units, coordinate system), as the planner would have done.
+    if (!jgv.moving) {
+        mr->gm = cm->gm;
+    }
+
+    // Motors the kinematics doesn't map keep their current target (no travel)
+    float target_steps[MOTORS];
+    for (uint8_t m = 0; m < MOTORS; m++) {
+        target_steps[m] = mr->target_steps[m];
+    }
+    mr->segment_velocity = sqrtf(v_start_sq);   // st_prep_line ramps between these; also reported as vel
+    mr->target_velocity = sqrtf(v_end_sq);
+    mr->segment_time = segment_time;
+    mp_inverse_kinematics(mr->gm, target, mr->position, mr->segment_velocity, mr->target_velocity, segment_time, target_steps);
+    if (mp_set_target_steps(target_steps) != STAT_OK) {
+        jgv.moving = false;
+        return (false);
+    }
+    copy_vector(mr->position, target);
+    for (uint8_t a = 0; a < AXES; a++) {
+        jgv.v_current[a] = v_end[a];
+    }
+    jgv.moving = true;
+    if (cm->motion_state != MOTION_RUN) {
+        cm_set_motion_state(MOTION_RUN);
+    }
+    if (!hold) {
+        _jgv_record_latency(JGV_DIRECT_SEGMENT_MS);     // starts when the running segment ends
+    }
+    return (true);
+}
+
 /*****************************************************************************
  * internal helpers
  */
@@ -431,6 +659,12 @@ static void _jgv_enter_cycle(void)
         jgv.planned_pos[a] = pos;
         mp_set_planner_position(a, pos);
     }
+    for (uint8_t a = 0; a < AXES; a++) {
+        jgv.a_current[a] = 0;
+    }
+    jgv.direct               = (jgv.mode == JGV_MODE_DIRECT) && !cm->rotation_active;    // see _jgv_sync_position()
+    jgv.moving               = false;
+    jgv.latency_max_ms       = 0;
     jgv.watchdog_tripped     = false;
     jgv.hard_stop_requested  = false;
     jgv.next_commit_time     = 0;          // commit immediately on entry
@@ -443,6 +677,9 @@ static void _jgv_enter_cycle(void)
 
 static void _jgv_finalize_exit(void)
 {
+    if (jgv.direct) {
+        _jgv_sync_position();           // the planner and model never saw the direct runtime's motion
+    }
     cm_set_absolute_override(MODEL, ABSOLUTE_OVERRIDE_OFF);
     cm_set_distance_mode(jgv.saved_distance_mode);
     cm_set_path_control(MODEL, jgv.saved_path_control);
@@ -452,9 +689,12 @@ static void _jgv_finalize_exit(void)
     cm_canned_cycle_end();
 
     jgv.active = false;
+    jgv.moving = false;
+    jgv.input_pending = false;
     for (uint8_t a = 0; a < AXES; a++) {
         jgv.v_target[a]  = 0;
         jgv.v_current[a] = 0;
+        jgv.a_current[a] = 0;
     }
     xio_writeline("{\"jgv\":0}\n");     // notify host that cycle has exited
 }
@@ -506,3 +746,90 @@ static void _jgv_apply_axis_softlimit(uint8_t axis, float planned_pos)
     // simpler approach is: pushing into an X limit briefly stalls Y too,
     // recovering as soon as the host reduces X command.
 }
+
+// Soft limits apply to an axis under the same conditions cm_test_soft_limits() uses.
+static bool _jgv_softlimit_enabled(uint8_t axis)
+{
+    if (!cm->soft_limit_enable || !cm->homed[axis]) { return (false); }
+    if (fp_EQ(cm->a[axis].travel_min, cm->a[axis].travel_max)) { return (false); }
+    if (fabs(cm->a[axis].travel_min) > DISABLE_SOFT_LIMIT) { return (false); }
+    if (fabs(cm->a[axis].travel_max) > DISABLE_SOFT_LIMIT) { return (false); }
+    return (true);
+}
+
+// Direct runtime: the target velocity for an axis, zeroed if the axis is headed into a
+// soft limit and is within stopping distance of it. The stopping distance is that of a
+// constant-acceleration ramp plus the distance covered while the jerk builds the
+// acceleration up, which is conservative for the profile _jgv_jerk_limited_velocity runs.
+static float _jgv_softlimit_velocity(uint8_t axis, float pos, float v_cur, float v_tgt, float accel_max)
+{
+    if (!_jgv_softlimit_enabled(axis)) { return (v_tgt); }
+
+    float jerk = cm->a[axis].jerk_max * JERK_MULTIPLIER;
+    float stop = (v_cur * v_cur) / (2 * accel_max);
+    if (jerk > 0) { stop += fabsf(v_cur) * accel_max / jerk; }
+
+    if (v_tgt > 0) {
+        float reach = pos + ((v_cur > 0) ? stop : 0);
+        if (reach >= cm->a[axis].travel_max) { return (0); }
+    } else if (v_tgt < 0) {
+        float reach = pos - ((v_cur < 0) ? stop : 0);
+        if (reach <= cm->a[axis].travel_min) { return (0); }
+    }
+    return (v_tgt);
+}
+
+// Direct runtime: advance one axis's velocity by one segment towards v_tgt with limited
+// jerk. The acceleration is steered towards the most that can still be ramped back out
+// by the time v_tgt is reached (a^2 / 2j = dv), capped at accel_max, and moves towards
+// it by at most jerk * segment_time per segment. Updates jgv.a_current[axis] and returns
+// the velocity at the end of the segment.
+static float _jgv_jerk_limited_velocity(uint8_t axis, float v_cur, float v_tgt, float accel_max, float segment_time)
+{
+    float jerk = cm->a[axis].jerk_max * JERK_MULTIPLIER;
+    float accel = jgv.a_current[axis];
+    float dv = v_tgt - v_cur;
+
+    float a_want = fminf(accel_max, sqrtf(2 * jerk * fabsf(dv)));
+    if (dv < 0) { a_want = -a_want; }
+
+    float da = a_want - accel;
+    float da_max = jerk * segment_time;
+    if (da >  da_max) { da =  da_max; }
+    if (da < -da_max) { da = -da_max; }
+    accel += da;
+
+    float v_end = v_cur + accel * segment_time;
+    if ((v_tgt - v_end) * dv <= 0) {            // reached (or would pass) the target
+        v_end = v_tgt;
+        accel = 0;
+    }
+    jgv.a_current[axis] = accel;
+    return (v_end);
+}
+
+// Close out a latency measurement. lead_ms is how long the segment that carries the change
+// waits before it starts to run.
+static void _jgv_record_latency(float lead_ms)
+{
+    if (!jgv.input_pending) { return; }
+    jgv.input_pending = false;
+    jgv.latency_ms = (float)(SysTickTimer.getValue() - jgv.input_time) + lead_ms;
+    if (jgv.latency_ms > jgv.latency_max_ms) {
+        jgv.latency_max_ms = jgv.latency_ms;
+    }
+}
+
+// The direct runtime moves mr->position without the planner or the gcode model knowing.
+// Bring them up to date once the steppers have stopped. The planner works in the same
+// (trammed) frame as the runtime, the model doesn't - it gets the runtime position rotated
+// back, the same way it's reported. The direct runtime itself jogs in the runtime frame and
+// checks soft limits there, so it isn't used while a tram is active (queued mode instead).
+static void _jgv_sync_position(void)
+{
+    copy_vector(mp->position, mr->position);
+    for (uint8_t a = 0; a < AXES; a++) {
+        cm->gmx.position[a] = mp_get_runtime_display_position(a) + mr->gm.display_offset[a];
+    }
+    copy_vector(cm->gm.target, cm->gmx.position);
+}
@@ -56,6 +56,7 @@ struct pbProbingSingleton {             // persistent probing runtime variables
     bool alarm_flag;                    // true if failure triggers alarm       (true for G38.2 and G38.4)
     bool waiting_for_motion_complete;   // true if waiting for a motion to complete
     bool probe_tripped;                 // record if we saw the probe tripped (in case it bounces)
+    bool seeking;                       // true while a probe move is running (retracts ignore the input)
     stat_t (*func)();                   // binding for callback function state machine
 
     // saved gcode model state
@@ -64,6 +65,32 @@ struct pbProbingSingleton {             // persistent probing runtime variables
 };
 static struct pbProbingSingleton pb;
 
+struct pbGridSingleton {                // grid probing request and runtime variables
+
+    // request - set by {"gprb":{...}} in Gcode units and work coordinates
+    float x0, y0;                       // first corner of the grid
+    float x1, y1;                       // opposite corner of the grid
+    float z;                            // probe target level - must be below the surface
+    float clearance;                    // safe level for traverses between points
+    float feed;                         // probing feed rate
+    uint8_t nx, ny;                     // number of points along X and Y
+
+    // runtime - machine coordinates in mm
+    bool active;                        // true from cycle start until the end report is sent
+    bool valid;                         // true once results[] holds a complete grid
+    uint8_t i, j;                       // next point: i along the row, j the row
+    float origin[2];                    // XY of the first corner
+    float step[2];                      // XY spacing between points (signed)
+    float probe_z;                      // Z of the probe target
+    float clear_z;                      // Z of the clearance level
+    float feed_mm;                      // probing feed rate in mm/min
+    float z_offset;                     // work offset of Z at start, used for reporting
+    float saved_feed_rate;              // restored on exit
+    cmFeedRateMode saved_feed_rate_mode;
+    float results[PROBE_GRID_MAX * PROBE_GRID_MAX]; // contact Z, row-major from (x0,y0)
+};
+static struct pbGridSingleton pg;
+
 /**** NOTE: global prototypes and other .h info is located in canonical_machine.h ****/
 
 static stat_t _probing_start();
@@ -73,6 +100,16 @@ static stat_t _probing_exception_exit(stat_t status);
 static stat_t _probe_move(const float target[], const bool flags[]);
 static void _send_probe_report(void);
 
+static stat_t _grid_start();
+static stat_t _grid_lift();
+static stat_t _grid_traverse();
+static stat_t _grid_probe();
+static stat_t _grid_record();
+static stat_t _grid_finish();
+static stat_t _grid_exception_exit(stat_t status);
+static void _send_grid_row_report(const uint8_t row);
+static void _send_grid_end_report(void);
+
 void _prepare_for_probe();
 void _store_probe_position();
 
@@ -131,10 +168,14 @@ gpioDigitalInputHandler _probing_handler {
     [](const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
         if (cm->cycle_type != CYCLE_PROBE) { return GPIO_NOT_HANDLED; }
         if (triggering_pin_number != pb.probe_input) { return GPIO_NOT_HANDLED; }
+        if (!pb.seeking) { return GPIO_HANDLED; }   // probe released during a retract or backoff
 
-        // If the probe tripped, and the pin changes again, don't unset it! So, use |=
-        pb.probe_tripped |= (state == pb.trip_sense);
-        en_take_encoder_snapshot();
+        // If the probe tripped, and the pin changes again, don't unset it or move the
+        // captured contact point - only the first trip is the true contact
+        if (!pb.probe_tripped) {
+            en_take_encoder_snapshot();
+            pb.probe_tripped = (state == pb.trip_sense);
+        }
         cm_request_feedhold(FEEDHOLD_TYPE_SKIP, FEEDHOLD_EXIT_STOP);
 
         return GPIO_HANDLED; // DO NOT allow others to see this notice (particularly limits)
@@ -163,6 +204,8 @@ gpioDigitalInputHandler _probing_handler {
  *  encoders, then requests a "high speed" feedhold. We then run forward kinematics
  *  on the encoder snapshot to get the reported position. We also execute a move
  *  from the final position (after the feedhold) back to the point we report.
+ *  The snapshot includes the DDA phase of each motor, so the contact point is
+ *  resolved to a fraction of a step regardless of the probing feed rate.
  *
  *  Additionally, we record the last PROBES_STORED (at least 3) probe points that
  *  succeeded. The current or most recent probe (be it success, failure, or
@@ -303,8 +346,14 @@ void cm_abort_probing(cmMachine_t *_cm) {
 
     // The cycle_type may have already been changed, but if it hasn't do so now
     if (_cm->cycle_type == CYCLE_PROBE) {
-        _probing_finish();
+        if (pg.active) {
+            _grid_finish();             // reports the grid as incomplete
+        } else {
+            _probing_finish();
+        }
     }
+    pg.active = false;                  // in case we aborted before the grid cycle started
+    pb.seeking = false;
 
     // This is idempotent - if it's not there, no worries
     din_handlers[INPUT_ACTION_INTERNAL].deregisterHandler(&_probing_handler);
@@ -368,6 +417,7 @@ static uint8_t _probing_start()
     din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_probing_handler);
 
     // Everything checks out. Run the probe move
+    pb.seeking = true;
     _probe_move(pb.target, pb.flags);
     pb.func = _probing_backoff;
     return (STAT_EAGAIN);
@@ -385,10 +435,12 @@ static stat_t _probing_backoff()
     // captured from the encoder in step space to steps to mm. The encoder snapshot
     // was taken by input interrupt at the time of closure.
 
+    pb.seeking = false;
     if (pb.probe_tripped) {
         cm->probe_state[0] = PROBE_SUCCEEDED;
         float contact_position[AXES];
         kn_forward_kinematics(en_get_encoder_snapshot_vector(), contact_position);
+        contact_position[AXIS_Z] -= mp_mesh_offset(contact_position[AXIS_X], contact_position[AXIS_Y]);
         _probe_move(contact_position, pb.flags);   // NB: feed rate is the same as the probe move
     } else {
         cm->probe_state[0] = PROBE_FAILED;
@@ -406,7 +458,13 @@ static stat_t _probing_backoff()
 static void _probe_restore_settings()
 {
     din_handlers[INPUT_ACTION_INTERNAL].deregisterHandler(&_probing_handler);
+    pb.seeking = false;
 
+    if (pg.active) {                    // grid cycles set their own feed rate
+        cm->gm.feed_rate = pg.saved_feed_rate;
+        cm->gm.feed_rate_mode = pg.saved_feed_rate_mode;
+        pg.active = false;
+    }
     cm_set_absolute_override(MODEL, ABSOLUTE_OVERRIDE_OFF); // release abs override and restore work offsets
     cm_set_distance_mode(pb.saved_distance_mode);
     cm_set_soft_limits(pb.saved_soft_limits);
@@ -484,3 +542,312 @@ stat_t cm_set_prbr(nvObj_t *nv)
     cm->probe_report_enable = nv->value_int;
     return (STAT_OK);
 }
+
+/***********************************************************************************
+ **** Grid Probing Cycle ***********************************************************
+ ***********************************************************************************/
+
+/***********************************************************************************
+ * cm_probe_grid_start() - probe a rectangular grid of points without host round trips
+ *
+ *  The grid is set up and started from JSON, e.g.:
+ *
+ *    {"gprb":{"x0":0,"y0":0,"x1":200,"y1":150,"nx":20,"ny":15,"z":-5,"c":3,"f":100,"go":1}}
+ *
+ *  x0,y0 / x1,y1 are opposite corners, z is the probe target level and c is the
+ *  clearance level for traverses, all in work coordinates and current units. f is
+ *  the probing feed rate. nx and ny are the number of points along each axis
+ *  (2 to PROBE_GRID_MAX). The values are converted to machine coordinates when the
+ *  cycle starts, so the work offsets and units in effect at "go" are the ones used.
+ *
+ *  Points are visited in serpentine order. For each point the cycle lifts to the
+ *  clearance level (if below it), traverses to the point, probes down at f, and
+ *  records the contact Z using the same encoder snapshot as G38.2. The retract
+ *  to the clearance level is the lift for the next point.
+ *
+ *  Each completed row is streamed as one line, with Z in work coordinates and
+ *  current units, ordered by ascending column index (from x0 towards x1):
+ *
+ *    {"gprb":{"r":0,"z":[-0.0210,-0.0185,...]}}
+ *
+ *  and the cycle ends with {"gprb":{"e":1,"nx":20,"ny":15}}. e is 0 if the grid
+ *  is incomplete. A point that fails to make contact (or starts already tripped)
+ *  ends the cycle with e:0 and raises an alarm, the same as G38.2.
+ */
+
+stat_t cm_probe_grid_start()
+{
+    if ((cm->cycle_type == CYCLE_PROBE) || (cm->probe_state[0] == PROBE_WAITING)) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    if ((pb.probe_input = cm->probe_input) == -1) {
+        return (STAT_NO_PROBE_INPUT_CONFIGURED);
+    }
+    if ((pg.nx < 2) || (pg.nx > PROBE_GRID_MAX) || (pg.ny < 2) || (pg.ny > PROBE_GRID_MAX)) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    if (pg.feed <= 0) {
+        return (STAT_FEEDRATE_NOT_SPECIFIED);
+    }
+
+    // convert the request to machine coordinates in mm
+    pg.origin[0] = cm_get_combined_offset(AXIS_X) + _to_millimeters(pg.x0);
+    pg.origin[1] = cm_get_combined_offset(AXIS_Y) + _to_millimeters(pg.y0);
+    pg.step[0] = _to_millimeters(pg.x1 - pg.x0) / (pg.nx - 1);
+    pg.step[1] = _to_millimeters(pg.y1 - pg.y0) / (pg.ny - 1);
+    pg.z_offset = cm_get_combined_offset(AXIS_Z);
+    pg.probe_z = pg.z_offset + _to_millimeters(pg.z);
+    pg.clear_z = pg.z_offset + _to_millimeters(pg.clearance);
+    pg.feed_mm = _to_millimeters(pg.feed);
+
+    if ((pg.clear_z - pg.probe_z) < MINIMUM_PROBE_TRAVEL) {
+        return (STAT_PROBE_TRAVEL_TOO_SMALL);
+    }
+
+    // the grid measures the raw surface, so height-map compensation is turned off
+    mp_mesh_disable();
+
+    // setup - grid points are always G38.2 style probes
+    pb.alarm_flag = true;
+    pb.trip_sense = true;
+    pb.func = _grid_start;
+    pg.i = 0;
+    pg.j = 0;
+    pg.valid = false;
+    pg.active = true;
+
+    _prepare_for_probe();
+    clear_vector(cm->probe_results[0]);
+
+    // queue a function to let us know when we can start probing
+    cm->probe_state[0] = PROBE_WAITING;
+    pb.waiting_for_motion_complete = true;
+    pb.probe_tripped = false;
+    mp_queue_command(_motion_end_callback, nullptr, nullptr);
+    return (STAT_OK);
+}
+
+/***********************************************************************************
+ * _grid_move() - queue a traverse or probe move to a machine coordinate target
+ * _grid_column() - column index of the current point (rows alternate direction)
+ */
+
+static stat_t _grid_move(const uint8_t axis_mask, const float x, const float y, const float z, const bool probe)
+{
+    float target[AXES] = {0};
+    bool flags[AXES] = {false};
+    target[AXIS_X] = x; flags[AXIS_X] = (axis_mask & 0x01);
+    target[AXIS_Y] = y; flags[AXIS_Y] = (axis_mask & 0x02);
+    target[AXIS_Z] = z; flags[AXIS_Z] = (axis_mask & 0x04);
+
+    if (probe) {
+        return (_probe_move(target, flags));
+    }
+    cm_set_absolute_override(MODEL, ABSOLUTE_OVERRIDE_ON_DISPLAY_WITH_OFFSETS);
+    pb.waiting_for_motion_complete = true;
+    cm_straight_traverse_mm(target, flags, PROFILE_NORMAL);
+    mp_queue_command(_motion_end_callback, nullptr, nullptr);
+    return (STAT_EAGAIN);
+}
+
+static uint8_t _grid_column()
+{
+    return ((pg.j & 1) ? (pg.nx - 1 - pg.i) : pg.i);
+}
+
+/***********************************************************************************
+ * _grid_start()    - enter the cycle once the planner has drained
+ * _grid_lift()     - move up to the clearance level if below it
+ * _grid_traverse() - move to the XY of the next point
+ * _grid_probe()    - probe down to the target level
+ * _grid_record()   - record the contact, stream a finished row, retract
+ */
+
+static stat_t _grid_start()
+{
+    cm->probe_state[0] = PROBE_FAILED;
+    cm->machine_state = MACHINE_CYCLE;
+    cm->cycle_type = CYCLE_PROBE;
+
+    pb.saved_distance_mode = (cmDistanceMode)cm_get_distance_mode(ACTIVE_MODEL);
+    pb.saved_soft_limits = cm_get_soft_limits();
+    pg.saved_feed_rate = cm->gm.feed_rate;
+    pg.saved_feed_rate_mode = cm->gm.feed_rate_mode;
+    cm_set_soft_limits(false);
+
+    cm_set_distance_mode(ABSOLUTE_DISTANCE_MODE);
+    cm->gm.feed_rate_mode = UNITS_PER_MINUTE_MODE;
+    cm->gm.feed_rate = pg.feed_mm;
+
+    din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&_probing_handler);
+    return (_grid_lift());
+}
+
+static stat_t _grid_lift()
+{
+    pb.func = _grid_traverse;
+    if (cm->gmx.position[AXIS_Z] >= pg.clear_z) {
+        return (_grid_traverse());
+    }
+    return (_grid_move(0x04, 0, 0, pg.clear_z, false));
+}
+
+static stat_t _grid_traverse()
+{
+    pb.func = _grid_probe;
+    return (_grid_move(0x03, pg.origin[0] + pg.step[0] * _grid_column(),
+                             pg.origin[1] + pg.step[1] * pg.j, 0, false));
+}
+
+static stat_t _grid_probe()
+{
+    if (pb.trip_sense == gpio_read_input(pb.probe_input)) {
+        return (_grid_exception_exit(STAT_PROBE_IS_ALREADY_TRIPPED));
+    }
+    pb.probe_tripped = false;
+    pb.seeking = true;
+    pb.func = _grid_record;
+    return (_grid_move(0x04, 0, 0, pg.probe_z, true));
+}
+
+static stat_t _grid_record()
+{
+    pb.seeking = false;
+    if (!pb.probe_tripped) {
+        return (_grid_exception_exit(STAT_PROBE_CYCLE_FAILED));
+    }
+    kn_forward_kinematics(en_get_encoder_snapshot_vector(), cm->probe_results[0]);
+    pg.results[pg.j * pg.nx + _grid_column()] = cm->probe_results[0][AXIS_Z];
+
+    if (++pg.i == pg.nx) {
+        _send_grid_row_report(pg.j);
+        pg.i = 0;
+        pg.j++;
+    }
+    pb.func = (pg.j == pg.ny) ? _grid_finish : _grid_traverse;
+    return (_grid_move(0x04, 0, 0, pg.clear_z, false));   // retract
+}
+
+/***********************************************************************************
+ * _grid_finish()         - exit for completed and aborted grids
+ * _grid_exception_exit() - exit for grids that hit an exception
+ */
+
+static stat_t _grid_finish()
+{
+    _probe_restore_settings();          // cleanup first
+    pg.valid = (pg.j == pg.ny);
+    cm->probe_state[0] = pg.valid ? PROBE_SUCCEEDED : PROBE_FAILED;
+    _send_grid_end_report();
+    return (STAT_OK);
+}
+
+static stat_t _grid_exception_exit(stat_t status)
+{
+    _grid_finish();
+    return (cm_alarm(status, "grid probe error"));
+}
+
+/*
+ * _send_grid_row_report() - stream one completed row, Z in work coordinates
+ * _send_grid_end_report() - end of cycle report
+ */
+
+static void _send_grid_row_report(const uint8_t row)
+{
+    char  buf[PROBE_GRID_MAX * 12 + 32];
+    char* bufp = buf;
+    const float *z = &pg.results[row * pg.nx];
+
+    bufp += sprintf(bufp, "{\"gprb\":{\"r\":%i,\"z\":[", (int)row);
+    for (uint8_t i = 0; i < pg.nx; i++) {
+        bufp += sprintf(bufp, (i == 0) ? "%0.4f" : ",%0.4f", _to_inches(z[i] - pg.z_offset));
+    }
+    sprintf(bufp, "]}}\n");
+    xio_writeline(buf);
+}
+
+static void _send_grid_end_report()
+{
+    char buf[64];
+    sprintf(buf, "{\"gprb\":{\"e\":%i,\"nx\":%i,\"ny\":%i}}\n", (int)pg.valid, (int)pg.nx, (int)pg.ny);
+    xio_writeline(buf);
+}
+
+/*
+ * cm_get_probe_grid() - return the last completed grid, or nullptr if there isn't one
+ *
+ *  Results are contact Z in machine coordinates, row-major from the first corner.
+ *  origin[] and step[] are the machine XY of the first point and the (signed) spacing.
+ */
+
+const float *cm_get_probe_grid(uint8_t *nx, uint8_t *ny, float origin[], float step[])
+{
+    if (!pg.valid) {
+        return (nullptr);
+    }
+    *nx = pg.nx;
+    *ny = pg.ny;
+    origin[0] = pg.origin[0];
+    origin[1] = pg.origin[1];
+    step[0] = pg.step[0];
+    step[1] = pg.step[1];
+    return (pg.results);
+}
+
+/*
+ * Grid probing parameters and state - {"gprb":{...}}
+ *
+ * Parameters are in Gcode units and work coordinates, and cannot be changed while a grid
+ * cycle is running. Setting go to 1 starts the cycle. See cm_probe_grid_start().
+ */
+
+static stat_t _set_grid_float(nvObj_t *nv, float &value)
+{
+    if (pg.active) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    return (set_float(nv, value));
+}
+
+static stat_t _set_grid_points(nvObj_t *nv, uint8_t &value)
+{
+    if (pg.active) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    ritorno(set_integer(nv, value, 2, PROBE_GRID_MAX));
+    pg.valid = false;                   // results[] no longer matches the grid size
+    return (STAT_OK);
+}
+
+stat_t cm_get_gprbx0(nvObj_t *nv) { return (get_float(nv, pg.x0)); }
+stat_t cm_set_gprbx0(nvObj_t *nv) { return (_set_grid_float(nv, pg.x0)); }
+stat_t cm_get_gprby0(nvObj_t *nv) { return (get_float(nv, pg.y0)); }
+stat_t cm_set_gprby0(nvObj_t *nv) { return (_set_grid_float(nv, pg.y0)); }
+stat_t cm_get_gprbx1(nvObj_t *nv) { return (get_float(nv, pg.x1)); }
+stat_t cm_set_gprbx1(nvObj_t *nv) { return (_set_grid_float(nv, pg.x1)); }
+stat_t cm_get_gprby1(nvObj_t *nv) { return (get_float(nv, pg.y1)); }
+stat_t cm_set_gprby1(nvObj_t *nv) { return (_set_grid_float(nv, pg.y1)); }
+stat_t cm_get_gprbnx(nvObj_t *nv) { return (get_integer(nv, pg.nx)); }
+stat_t cm_set_gprbnx(nvObj_t *nv) { return (_set_grid_points(nv, pg.nx)); }
+stat_t cm_get_gprbny(nvObj_t *nv) { return (get_integer(nv, pg.ny)); }
+stat_t cm_set_gprbny(nvObj_t *nv) { return (_set_grid_points(nv, pg.ny)); }
+stat_t cm_get_gprbz(nvObj_t *nv)  { return (get_float(nv, pg.z)); }
+stat_t cm_set_gprbz(nvObj_t *nv)  { return (_set_grid_float(nv, pg.z)); }
+stat_t cm_get_gprbc(nvObj_t *nv)  { return (get_float(nv, pg.clearance)); }
+stat_t cm_set_gprbc(nvObj_t *nv)  { return (_set_grid_float(nv, pg.clearance)); }
+stat_t cm_get_gprbf(nvObj_t *nv)  { return (get_float(nv, pg.feed)); }
+stat_t cm_set_gprbf(nvObj_t *nv)  { return (_set_grid_float(nv, pg.feed)); }
+stat_t cm_get_gprbe(nvObj_t *nv)  { return (get_integer(nv, pg.valid)); }
+stat_t cm_get_gprbgo(nvObj_t *nv) { return (get_integer(nv, pg.active)); }
+
+stat_t cm_set_gprbgo(nvObj_t *nv)
+{
+    if (pg.active) {
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    if (nv->value_int) {
+        return (cm_probe_grid_start());
+    }
+    return (STAT_OK);
+}
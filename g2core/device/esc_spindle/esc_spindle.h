@@ -44,8 +44,20 @@
  *
  * We still handle those pins here for the sake of compatibility and status display (LEDs on those pins) and debugging.
  *
+ * Without feedback, a spin-up holds motion for the fixed spinup delay and then for the ramp of the
+ * commanded speed, whatever the spindle is actually doing. If a tachometer is wired to a digital
+ * input ({spti:N}, {sptp:pulses_per_rev}) the delay is skipped: the command ramps immediately and
+ * motion is released once the measured speed is within {spat:} (a fraction) of the target. The
+ * spinup delay then becomes a timeout after the command has reached the target, so a dead or
+ * miswired tach is never worse than running without one.
+ *
+ * Speed is measured by counting leading edges over TACH_WINDOW_MS, so the resolution is one pulse
+ * per window - e.g. 5% at 12000 RPM with one pulse per rev. Use more pulses per rev or a looser
+ * tolerance if the release point is noisy. Watch {spsa:} to check the tach wiring.
  */
 
+#define TACH_WINDOW_MS 100        // tachometer counting window
+
 
 // class declaration
 // note implementation is after
@@ -69,6 +81,14 @@ class ESCSpindle : public ToolHead {
 	
     float speed_change_per_tick;  // speed ramping rate per tick (ms)
 
+    uint8_t tach_input_num = 0;       // digital input the tachometer is wired to (0 = no tach)
+    float tach_ppr = 1;               // tachometer pulses per spindle revolution
+    float at_speed_tolerance = 0.05;  // measured speed within this fraction of target is "at speed"
+    volatile uint32_t tach_pulses = 0;  // leading edges counted in the current window
+    uint16_t tach_window_ms = 0;      // ms elapsed in the current window
+    float speed_measured = 0;         // RPM measured over the last complete window
+    bool waiting_for_speed = false;   // command has reached target, waiting on the tach
+
     struct speedToPhase {
         float speed_lo;              // minimum spindle speed [0..N]
         float speed_hi;              // maximum spindle speed
@@ -97,6 +117,17 @@ class ESCSpindle : public ToolHead {
     gpioDigitalOutput *direction_output = nullptr;
 
     Motate::SysTickEvent spindle_systick_event = {[&] { this->_handle_systick(); }, nullptr};
+    Motate::SysTickEvent tach_systick_event = {[&] { this->_handle_tach_systick(); }, nullptr};
+
+    gpioDigitalInputHandler tach_handler {
+        [&](const bool state, const inputEdgeFlag edge, const uint8_t triggering_pin_number) {
+            if (triggering_pin_number != tach_input_num) { return GPIO_NOT_HANDLED; }
+            if (edge == INPUT_EDGE_LEADING) { tach_pulses++; }
+            return GPIO_HANDLED;    // tach pulses are not for anyone else
+        },
+        100,    // priority
+        nullptr // next - nullptr to start with
+    };
 
     void set_pwm_value();   // using all of the settings, set the value for the pwm pin
     void complete_change(); // after an engage or resume, handle the rest
@@ -108,6 +139,21 @@ class ESCSpindle : public ToolHead {
         return std::min(speed_max, std::max(speed_min, target_speed));
     }
 
+    bool _has_tach() { return (tach_input_num != 0); }
+
+    bool _is_at_speed(float target_speed) {
+        return (std::abs(speed_measured - target_speed) <= (at_speed_tolerance * target_speed));
+    }
+
+    void _handle_tach_systick() {
+        if (++tach_window_ms < TACH_WINDOW_MS) {
+            return;
+        }
+        speed_measured = (tach_pulses * 60000.0) / (tach_ppr * tach_window_ms);
+        tach_pulses = 0;
+        tach_window_ms = 0;
+    }
+
     void _handle_systick() {
         bool done = false;
         float target_speed = _get_target_speed();
@@ -118,18 +164,23 @@ class ESCSpindle : public ToolHead {
             spinup_count_ms = 0;
             done = true;
         } else if (fp_NE(target_speed, speed_actual)) {
+            waiting_for_speed = false;  // target changed (override) - ramp to the new one
             if (speed_actual < target_speed) {
                 // spin up
-                if (spinup_count_ms < (spinup_delay * 1000.0)) { // Convert to ms (maintain legacy spde)
+                if (!_has_tach() && (spinup_count_ms < (spinup_delay * 1000.0))) { // Convert to ms (maintain legacy spde)
                   // spin up delay
                   spinup_count_ms += 1.0;
                 } else {
                   speed_actual += speed_change_per_tick;
-                  if (speed_actual > target_speed) {
+                  if (_has_tach() && (speed_actual >= target_speed)) {
+                      speed_actual = target_speed;
+                      waiting_for_speed = true;   // let the tach say when we are there
+                      spinup_count_ms = 0;
+                  } else if (speed_actual > target_speed) {
                       speed_actual = target_speed;
                       done = true;
                   }
-                }                
+                }
             } else {
                 // spin down
                 speed_actual -= speed_change_per_tick;
@@ -138,6 +189,12 @@ class ESCSpindle : public ToolHead {
                     done = true;
                 }
             }
+        } else if (waiting_for_speed) {
+            // at commanded speed - hold until measured speed agrees, or the spinup delay times out
+            spinup_count_ms += 1.0;
+            if (_is_at_speed(target_speed) || (spinup_count_ms >= (spinup_delay * 1000.0))) {
+                done = true;
+            }
         } else {
             done = true;
         }
@@ -145,6 +202,7 @@ class ESCSpindle : public ToolHead {
 
         if (done) {
             spinup_count_ms = 0;
+            waiting_for_speed = false;
             SysTickTimer.unregisterEvent(&spindle_systick_event);
 
             // Clear the flag - the loader will proceed naturally
@@ -218,6 +276,13 @@ class ESCSpindle : public ToolHead {
     float get_speed_change_per_tick() override { return speed_change_per_tick; }
     void set_spinup_delay(float new_spinup_delay) override { spinup_delay = new_spinup_delay; }
     float get_spinup_delay() override { return spinup_delay; }
+    bool set_tach_input(const uint8_t tach_input) override;
+    uint8_t get_tach_input() override { return tach_input_num; }
+    void set_tach_ppr(float new_tach_ppr) override { tach_ppr = new_tach_ppr; }
+    float get_tach_ppr() override { return tach_ppr; }
+    void set_at_speed_tolerance(float new_tolerance) override { at_speed_tolerance = new_tolerance; }
+    float get_at_speed_tolerance() override { return at_speed_tolerance; }
+    float get_speed_measured() override { return speed_measured; }
 
     void set_cw_speed_lo(float new_speed_lo) override { cw.speed_lo = new_speed_lo; }
     float get_cw_speed_lo() override { return cw.speed_lo; }
@@ -284,7 +349,7 @@ bool ESCSpindle::ready_to_resume() { return paused && safety_manager->ok_to_spin
 bool ESCSpindle::busy() {
     bool at_speed_or_dont_care = false;
 
-    if (!this_change_holds_motion || fp_EQ(_get_target_speed(), speed_actual)) {
+    if (!this_change_holds_motion || (fp_EQ(_get_target_speed(), speed_actual) && !waiting_for_speed)) {
         at_speed_or_dont_care = true;
     }
 
@@ -442,6 +507,24 @@ ioPolarity ESCSpindle::get_direction_polarity() {
     return IO_ACTIVE_HIGH;
 }
 
+bool ESCSpindle::set_tach_input(const uint8_t tach_input) {
+    tach_input_num = tach_input;
+    tach_pulses = 0;
+    tach_window_ms = 0;
+    speed_measured = 0;
+    waiting_for_speed = false;
+
+    if (tach_input == 0) {
+        din_handlers[INPUT_ACTION_INTERNAL].deregisterHandler(&tach_handler);
+        SysTickTimer.unregisterEvent(&tach_systick_event);
+        return false;
+    }
+    gpio_set_input_lockout(tach_input, 0);  // every edge counts
+    din_handlers[INPUT_ACTION_INTERNAL].registerHandler(&tach_handler);
+    SysTickTimer.registerEvent(&tach_systick_event);
+    return true;
+}
+
 void ESCSpindle::set_frequency(float new_frequency)
 {
     if (pwm_output) {
@@ -36,6 +36,7 @@ class LaserTool; // Need to forward declare since stepper.h may (eventually) inc
 #include "spindle.h"
 #include "stepper.h" // for Stepper and st_request_load_move
 #include "safety_manager.h" // for safety_manager
+#include "raster.h"         // for raster scanlines
 
 /* A few notes:
  *
@@ -44,6 +45,19 @@ class LaserTool; // Need to forward declare since stepper.h may (eventually) inc
  * Laser ON/OFF (NOT fire, just "is active") is on the `enable_output` pin,
  * and actual fire/pulse is on the `fire` pin.
  *
+ * Raster moves (a G1 that claimed a scanline, see raster.h) fire at a constant max_ppm pulses
+ * per mm and set each pulse's duty cycle from the pixel under it. The pixel is found from the
+ * number of pulses since the start of the move, so it tracks the DDA path exactly, and the
+ * first and last overscan mm of the move are left unlit.
+ *
+ * M4 pulses are spaced per mm of travel, so their energy per mm is already independent of speed.
+ * M3 holds a fixed duty cycle, which over-burns wherever the head slows for corners. With
+ * velocity power on ({th2vp:1}) M3 duty is instead scaled by the segment's average velocity
+ * over the programmed feed rate, so power ramps down and up with the planner's accel/decel and
+ * the laser is dark when motion stops. The scale is computed per segment in inverse_kinematics()
+ * and written at segment load from _enableImpl() or motionStopped(), which the loader calls for
+ * this motor on every segment.
+ *
  */
 
 
@@ -79,6 +93,26 @@ class LaserTool : public ToolHead, public Stepper, public KinematicsParent {
 
     uint32_t raw_fire_duty_cycle = 0;
 
+    // Raster state - prepared in inverse_kinematics(), latched at segment load by _enableImpl()
+    struct RasterRun {
+        const rasterLine_t *line = nullptr;   // nullptr if not in a raster move
+        uint16_t seq = 0;                   // rasterLine_t.seq of the line
+        uint32_t lead_pulses;               // unlit pulses before the first pixel
+        uint32_t span_pulses;               // pulses across the imaged part of the move
+        uint32_t pixel_step;                // pixels per pulse, 16.16 fixed point
+        uint32_t full_duty;                 // raw duty cycle of a full power pixel
+        uint8_t max_value;                  // pixel value of full power
+    };
+    RasterRun next_raster;
+    RasterRun raster;
+    uint32_t raster_pulse = 0;              // pulses since the start of the raster move
+
+    // Velocity-scaled M3 power - prepared in inverse_kinematics(), written at segment load
+    bool velocity_power = false;
+    uint32_t next_velocity_duty = 0;
+    volatile bool next_velocity_ready = false;
+    void _load_segment();
+
     float min_s;
     float max_s;
     float min_ppm;
@@ -180,6 +214,7 @@ class LaserTool : public ToolHead, public Stepper, public KinematicsParent {
     void _disableImpl() override;
     void stepStart() override;
     void stepEnd() override;
+    void motionStopped() override;
     void setDirection(uint8_t new_direction) override;
     void setPowerLevels(float active_pl, float idle_pl) override;
 
@@ -203,6 +238,9 @@ class LaserTool : public ToolHead, public Stepper, public KinematicsParent {
 
     float get_max_ppm();
     void set_max_ppm(float new_max_ppm);
+
+    bool get_velocity_power();
+    void set_velocity_power(bool new_velocity_power);
 };
 
 // IMPLEMENTATION
@@ -313,7 +351,8 @@ void LaserTool<KinematicsParent,fire_num>::engage(const GCodeState_t &gm) {
         raw_fire_duty_cycle = std::floor(s * (float)top_value);
         
         // Fire immediately - this is position-synchronized PWM change!
-        fire.writeRaw(raw_fire_duty_cycle);
+        // In velocity power mode we are stopped here, so stay dark until motion starts
+        fire.writeRaw(velocity_power ? 0 : raw_fire_duty_cycle);
         
     } else if (direction == SPINDLE_CCW) {
         // M4 - Motion-synchronized mode - prepare PWM but don't fire yet
@@ -402,7 +441,12 @@ float LaserTool<KinematicsParent,fire_num>::get_frequency()
 
 template <typename KinematicsParent, Motate::pin_number fire_num>
 void LaserTool<KinematicsParent,fire_num>::_enableImpl() {
+    _load_segment();
     ticks_per_pulse =  next_ticks_per_pulse;
+    if ((raster.line != next_raster.line) || (raster.seq != next_raster.seq)) {
+        raster = next_raster;           // first segment of a new move - restart pixel indexing
+        raster_pulse = 0;
+    }
     // fire.writeRaw(raw_fire_duty_cycle);
     enabled = true;
 };
@@ -417,6 +461,27 @@ template <typename KinematicsParent, Motate::pin_number fire_num>
 void LaserTool<KinematicsParent,fire_num>::stepStart() {
     if (!enabled || current_mode != LASER_MODE_MOTION) return;
 
+    if (raster.line != nullptr) {
+        uint32_t pulse = raster_pulse++;
+        if ((pulse < raster.lead_pulses) || ((pulse -= raster.lead_pulses) >= raster.span_pulses)) {
+            return;                     // overscan - keep counting but don't fire
+        }
+        uint16_t index = (pulse * raster.pixel_step) >> 16;
+        if (index >= raster.line->pixels) {
+            index = raster.line->pixels - 1;
+        }
+        if (raster.line->reverse) {
+            index = raster.line->pixels - 1 - index;
+        }
+        uint8_t value = raster_pixel(raster.line, index);
+        if (value == 0) {
+            return;
+        }
+        fire.writeRaw((raster.full_duty * value) / raster.max_value);
+        pulse_tick_counter = ticks_per_pulse;
+        return;
+    }
+
     fire.writeRaw(raw_fire_duty_cycle);
     pulse_tick_counter = ticks_per_pulse;
 };
@@ -431,6 +496,21 @@ void LaserTool<KinematicsParent,fire_num>::stepEnd() {
     }
 };
 
+template <typename KinematicsParent, Motate::pin_number fire_num>
+void LaserTool<KinematicsParent,fire_num>::motionStopped() {
+    _load_segment();
+};
+
+// Called at every segment load, and when the loader runs dry (nothing ready -> dark)
+template <typename KinematicsParent, Motate::pin_number fire_num>
+void LaserTool<KinematicsParent,fire_num>::_load_segment() {
+    if (!velocity_power || paused || (direction != SPINDLE_CW)) {
+        return;
+    }
+    fire.writeRaw(next_velocity_ready ? next_velocity_duty : 0);
+    next_velocity_ready = false;
+};
+
 template <typename KinematicsParent, Motate::pin_number fire_num>
 void LaserTool<KinematicsParent,fire_num>::setDirection(uint8_t new_direction) {
 };
@@ -530,6 +610,15 @@ void LaserTool<KinematicsParent,fire_num>::set_max_ppm(float new_max_ppm) {
     max_ppm = new_max_ppm;
 }
 
+template <typename KinematicsParent, Motate::pin_number fire_num>
+bool LaserTool<KinematicsParent,fire_num>::get_velocity_power() {
+    return velocity_power;
+}
+template <typename KinematicsParent, Motate::pin_number fire_num>
+void LaserTool<KinematicsParent,fire_num>::set_velocity_power(bool new_velocity_power) {
+    velocity_power = new_velocity_power;
+}
+
 template <typename KinematicsParent, Motate::pin_number fire_num>
 void LaserTool<KinematicsParent,fire_num>::inverse_kinematics(const GCodeState_t &gm, const float target[AXES], const float position[AXES], const float start_velocity, const float end_velocity, const float segment_time, float steps[MOTORS]) {
     
@@ -537,9 +626,37 @@ void LaserTool<KinematicsParent,fire_num>::inverse_kinematics(const GCodeState_t
 
     float move_length = 0;
     next_ticks_per_pulse = 0;
+    next_raster.line = nullptr;
+
+    // Raster G1 - constant pulse density, power per pulse comes from the scanline
+    if (!paused && (gm.tool == LASER_TOOL) && (gm.raster != 0) &&
+        (gm.motion_mode == MOTION_MODE_STRAIGHT_FEED) &&
+        (gm.spindle_speed > min_s) && (gm.spindle_direction == SPINDLE_CCW)) {
+
+        const rasterLine_t *line = raster_take(gm.raster);
+        float ppm = max_ppm;
+
+        if (line->seq != next_raster.seq) {     // first segment of the move
+            float s = std::min(1.0f, std::max(0.0f, ((gm.spindle_speed - min_s)/(max_s-min_s)) ));
+            float overscan = std::min(line->overscan, line->length * 0.5f);
+            float span = (line->length - 2 * overscan) * ppm;
+
+            next_raster.seq = line->seq;
+            next_raster.lead_pulses = overscan * ppm;
+            next_raster.span_pulses = span;
+            next_raster.pixel_step = (span >= 1) ? (line->pixels * 65536.0f / span) : 0;
+            next_raster.full_duty = std::floor(s * (float)fire.getTopValue());
+            next_raster.max_value = (1 << line->bits) - 1;
+        }
+        next_raster.line = line;
 
+        float x_len = position[AXIS_X] - target[AXIS_X];
+        float y_len = position[AXIS_Y] - target[AXIS_Y];
+        move_length = sqrt((x_len * x_len) + (y_len * y_len)) * ppm;
+        next_ticks_per_pulse = std::ceil(pulse_duration_us / (1000000 / FREQUENCY_DDA));
+    }
     // ONLY fire the laser for G1, G2, or G3, when M4 is on (motion-synchronized), and S > 0
-    if (!paused && (gm.tool == LASER_TOOL) && 
+    else if (!paused && (gm.tool == LASER_TOOL) && 
         ((gm.motion_mode == MOTION_MODE_STRAIGHT_FEED) || (gm.motion_mode == MOTION_MODE_CW_ARC) || (gm.motion_mode == MOTION_MODE_CCW_ARC)) && 
         (gm.spindle_speed > min_s) && (gm.spindle_direction == SPINDLE_CCW)) {  // ← Only for M4!
         
@@ -558,6 +675,22 @@ void LaserTool<KinematicsParent,fire_num>::inverse_kinematics(const GCodeState_t
     }
     // DON'T change mode here - let M3/M4 commands control the mode
 
+    // M3 with velocity power - scale duty by average segment velocity over the feed rate
+    if (velocity_power && !paused && (gm.tool == LASER_TOOL) && (gm.spindle_direction == SPINDLE_CW)) {
+        float velocity_scale = 0;       // traverses and anything else run dark
+        if ((gm.motion_mode == MOTION_MODE_STRAIGHT_FEED) || (gm.motion_mode == MOTION_MODE_CW_ARC) || (gm.motion_mode == MOTION_MODE_CCW_ARC)) {
+            if ((gm.feed_rate_mode == UNITS_PER_MINUTE_MODE) && (gm.feed_rate > 0)) {
+                velocity_scale = std::min(1.0f, (start_velocity + end_velocity) * 0.5f / gm.feed_rate);
+            } else {
+                velocity_scale = 1.0;   // inverse time - no reference velocity to scale against
+            }
+        }
+        float override_factor = speed_override_enable ? speed_override_factor : 1.0;
+        float s = std::min(1.0f, std::max(0.0f, (((gm.spindle_speed * override_factor) - min_s) / (max_s - min_s))));
+        next_velocity_duty = std::floor(s * velocity_scale * (float)fire.getTopValue());
+        next_velocity_ready = true;
+    }
+
     laser_step_position += move_length;
     steps[laser_motor] = laser_step_position;
 }
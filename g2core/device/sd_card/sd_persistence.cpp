@@ -45,6 +45,11 @@
 #define MAX_WRITE_FAILURES 3
 #define MAX_WRITE_CHANGES IO_BUFFER_SIZE    // maximum number of write values that change - ms: TODO
 
+#define JOURNAL_FLUSH_INTERVAL 100  // minimum interval between journal appends
+#define JOURNAL_OVERLAY_LEN 64      // distinct indexes held in the journal before compaction is forced
+#define JOURNAL_MAX_RECORDS 256     // journal records (including superseded ones) before compaction
+#define JOURNAL_MAGIC 0x4C4A3247    // "G2JL" little-endian
+
 /***********************************************************************************
  **** STRUCTURE ALLOCATIONS ********************************************************
  ***********************************************************************************/
@@ -60,8 +65,40 @@ struct nvmSingleton_t {
     uint16_t changed_nvs;
     uint32_t last_write_systick;
     uint8_t write_failures;
+    uint32_t snapshot_crc;          // CRC of the active persistN.bin file, valid once it's been validated
 } nvm;
 
+//**** journal singleton ****
+
+struct nvmJournalHeader_t {
+    uint32_t magic;
+    uint32_t snapshot_crc;          // the journal only applies on top of the snapshot with this CRC
+};
+
+struct nvmJournalRecord_t {
+    uint16_t index;
+    uint16_t magic;                 // low half of JOURNAL_MAGIC - cheap check before the CRC
+    uint32_t value;
+    uint32_t crc;                   // CRC of the preceding 8 bytes
+};
+
+struct nvmJournalEntry_t {          // RAM overlay of the latest journaled value per index
+    uint16_t index;
+    bool dirty;                     // not yet appended to the journal file
+    uint32_t value;
+};
+
+struct nvmJournal_t {
+    FIL file;
+    bool ready;                     // journal has been scanned and replayed into the overlay
+    bool compact_pending;           // overlay overflowed or the journal is too long - rewrite snapshot
+    uint8_t entries;
+    uint8_t dirty_entries;
+    uint16_t records;               // records currently in the journal file
+    uint32_t last_flush_systick;
+    nvmJournalEntry_t overlay[JOURNAL_OVERLAY_LEN];
+} nvj;
+
 /***********************************************************************************
  **** GENERIC STATIC FUNCTIONS AND VARIABLES ***************************************
  ***********************************************************************************/
@@ -70,6 +107,9 @@ stat_t prepare_persistence_file();
 stat_t write_persistent_values();
 stat_t validate_persistence_file();
 uint8_t active_file_index();
+void decode_persistent_value(nvObj_t *nv, const void *src);
+bool encode_persistent_value(nvObj_t *nv, uint32_t *word);
+stat_t read_persistence_image(nvObj_t *nv, fptrRestore restore, bool journaled);
 
 // Leaving this in for now in case bugs come up; we can remove it when we're confident
 // it's stable
@@ -92,6 +132,7 @@ uint8_t active_file_index();
 #define PERSISTENCE_DIR "persist"
 #define PERSISTENCE_FILENAME(num) PERSISTENCE_DIR"/persist"#num".bin"
 #define PERSISTENCE_FILENAME_CNT 3
+#define JOURNAL_FILENAME PERSISTENCE_DIR"/journal.bin"
 #define NEXT_FILE_INDEX (nvm.file_index+1) % PERSISTENCE_FILENAME_CNT
 #define PREV_FILE_INDEX (nvm.file_index+PERSISTENCE_FILENAME_CNT-1) % PERSISTENCE_FILENAME_CNT
 const char* filenames[PERSISTENCE_FILENAME_CNT] = {
@@ -107,6 +148,7 @@ class SD_Persistence : public Persistence {
    public:
     void init() override;
     stat_t read(nvObj_t *nv) override;
+    stat_t read_all(nvObj_t *nv, fptrRestore restore) override;
     stat_t write(nvObj_t *nv) override;
     stat_t periodic() override;
 };
@@ -143,24 +185,20 @@ stat_t SD_Persistence::read(nvObj_t *nv)
         return (STAT_PERSISTENCE_ERROR);
     }
 
-    auto type = cfgArray[nv->index].flags & F_TYPE_MASK;
-    if ((type == TYPE_INTEGER) || (type == TYPE_DATA)) {
-        nv->valuetype = TYPE_INTEGER;
-        nv->value_int = *(int32_t *)nvm.io_buffer;
-        DEBUG_PRINT("value (i) copied from address %l in file: %l\n", nv->index * NVM_VALUE_LEN, nv->value_int);
-    } else if (type == TYPE_BOOLEAN) {
-        nv->valuetype = TYPE_BOOLEAN;
-        nv->value_int = *(int32_t *)nvm.io_buffer;
-        DEBUG_PRINT("value (b) copied from address %l in file: %l\n", nv->index * NVM_VALUE_LEN, nv->value_int);
-    } else {
-        nv->valuetype = TYPE_FLOAT;
-        nv->value_flt = *(float *)nvm.io_buffer;
-        DEBUG_PRINT("value (f) copied from address %l in file: %f\n", nv->index * NVM_VALUE_LEN, nv->value_flt);
-    }
-
+    decode_persistent_value(nv, nvm.io_buffer);
+    DEBUG_PRINT("value copied from address %l in file\n", nv->index * NVM_VALUE_LEN);
     return (STAT_OK);
 }
 
+/*
+ * read_all() - bulk restore, see read_persistence_image()
+ */
+
+stat_t SD_Persistence::read_all(nvObj_t *nv, fptrRestore restore)
+{
+    return (read_persistence_image(nv, restore, false));
+}
+
 /*
  * write_persistent_value() - write to NVM by index, but only if the value has changed
  *
@@ -300,7 +338,50 @@ stat_t validate_persistence_file()
        return STAT_PERSISTENCE_ERROR;
    }
    DEBUG_PRINT("crc: %lu from file, %lu calculated\n", filecrc, crc);
-   return crc == filecrc ? STAT_OK : STAT_PERSISTENCE_ERROR;
+   if (crc != filecrc) {
+       return STAT_PERSISTENCE_ERROR;
+   }
+   nvm.snapshot_crc = crc;
+   return STAT_OK;
+}
+
+/*
+ * read_persistence_image()
+ *
+ * Reads the value image front to back in IO_BUFFER_SIZE blocks and hands every
+ *  initialized single value to restore(). The file was CRC checked when it was opened by
+ *  prepare_persistence_file(), so this is one sequential pass with no per-value seeks.
+ *  If journaled is set, values held in the journal overlay replace the snapshot values.
+ */
+static nvmJournalEntry_t *_journal_find(index_t index);
+
+stat_t read_persistence_image(nvObj_t *nv, fptrRestore restore, bool journaled)
+{
+   ritorno(prepare_persistence_file());
+   fs_ritorno(f_lseek(&nvm.file, 0), "f_lseek during image read");
+
+   const index_t step = IO_BUFFER_SIZE/NVM_VALUE_LEN;
+   for (index_t cnt = 0; nv_index_is_single(cnt); cnt += step) {
+       UINT br;
+       fs_ritorno(f_read(&nvm.file, &nvm.io_buffer, IO_BUFFER_SIZE, &br), "file read during image read");
+
+       for (nv->index = cnt; (nv->index < cnt + br/NVM_VALUE_LEN) && nv_index_is_single(nv->index); nv->index++) {
+           if (!(cfgArray[nv->index].flags & F_INITIALIZE)) {
+               continue;
+           }
+           nvmJournalEntry_t *e = journaled ? _journal_find(nv->index) : nullptr;
+           if (e != nullptr) {
+               decode_persistent_value(nv, &e->value);
+           } else {
+               decode_persistent_value(nv, nvm.io_buffer + (nv->index - cnt) * NVM_VALUE_LEN);
+           }
+           restore(nv);
+       }
+       if (br < IO_BUFFER_SIZE) {
+           break;
+       }
+   }
+   return (STAT_OK);
 }
 
 /*
@@ -361,15 +442,12 @@ stat_t write_persistent_values()
           // Get the index for the current NVM value
           index_t index = (nv->index - cnt) * NVM_VALUE_LEN;
 
-          // Write out based on the value type
-          if (nv->valuetype == TYPE_INTEGER || nv->valuetype == TYPE_BOOLEAN || nv->valuetype == TYPE_DATA) {
-            memcpy(nvm.io_buffer + index, &nv->value_int, NVM_VALUE_LEN);
-            DEBUG_PRINT("item index: %l , write index: %l (cnt: %l), value: %i\n", nv->index, index, cnt, nv->value_int);
-          } else if (nv->valuetype == TYPE_FLOAT) {
-            memcpy(nvm.io_buffer + index, &nv->value_flt, NVM_VALUE_LEN);
-            DEBUG_PRINT("item index: %l , write index: %l (cnt: %l), value: %f\n", nv->index, index, cnt, nv->value_flt);
-          } else {
-            // next - ignore strings and other stuff which shouldn't be set to persist anyway
+          // Write out based on the value type - strings and other stuff which shouldn't
+          // be set to persist anyway are ignored
+          uint32_t word;
+          if (encode_persistent_value(nv, &word)) {
+            memcpy(nvm.io_buffer + index, &word, NVM_VALUE_LEN);
+            DEBUG_PRINT("item index: %l , write index: %l (cnt: %l), value: %lx\n", nv->index, index, cnt, word);
           }
         }
       }
@@ -397,8 +475,348 @@ stat_t write_persistent_values()
        nvm.file_index = 0;
    }
 
+   nvm.snapshot_crc = crc;
+
    // Restore units mode
    cm_set_distance_mode(saved_distance_mode);
 
    return (STAT_OK);
 }
+
+/*
+ * decode_persistent_value() - load a 4-byte persisted value into nv according to its table type
+ * encode_persistent_value() - pack nv's value into 4 bytes; returns false for unpersistable types
+ */
+void decode_persistent_value(nvObj_t *nv, const void *src)
+{
+    auto type = cfgArray[nv->index].flags & F_TYPE_MASK;
+    if ((type == TYPE_INTEGER) || (type == TYPE_DATA)) {
+        nv->valuetype = TYPE_INTEGER;
+        memcpy(&nv->value_int, src, NVM_VALUE_LEN);
+    } else if (type == TYPE_BOOLEAN) {
+        nv->valuetype = TYPE_BOOLEAN;
+        memcpy(&nv->value_int, src, NVM_VALUE_LEN);
+    } else {
+        float value;
+        memcpy(&value, src, NVM_VALUE_LEN);
+        nv->valuetype = TYPE_FLOAT;
+        nv->value_flt = value;
+    }
+}
+
+bool encode_persistent_value(nvObj_t *nv, uint32_t *word)
+{
+    if (nv->valuetype == TYPE_INTEGER || nv->valuetype == TYPE_BOOLEAN || nv->valuetype == TYPE_DATA) {
+        memcpy(word, &nv->value_int, NVM_VALUE_LEN);
+        return (true);
+    }
+    if (nv->valuetype == TYPE_FLOAT) {
+        float value = nv->value_flt;        // value_flt is a double - persist the float
+        memcpy(word, &value, NVM_VALUE_LEN);
+        return (true);
+    }
+    return (false);
+}
+
+/***********************************************************************************
+ **** JOURNALED PERSISTENCE ********************************************************
+ ***********************************************************************************/
+/*
+ * SD_JournalPersistence keeps the persistN.bin files as a snapshot, but instead of
+ *  rewriting the whole snapshot every time a value changes it appends 12-byte
+ *  index/value/CRC records to JOURNAL_FILENAME. The latest journaled value of each index
+ *  is held in a small RAM overlay which is consulted before the snapshot on reads, so
+ *  boot replays the snapshot plus a short log.
+ *
+ * The snapshot is rewritten (compacted) from the live values only when the journal grows
+ *  past JOURNAL_MAX_RECORDS or more than JOURNAL_OVERLAY_LEN distinct values have changed,
+ *  and only when the machine is not moving. Appends are allowed while moving.
+ *
+ * Recovery: the journal header carries the CRC of the snapshot it applies to, so a journal
+ *  left over from an interrupted compaction is recognized as stale and discarded (the new
+ *  snapshot already holds its values). A torn record at the tail - power lost mid-append -
+ *  fails its CRC and is truncated away by the boot scan.
+ */
+
+class SD_JournalPersistence : public SD_Persistence {
+   public:
+    void init() override;
+    stat_t read(nvObj_t *nv) override;
+    stat_t read_all(nvObj_t *nv, fptrRestore restore) override;
+    stat_t write(nvObj_t *nv) override;
+    stat_t periodic() override;
+};
+
+SD_JournalPersistence sdjp {};
+
+void setup_sd_journal_persistence() {
+    persistence = &sdjp;
+}
+
+static nvmJournalEntry_t *_journal_find(index_t index)
+{
+    for (uint8_t i=0; i<nvj.entries; i++) {
+        if (nvj.overlay[i].index == index) {
+            return (&nvj.overlay[i]);
+        }
+    }
+    return (nullptr);
+}
+
+// Returns false if the overlay is full, in which case only a compaction can capture the value
+static bool _journal_apply(index_t index, uint32_t value, bool dirty)
+{
+    nvmJournalEntry_t *e = _journal_find(index);
+    if (e == nullptr) {
+        if (nvj.entries >= JOURNAL_OVERLAY_LEN) {
+            nvj.compact_pending = true;
+            return (false);
+        }
+        e = &nvj.overlay[nvj.entries++];
+        e->index = index;
+        e->dirty = false;
+    }
+    e->value = value;
+    if (dirty && !e->dirty) {
+        e->dirty = true;
+        nvj.dirty_entries++;
+    }
+    return (true);
+}
+
+// Start an empty journal on top of the current snapshot. Journal file must be open.
+static stat_t _journal_restart()
+{
+    nvmJournalHeader_t header = { JOURNAL_MAGIC, nvm.snapshot_crc };
+    UINT bw;
+    fs_ritorno(f_lseek(&nvj.file, 0), "journal restart seek");
+    fs_ritorno(f_truncate(&nvj.file), "journal truncate");
+    fs_ritorno(f_write(&nvj.file, &header, sizeof(header), &bw), "journal header write");
+    if (bw != sizeof(header)) {
+        return (STAT_PERSISTENCE_ERROR);
+    }
+    fs_ritorno(f_sync(&nvj.file), "journal header sync");
+    nvj.records = 0;
+    return (STAT_OK);
+}
+
+// Recovery scan: load every valid record into the overlay and cut off a torn tail
+static stat_t _journal_replay()
+{
+    const UINT chunk = (IO_BUFFER_SIZE / sizeof(nvmJournalRecord_t)) * sizeof(nvmJournalRecord_t);
+    DWORD good_end = sizeof(nvmJournalHeader_t);
+    bool torn = false;
+    UINT br;
+
+    nvj.records = 0;
+    do {
+        fs_ritorno(f_read(&nvj.file, nvm.io_buffer, chunk, &br), "journal read");
+        for (UINT i=0; i+sizeof(nvmJournalRecord_t) <= br; i += sizeof(nvmJournalRecord_t)) {
+            nvmJournalRecord_t *rec = (nvmJournalRecord_t *)(nvm.io_buffer + i);
+            if ((rec->magic != (JOURNAL_MAGIC & 0xFFFF)) || (rec->index >= nv_index_max()) ||
+                (rec->crc != crc32(0, rec, offsetof(nvmJournalRecord_t, crc)))) {
+                torn = true;
+                break;
+            }
+            _journal_apply(rec->index, rec->value, false);
+            good_end += sizeof(nvmJournalRecord_t);
+            nvj.records++;
+        }
+    } while (!torn && (br == chunk));
+
+    if (good_end != f_size(&nvj.file)) {
+        DEBUG_PRINT("journal truncated from %lu to %lu bytes\n", f_size(&nvj.file), good_end);
+        fs_ritorno(f_lseek(&nvj.file, good_end), "journal tail seek");
+        fs_ritorno(f_truncate(&nvj.file), "journal tail truncate");
+        fs_ritorno(f_sync(&nvj.file), "journal tail sync");
+    }
+    fs_ritorno(f_lseek(&nvj.file, f_size(&nvj.file)), "journal append seek");
+    return (STAT_OK);
+}
+
+static stat_t _journal_open()
+{
+    ritorno(prepare_persistence_file());    // the journal is meaningless without a valid snapshot
+    fs_ritorno(f_open(&nvj.file, JOURNAL_FILENAME, FA_READ | FA_WRITE | FA_OPEN_ALWAYS), "open journal");
+
+    nvmJournalHeader_t header;
+    UINT br;
+    fs_ritorno(f_read(&nvj.file, &header, sizeof(header), &br), "journal header read");
+    if ((br != sizeof(header)) || (header.magic != JOURNAL_MAGIC) || (header.snapshot_crc != nvm.snapshot_crc)) {
+        return (_journal_restart());        // new, damaged or stale journal
+    }
+    return (_journal_replay());
+}
+
+/*
+ * _journal_ready() - make sure the journal is open and its contents are in the overlay
+ *
+ *  Like prepare_persistence_file() this re-validates on every use to catch card changes.
+ */
+static stat_t _journal_ready()
+{
+    if (nvj.ready && f_is_open(&nvj.file) && (validate(&nvj.file) == FR_OK)) {
+        return (STAT_OK);
+    }
+    if (f_is_open(&nvj.file)) {
+        f_close(&nvj.file);
+    }
+    if (nvj.dirty_entries > 0) {            // unwritten values are still live in RAM
+        nvj.compact_pending = true;
+    }
+    nvj.ready = false;
+    nvj.entries = 0;
+    nvj.dirty_entries = 0;
+    ritorno(_journal_open());
+    nvj.ready = true;
+    return (STAT_OK);
+}
+
+// Append dirty overlay entries - as many as fit in the IO buffer per call
+static stat_t _journal_flush()
+{
+    ritorno(_journal_ready());
+
+    nvmJournalRecord_t *rec = (nvmJournalRecord_t *)nvm.io_buffer;
+    const uint8_t max_records = IO_BUFFER_SIZE / sizeof(nvmJournalRecord_t);
+    uint8_t count = 0;
+    for (uint8_t i=0; (i < nvj.entries) && (count < max_records); i++) {
+        nvmJournalEntry_t *e = &nvj.overlay[i];
+        if (e->dirty) {
+            rec[count].index = e->index;
+            rec[count].magic = JOURNAL_MAGIC & 0xFFFF;
+            rec[count].value = e->value;
+            rec[count].crc = crc32(0, &rec[count], offsetof(nvmJournalRecord_t, crc));
+            count++;
+        }
+    }
+
+    UINT bw;
+    UINT byte_count = count * sizeof(nvmJournalRecord_t);
+    fs_ritorno(f_write(&nvj.file, rec, byte_count, &bw), "journal append");
+    if (bw != byte_count) {
+        return (STAT_PERSISTENCE_ERROR);
+    }
+    fs_ritorno(f_sync(&nvj.file), "journal sync");
+    nvj.records += count;
+
+    // the records went out in overlay order, so clear the same entries
+    for (uint8_t i=0; (i < nvj.entries) && (count > 0); i++) {
+        if (nvj.overlay[i].dirty) {
+            nvj.overlay[i].dirty = false;
+            nvj.dirty_entries--;
+            count--;
+        }
+    }
+    return (STAT_OK);
+}
+
+// Rewrite the snapshot from the live values, which makes the journal obsolete
+static stat_t _journal_compact()
+{
+    if (write_persistent_values() != STAT_OK) {
+        f_unlink(filenames[NEXT_FILE_INDEX]);
+        if (++nvm.write_failures >= MAX_WRITE_FAILURES) {
+            nvj.compact_pending = false;    // give up on these values
+            nvm.write_failures = 0;         // but try again if we get more values later
+            return (rpt_exception(STAT_PERSISTENCE_ERROR, NULL));
+        }
+        return (STAT_OK);
+    }
+    nvm.write_failures = 0;
+    nvj.compact_pending = false;
+    nvj.entries = 0;
+    nvj.dirty_entries = 0;
+    if (nvj.ready && (_journal_restart() != STAT_OK)) {
+        nvj.ready = false;                  // reopening will discard the stale journal
+    }
+    return (STAT_OK);
+}
+
+void SD_JournalPersistence::init()
+{
+    SD_Persistence::init();
+    nvj.ready = false;
+    nvj.compact_pending = false;
+    nvj.entries = 0;
+    nvj.dirty_entries = 0;
+    nvj.records = 0;
+    nvj.last_flush_systick = nvm.last_write_systick;
+}
+
+stat_t SD_JournalPersistence::read(nvObj_t *nv)
+{
+    if (_journal_ready() == STAT_OK) {
+        nvmJournalEntry_t *e = _journal_find(nv->index);
+        if (e != nullptr) {
+            decode_persistent_value(nv, &e->value);
+            return (STAT_OK);
+        }
+    }
+    return (SD_Persistence::read(nv));
+}
+
+stat_t SD_JournalPersistence::read_all(nvObj_t *nv, fptrRestore restore)
+{
+    return (read_persistence_image(nv, restore, (_journal_ready() == STAT_OK)));
+}
+
+/*
+ * SD_JournalPersistence::write() - journal the value if it differs from what's persisted
+ *
+ *  The value is taken from the live config (not from nv) so that callers which only
+ *  populate the index, such as cm_deferred_write_callback(), are journaled correctly.
+ */
+
+stat_t SD_JournalPersistence::write(nvObj_t *nv)
+{
+    if (nvj.compact_pending || (_journal_ready() != STAT_OK)) {
+        nvj.compact_pending = true;         // a full rewrite picks this value up from RAM
+        return (STAT_OK);
+    }
+    nvObj_t live {};
+    live.index = nv->index;
+    nv_get_nvObj(&live);
+    uint32_t value, persisted;
+    if (!encode_persistent_value(&live, &value)) {
+        return (STAT_OK);
+    }
+
+    nvmJournalEntry_t *e = _journal_find(nv->index);
+    if (e != nullptr) {
+        if (e->value == value) {
+            return (STAT_OK);
+        }
+    } else if ((SD_Persistence::read(&live) == STAT_OK) &&
+               encode_persistent_value(&live, &persisted) && (persisted == value)) {
+        return (STAT_OK);                   // snapshot already has it
+    }
+    _journal_apply(nv->index, value, true);
+    return (STAT_OK);
+}
+
+stat_t SD_JournalPersistence::periodic()
+{
+    f_polldisk();
+    uint32_t now = Motate::SysTickTimer.getValue();
+
+    if (nvj.compact_pending || (nvj.records >= JOURNAL_MAX_RECORDS)) {
+        if (now - nvm.last_write_systick < MIN_WRITE_INTERVAL) {
+            return (STAT_NOOP);
+        }
+        if (cm->cycle_type != CYCLE_NONE) {
+            return (STAT_NOOP);             // can't rewrite the snapshot when machine is moving
+        }
+        nvm.last_write_systick = now;
+        return (_journal_compact());
+    }
+
+    if ((nvj.dirty_entries == 0) || (now - nvj.last_flush_systick < JOURNAL_FLUSH_INTERVAL)) {
+        return (STAT_NOOP);
+    }
+    nvj.last_flush_systick = now;
+    if (_journal_flush() != STAT_OK) {
+        nvj.compact_pending = true;         // fall back to rewriting the snapshot
+    }
+    return (STAT_OK);
+}
@@ -29,6 +29,13 @@
 #ifndef SD_PERSISTENCE_H_ONCE
 #define SD_PERSISTENCE_H_ONCE
 
+// Set SD_PERSISTENCE_JOURNAL to 1 in the board or settings file to append changed values
+// to a journal instead of rewriting the whole persistence file on every change
+#ifndef SD_PERSISTENCE_JOURNAL
+#define SD_PERSISTENCE_JOURNAL 0
+#endif
+
 void setup_sd_persistence();
+void setup_sd_journal_persistence();
 
 #endif  // End of include guard: SD_PERSISTENCE_H_ONCE
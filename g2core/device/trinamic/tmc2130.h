@@ -26,6 +26,8 @@
  * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <atomic>
+
 #include "controller.h"
 #include "json_parser.h"       // for nv, etc
 #include "text_parser.h"       // for txt_* commands
@@ -44,6 +46,20 @@ using Motate::SPIDeviceMode;
 using Motate::fromBigEndian;
 using Motate::toBigEndian;
 
+// Decoded DRV_STATUS, as published by the status poll (see pollStatus())
+struct trinamicStatus_t {
+    uint32_t samples;       // incremented on every decoded DRV_STATUS - lets callers wait for a fresh one
+    uint16_t sg_result;     // stallGuard2 load measurement - 0 is the highest load
+    uint8_t  cs_actual;     // actual motor current scale (0-31)
+    bool     stall;         // stallGuard2 threshold reached
+    bool     otpw;          // overtemperature prewarning
+    bool     ot;            // overtemperature shutdown
+    bool     s2g;           // short to ground on either coil
+    bool     ola;           // open load on coil A
+    bool     olb;           // open load on coil B
+    bool     stst;          // standstill
+};
+
 // Complete class for Trinamic2130 drivers.
 // It's also a proper Stepper object.
 template <typename device_t,
@@ -96,7 +112,8 @@ struct Trinamic2130 final : Stepper {
 
     // Record if we're transmitting to prevent altering the buffers while they
     // are being transmitted still.
-    volatile bool _transmitting = false;
+    // This is also taken from the SysTick (see pollStatus()), so it's claimed atomically.
+    std::atomic<bool> _transmitting {false};
 
     // We don't want to transmit until we're inited
     bool _inited = false;
@@ -545,9 +562,27 @@ struct Trinamic2130 final : Stepper {
     } DRV_STATUS; // 0x6F- READ ONLY
     void _postReadDriverStatus() {
         DRV_STATUS.value = fromBigEndian(in_buffer.value);
+
+        // decode into the back buffer, then flip - readers only ever see a complete sample
+        uint8_t back = _status_index ^ 1;
+        trinamicStatus_t &st = _status[back];
+        st.samples   = _status[_status_index].samples + 1;
+        st.sg_result = DRV_STATUS.SG_RESULT;
+        st.cs_actual = DRV_STATUS.CS_ACTUAL;
+        st.stall     = DRV_STATUS.stallGuard;
+        st.otpw      = DRV_STATUS.otpw;
+        st.ot        = DRV_STATUS.ot;
+        st.s2g       = DRV_STATUS.s2ga || DRV_STATUS.s2gb;
+        st.ola       = DRV_STATUS.ola;
+        st.olb       = DRV_STATUS.olb;
+        st.stst      = DRV_STATUS.stst;
+        _status_index = back;
     };
     volatile bool DRV_STATUS_needs_read;
 
+    trinamicStatus_t _status[2] {};
+    volatile uint8_t _status_index = 0;
+
     union {
         volatile uint32_t value;
         //        uint8_t bytes[4];
@@ -567,8 +602,8 @@ struct Trinamic2130 final : Stepper {
 
     void _startNextReadWrite()
     {
-        if (_transmitting || !_inited) { return; }
-        _transmitting = true; // preemptively say we're transmitting .. as a mutex
+        // preemptively say we're transmitting .. as a mutex
+        if (!_inited || _transmitting.exchange(true)) { return; }
 
         // We request the next register, or re-request that we're reading (and already requested) in order to get the response.
         int16_t next_reg;
@@ -785,12 +820,42 @@ struct Trinamic2130 final : Stepper {
             check_timer.set(100);
             IOIN_needs_read = true;
             CHOPCONF_needs_read = true;
-            DRV_STATUS_needs_read = true;
             TSTEP_needs_read = true;
         }
         _startNextReadWrite();
     };
 
+    // Request a DRV_STATUS read. Called for every driver from the same SysTick
+    // (see board_stepper.cpp) so the reads queue back-to-back on the SPI bus and
+    // are clocked out by DMA. If the driver is mid-transaction the read is picked
+    // up when that finishes. Safe to call from interrupt context.
+    void pollStatus()
+    {
+        DRV_STATUS_needs_read = true;
+        _startNextReadWrite();
+    };
+
+    // The most recent complete DRV_STATUS - only changes when a new sample is decoded
+    const trinamicStatus_t &getStatus() const { return _status[_status_index]; };
+
+    bool getLoad(stLoad_t &load) override
+    {
+        const trinamicStatus_t &st = getStatus();
+        load.samples    = st.samples;
+        load.load       = st.sg_result;
+        load.stalled    = st.stall;
+        load.standstill = st.stst;
+        return true;
+    };
+
+    // Route the stallGuard flag to DIAG1 (active low, open drain) so it can be used as a homing input
+    void setStallOutput(bool enable) override
+    {
+        GCONF.diag1_stall = enable;
+        GCONF_needs_written = true;
+        _startNextReadWrite();
+    };
+
     // helper to create functions that retrieve the object from the cfgArray[...].target
     // and call the correct function of that target
     template <stat_t(type::*T)(nvObj_t *nv)>
@@ -897,7 +962,7 @@ struct Trinamic2130 final : Stepper {
     static stat_t set_sgt_fn(nvObj_t *nv) { return get_fn<&type::set_sgt>(nv); };
 
     stat_t get_csa(nvObj_t *nv) {
-        nv->value_int = DRV_STATUS.CS_ACTUAL;
+        nv->value_int = getStatus().cs_actual;
         nv->valuetype = TYPE_INTEGER;
         return STAT_OK;
     };
@@ -905,7 +970,7 @@ struct Trinamic2130 final : Stepper {
     // no set
 
     stat_t get_sgr(nvObj_t *nv) {
-        nv->value_int = DRV_STATUS.SG_RESULT;
+        nv->value_int = getStatus().sg_result;
         nv->valuetype = TYPE_INTEGER;
         return STAT_OK;
     };
@@ -913,13 +978,33 @@ struct Trinamic2130 final : Stepper {
     // no set
 
     stat_t get_sgs(nvObj_t *nv) {
-        nv->value_int = DRV_STATUS.stallGuard;
+        nv->value_int = getStatus().stall;
         nv->valuetype = TYPE_BOOLEAN;
         return STAT_OK;
     };
     static stat_t get_sgs_fn(nvObj_t *nv) { return get_fn<&type::get_sgs>(nv); };
     // no set
 
+    // 0 = OK, 1 = overtemperature prewarning, 2 = overtemperature shutdown
+    stat_t get_ot(nvObj_t *nv) {
+        const trinamicStatus_t &st = getStatus();
+        nv->value_int = st.ot ? 2 : (st.otpw ? 1 : 0);
+        nv->valuetype = TYPE_INTEGER;
+        return STAT_OK;
+    };
+    static stat_t get_ot_fn(nvObj_t *nv) { return get_fn<&type::get_ot>(nv); };
+    // no set
+
+    // open load bitmask: 1 = coil A, 2 = coil B
+    stat_t get_ol(nvObj_t *nv) {
+        const trinamicStatus_t &st = getStatus();
+        nv->value_int = (st.ola ? 1 : 0) | (st.olb ? 2 : 0);
+        nv->valuetype = TYPE_INTEGER;
+        return STAT_OK;
+    };
+    static stat_t get_ol_fn(nvObj_t *nv) { return get_fn<&type::get_ol>(nv); };
+    // no set
+
 
     stat_t get_tbl(nvObj_t *nv) {
         nv->value_int = CHOPCONF.TBL;
@@ -28,6 +28,7 @@
 #include "g2core.h"
 #include "config.h"
 #include "encoder.h"
+#include "stepper.h"             // for sub-step snapshots
 #include "canonical_machine.h"  // needed for cm_panic() in assertions
 
 /**** Allocate Structures ****/
@@ -84,9 +85,50 @@ void en_set_encoder_steps(uint8_t motor, float steps) { en.en[motor].encoder_ste
  *	therefore always stable. But be advised: the position lags target and position
  *	valaes elsewhere in the system because the sample is taken when the steps for
  *	that segment are complete.
+ *
+ *	For a motor with a real encoder the slip measured at its last reading is added, so
+ *	steps the motor lost show up here. Otherwise this is the DDA's own step count.
+ */
+
+float en_read_encoder(uint8_t motor) { return ((float)en.en[motor].encoder_steps + en.en[motor].slip); }
+
+/*
+ * en_set_external_steps()     - report a real encoder reading for a motor, in steps
+ * en_zero_external_encoders() - the step count was redefined, re-zero against the next readings
+ * en_has_external_encoder()   - true once a real encoder has reported the motor
+ *
+ *	Real encoders (ExternalEncoder, e.g. AS5601) are read asynchronously, so a reading isn't
+ *	time-aligned with the segment pipeline. Instead of the raw reading, the difference to the
+ *	step count at the moment of the reading is kept. That difference only changes when the
+ *	motor doesn't follow its steps, and en_read_encoder() adds it to the time-aligned count.
+ *
+ *	The owner of the encoder (the kinematics or the board) calls en_set_external_steps() from
+ *	its read callback with the reading converted to motor steps. The first reading, and the
+ *	first one after en_zero_external_encoders(), sets the offset between the two.
  */
 
-float en_read_encoder(uint8_t motor) { return ((float)en.en[motor].encoder_steps); }
+void en_set_external_steps(uint8_t motor, float steps) {
+    enEncoder_t &e = en.en[motor];
+    __disable_irq();                                // the DDA can't step between the two reads
+    float counted = e.encoder_steps + e.steps_run;
+    __enable_irq();
+
+    if (!e.external || e.external_zero) {
+        e.external_offset = steps - counted;
+        e.external_zero = false;
+        e.external = true;
+    }
+    e.slip = steps - e.external_offset - counted;
+}
+
+void en_zero_external_encoders() {
+    for (uint8_t m = 0; m < MOTORS; m++) {
+        en.en[m].external_zero = true;
+        en.en[m].slip = 0;
+    }
+}
+
+bool en_has_external_encoder(uint8_t motor) { return (en.en[motor].external); }
 
 /*
  * en_take_encoder_snapshot()
@@ -100,9 +142,18 @@ float en_read_encoder(uint8_t motor) { return ((float)en.en[motor].encoder_steps
  *
  *  The results are in STEPS, which may need to be converted back to position using
  *  forward kinematics, depending on your use. See probe cycle for example.
+ *
+ *  The snapshot is resolved below one step by adding the phase of each motor's DDA (see
+ *  st_get_substep_phase()), so the captured position does not depend on how far the motor
+ *  happens to be between steps. Interrupts are disabled so the DDA can't step a motor
+ *  between reading its counts and its phase.
  */
 void en_take_encoder_snapshot() {
-    for (uint8_t m = 0; m < MOTORS; m++) { en.snapshot[m] = en.en[m].encoder_steps + en.en[m].steps_run; }
+    __disable_irq();
+    for (uint8_t m = 0; m < MOTORS; m++) {
+        en.snapshot[m] = en.en[m].encoder_steps + en.en[m].steps_run + en.en[m].step_sign * st_get_substep_phase(m);
+    }
+    __enable_irq();
 
     /* loop unrolled version for faster execution
         en.snapshot[MOTOR_1] = en.en[MOTOR_1].encoder_steps + en.en[MOTOR_1].steps_run;
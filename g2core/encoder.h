@@ -108,6 +108,10 @@ typedef struct enEncoder {          // one real or virtual encoder per controlle
     int8_t  step_sign;              // set to +1 or -1
     int16_t steps_run;              // + or - steps counted during stepper interrupt
     int32_t encoder_steps;          // counted encoder position	in steps
+    bool    external;               // a real encoder reports this motor's position (see en_set_external_steps())
+    bool    external_zero;          // take the next real reading as agreeing with the count
+    float   external_offset;        // real minus counted steps when last zeroed
+    float   slip;                   // real minus counted steps since then - steps lost or gained
 } enEncoder_t;
 
 typedef struct enEncoders {
@@ -130,6 +134,10 @@ stat_t encoder_test_assertions(void);
 void en_set_encoder_steps(uint8_t motor, float steps);
 float en_read_encoder(uint8_t motor);
 
+void en_set_external_steps(uint8_t motor, float steps);
+void en_zero_external_encoders();
+bool en_has_external_encoder(uint8_t motor);
+
 void en_take_encoder_snapshot();
 float en_get_encoder_snapshot_steps(uint8_t motor);
 float* en_get_encoder_snapshot_vector();
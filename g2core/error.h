@@ -356,8 +356,8 @@ char *get_status_message(stat_t status);
 #define STAT_HOMING_ERROR_NEGATIVE_LATCH_BACKOFF 245
 #define STAT_HOMING_ERROR_HOMING_INPUT_MISCONFIGURED 246
 #define STAT_HOMING_ERROR_MUST_CLEAR_SWITCHES_BEFORE_HOMING 247
-#define STAT_ERROR_248 248
-#define STAT_ERROR_249 249
+#define STAT_HOMING_ERROR_SWITCH_NOT_FOUND 248
+#define STAT_HOMING_ERROR_NO_STALL_DETECTION 249
 
 #define STAT_PROBE_CYCLE_FAILED 250             // probing cycle did not complete
 #define STAT_PROBE_TRAVEL_TOO_SMALL 251
@@ -645,8 +645,8 @@ static const char stat_244[] = "Homing Err - Travel min & max are the same";
 static const char stat_245[] = "245";
 static const char stat_246[] = "Homing Err - Homing input is misconfigured";
 static const char stat_247[] = "Homing Err - Must clear switches before homing";
-static const char stat_248[] = "248";
-static const char stat_249[] = "249";
+static const char stat_248[] = "Homing Err - Switch not found";
+static const char stat_249[] = "Homing Err - Axis has no stall detection";
 
 static const char stat_250[] = "Probe cycle failed";
 static const char stat_251[] = "Probe travel is too small";
@@ -48,6 +48,7 @@
 
 #define __DIAGNOSTICS               // enables various debug functions
 #define __DIAGNOSTIC_PARAMETERS     // enables system diagnostic parameters (_xx) in config_app
+//#define __TRACE                   // enables binary event trace ring drained to the secondary channel (see trace.h)
 
 /******************************************************************************
  ***** APPLICATION DEFINITIONS ************************************************
@@ -40,7 +40,8 @@ typedef enum {                          // G Modal Group 1
     MOTION_MODE_CANNED_CYCLE_86,        // G86 - boring, spindle stop, rapid out
     MOTION_MODE_CANNED_CYCLE_87,        // G87 - back boring
     MOTION_MODE_CANNED_CYCLE_88,        // G88 - boring, spindle stop, manual out
-    MOTION_MODE_CANNED_CYCLE_89         // G89 - boring, dwell, feed out
+    MOTION_MODE_CANNED_CYCLE_89,        // G89 - boring, dwell, feed out
+    MOTION_MODE_CANNED_CYCLE_73         // G73 - high speed (chip breaking) peck drilling
 } cmMotionMode;
 
 typedef enum {              // canonical plane - translates to:
@@ -84,6 +85,11 @@ typedef enum {
     INCREMENTAL_DISTANCE_MODE   // G91 / G91.1
 } cmDistanceMode;
 
+typedef enum {
+    RETRACT_TO_INITIAL_LEVEL = 0, // G98 - canned cycles retract to the level the cycle started from
+    RETRACT_TO_R_LEVEL          // G99 - canned cycles retract to the R level
+} cmRetractMode;
+
 typedef enum {
     INVERSE_TIME_MODE = 0,   // G93
     UNITS_PER_MINUTE_MODE,   // G94
@@ -191,6 +197,7 @@ struct GCodeState_t {             // Gcode model state - used by model, planning
 
     float spindle_speed;                // S - spindle "speed" in arbitrary units, often RPM
     spDirection spindle_direction;      // M3/M4/M5 - spindle on CW, on CCW, off setting
+    uint8_t raster;                     // raster scanline claimed by this G1 (slot+1), 0 if none. See raster.h
 
     void reset() {
         linenum = 0;
@@ -215,6 +222,7 @@ struct GCodeState_t {             // Gcode model state - used by model, planning
         motion_profile = PROFILE_NORMAL;
         tool = 0;
         tool_select = 0;
+        raster = 0;
 
     };
 };
@@ -239,6 +247,7 @@ typedef struct GCodeStateExtended {     // Gcode dynamic state extensions - used
     uint8_t planning_mode;              // 2=2d planning, 3=3d planning (default), 4? 2d with B axis?
 
     bool g92_offset_enable;             // G92 offsets enabled/disabled.  0=disabled, 1=enabled
+    cmRetractMode retract_mode;         // G98/G99 canned cycle return mode
     bool block_delete_switch;           // set true to enable block deletes (true is default)
 
     uint16_t magic_end;
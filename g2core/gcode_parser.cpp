@@ -41,7 +41,7 @@ static stat_t _execute_gcode_block_marlin(void);
 
 typedef enum {                          // Used for detecting gcode errors. See NIST section 3.4
     MODAL_GROUP_G0 = 0,                 // {G10,G28,G28.1,G92}  non-modal axis commands (note 1)
-    MODAL_GROUP_G1,                     // {G0,G1,G2,G3,G80}    motion
+    MODAL_GROUP_G1,                     // {G0,G1,G2,G3,G73,G80-G83} motion
     MODAL_GROUP_G2,                     // {G17,G18,G19}        plane selection
     MODAL_GROUP_G3,                     // {G90,G91}            distance mode
     MODAL_GROUP_G5,                     // {G93,G94}            feed rate mode
@@ -116,15 +116,16 @@ typedef enum {                                  // these are in order to optimiz
 typedef struct GCodeInputValue {    // Gcode inputs - meaning depends on context
 
     gpNextAction next_action;       // handles G modal group 1 moves & non-modals
-    cmMotionMode motion_mode;       // Group1: G0, G1, G2, G3, G38.2, G80, G81, G82, G83, G84, G85, G86, G87, G88, G89
+    cmMotionMode motion_mode;       // Group1: G0, G1, G2, G3, G38.2, G73, G80, G81, G82, G83, G84, G85, G86, G87, G88, G89
     uint8_t program_flow;           // used only by the gcode_parser
     uint32_t linenum;               // gcode N word
 
     float target[AXES];             // XYZABC where the move should go
     float arc_offset[3];            // IJK - used by arc commands
-    float arc_radius;               // R word - radius value in arc radius mode
+    float arc_radius;               // R word - radius value in arc radius mode, R level in canned cycles
     float F_word;                   // F word - feedrate as present in the F word (will be normalized later)
     float P_word;                   // P word - parameter used for dwell time in seconds, G10 commands
+    float Q_word;                   // Q word - peck increment in canned cycles
     float S_word;                   // S word - usually in RPM
     uint8_t H_word;                 // H word - used by G43s
     uint8_t L_word;                 // L word - used by G10s
@@ -136,6 +137,7 @@ typedef struct GCodeInputValue {    // Gcode inputs - meaning depends on context
     uint8_t path_control;           // G61... EXACT_PATH, EXACT_STOP, CONTINUOUS
     uint8_t distance_mode;          // G91   0=use absolute coords(G90), 1=incremental movement
     uint8_t arc_distance_mode;      // G90.1=use absolute IJK offsets, G91.1=incremental IJK offsets
+    uint8_t retract_mode;           // G98=retract to initial level, G99=retract to R level
     uint8_t origin_offset_mode;     // G92...TRUE=in origin offset mode
     uint8_t absolute_override;      // G53 TRUE = move using machine coordinates - this block only (G53)
 
@@ -172,6 +174,7 @@ typedef struct GCodeFlags {         // Gcode input flags
 
     bool F_word;
     bool P_word;
+    bool Q_word;
     bool S_word;
     bool H_word;
     bool L_word;
@@ -183,6 +186,7 @@ typedef struct GCodeFlags {         // Gcode input flags
     bool path_control;
     bool distance_mode;
     bool arc_distance_mode;
+    bool retract_mode;
     bool origin_offset_mode;
     bool absolute_override;
 
@@ -225,6 +229,7 @@ static stat_t _verify_checksum(char *str);
 static stat_t _validate_gcode_block(char *active_comment);
 static stat_t _parse_gcode_block(char *line, char *active_comment); // Parse the block into the GN/GF structs
 static stat_t _execute_gcode_block(char *active_comment);           // Execute the gcode block
+static stat_t _execute_gcode_block_seek(void);                      // Execute motion model-only while seeking
 
 #define SET_MODAL(m,parm,val) ({gv.parm=val; gf.parm=true; gp.modals[m]=true; break;})
 #define SET_NON_MODAL(parm,val) ({gv.parm=val; gf.parm=true; break;})
@@ -747,7 +752,11 @@ static stat_t _parse_gcode_block(char *buf, char *active_comment)
                     break;
                 }
                 case 64: SET_MODAL (MODAL_GROUP_G13,path_control, PATH_CONTINUOUS);
+                case 73: SET_MODAL (MODAL_GROUP_G1, motion_mode,  MOTION_MODE_CANNED_CYCLE_73);
                 case 80: SET_MODAL (MODAL_GROUP_G1, motion_mode,  MOTION_MODE_CANCEL_MOTION_MODE);
+                case 81: SET_MODAL (MODAL_GROUP_G1, motion_mode,  MOTION_MODE_CANNED_CYCLE_81);
+                case 82: SET_MODAL (MODAL_GROUP_G1, motion_mode,  MOTION_MODE_CANNED_CYCLE_82);
+                case 83: SET_MODAL (MODAL_GROUP_G1, motion_mode,  MOTION_MODE_CANNED_CYCLE_83);
                 case 90: {
                     switch (_point(value)) {
                         case 0: SET_MODAL (MODAL_GROUP_G3, distance_mode, ABSOLUTE_DISTANCE_MODE);
@@ -777,6 +786,8 @@ static stat_t _parse_gcode_block(char *buf, char *active_comment)
                 case 93: SET_MODAL (MODAL_GROUP_G5, feed_rate_mode, INVERSE_TIME_MODE);
                 case 94: SET_MODAL (MODAL_GROUP_G5, feed_rate_mode, UNITS_PER_MINUTE_MODE);
 //              case 95: SET_MODAL (MODAL_GROUP_G5, feed_rate_mode, UNITS_PER_REVOLUTION_MODE);
+                case 98: SET_MODAL (MODAL_GROUP_G9, retract_mode, RETRACT_TO_INITIAL_LEVEL);
+                case 99: SET_MODAL (MODAL_GROUP_G9, retract_mode, RETRACT_TO_R_LEVEL);
 
                 default: status = STAT_GCODE_COMMAND_UNSUPPORTED;
             }
@@ -855,6 +866,7 @@ static stat_t _parse_gcode_block(char *buf, char *active_comment)
             case 'T': SET_NON_MODAL (tool_select, (uint8_t)trunc(value));
             case 'F': SET_NON_MODAL (F_word, value);
             case 'P': SET_NON_MODAL (P_word, value);                // used for dwell time, G10 coord select
+            case 'Q': SET_NON_MODAL (Q_word, value);                // used for canned cycle peck increment
             case 'S': SET_NON_MODAL (S_word, value);
             case 'X': SET_NON_MODAL (target[AXIS_X], value);
             case 'Y': SET_NON_MODAL (target[AXIS_Y], value);
@@ -923,7 +935,7 @@ static stat_t _parse_gcode_block(char *buf, char *active_comment)
  *    19a. homing functions (G28.2, G28.3, G28.1, G28, G30)
  *    19b. update system data (G10)
  *    19c. set axis offsets (G92, G92.1, G92.2, G92.3)
- *    20. perform motion (G0 to G3, G80-G89) as modified (possibly) by G53
+ *    20. perform motion (G0 to G3, G73, G80-G89) as modified (possibly) by G53
  *    21. stop and end (M0, M1, M2, M30, M60)
  *
  *  Values in gv are in original units and should not be unit converted prior
@@ -938,6 +950,17 @@ stat_t _execute_gcode_block(char *active_comment)
         cm_set_model_linenum(gv.linenum);
     }
 
+    bool model_only = false;                                // seeking to a restart line
+    if (cm->seek.active) {
+        if (gf.linenum) {
+            cm->seek.line = gv.linenum;
+        }
+        model_only = (cm->seek.line < cm->seek.target_line);
+        if (!model_only) {
+            ritorno(cm_seek_finish());                      // approach the restart point, then run this block
+        }
+    }
+
     EXEC_FUNC(cm_m48_enable, m48_enable);
 
     ////##fro
@@ -960,24 +983,47 @@ stat_t _execute_gcode_block(char *active_comment)
         ritorno(cm_check_linenum());
     }
 
-    EXEC_FUNC(spindle_set_speed, S_word);                  // S
-    EXEC_FUNC(cm_select_tool, tool_select);                 // T - tool_select is where it's written
-    EXEC_FUNC(cm_change_tool, tool_change);                 // M6 - is where it's effected
+    if (model_only) {                                       // record spindle, tool and coolant for cm_seek_finish()
+        if (gf.S_word) {
+            cm->seek.spindle_speed = gv.S_word;
+            cm->seek.spindle_speed_set = true;
+        }
+        if (gf.tool_select) {                               // T
+            if (gv.tool_select > TOOLS) {
+                return (STAT_T_WORD_IS_INVALID);
+            }
+            cm->seek.tool_select = gv.tool_select;
+            cm->seek.tool_select_set = true;
+        }
+        if (gf.tool_change) {                               // M6
+            cm->seek.tool_change = true;
+        }
+        if (gf.spindle_control) {
+            cm->seek.spindle_direction = gv.spindle_control;
+        }
+        if (gf.coolant_mist)  { cm->seek.mist  = (gv.coolant_mist == COOLANT_ON); }
+        if (gf.coolant_flood) { cm->seek.flood = (gv.coolant_flood == COOLANT_ON); }
+        if (gf.coolant_off)   { cm->seek.mist  = cm->seek.flood = false; }
+    } else {
+        EXEC_FUNC(spindle_set_speed, S_word);              // S
+        EXEC_FUNC(cm_select_tool, tool_select);             // T - tool_select is where it's written
+        EXEC_FUNC(cm_change_tool, tool_change);             // M6 - is where it's effected
 
-    if (gf.spindle_control) {                               // M3, M4, M5 (spindle OFF, CW, CCW)
-        ritorno(spindle_set_direction(gv.spindle_control));
-    }
-    if (gf.coolant_mist) {
-        ritorno(coolant_control_sync((coControl)gv.coolant_mist, COOLANT_MIST));    // M7
-    }
-    if (gf.coolant_flood) {
-        ritorno(coolant_control_sync((coControl)gv.coolant_flood, COOLANT_FLOOD));  // M8
-    }
-    if (gf.coolant_off) {
-        ritorno(coolant_control_sync((coControl)gv.coolant_off, COOLANT_BOTH));     // M9
-    }
-    if (gv.next_action == NEXT_ACTION_DWELL) {              // G4 - dwell
-        ritorno(cm_dwell(gv.P_word));                       // return if error, otherwise complete the block
+        if (gf.spindle_control) {                           // M3, M4, M5 (spindle OFF, CW, CCW)
+            ritorno(spindle_set_direction(gv.spindle_control));
+        }
+        if (gf.coolant_mist) {
+            ritorno(coolant_control_sync((coControl)gv.coolant_mist, COOLANT_MIST));    // M7
+        }
+        if (gf.coolant_flood) {
+            ritorno(coolant_control_sync((coControl)gv.coolant_flood, COOLANT_FLOOD));  // M8
+        }
+        if (gf.coolant_off) {
+            ritorno(coolant_control_sync((coControl)gv.coolant_off, COOLANT_BOTH));     // M9
+        }
+        if (gv.next_action == NEXT_ACTION_DWELL) {          // G4 - dwell
+            ritorno(cm_dwell(gv.P_word));                   // return if error, otherwise complete the block
+        }
     }
     EXEC_FUNC(cm_select_plane, select_plane);               // G17, G18, G19
     EXEC_FUNC(cm_set_units_mode, units_mode);               // G20, G21
@@ -1007,7 +1053,11 @@ stat_t _execute_gcode_block(char *active_comment)
 
     EXEC_FUNC(cm_set_distance_mode, distance_mode);         // G90, G91
     EXEC_FUNC(cm_set_arc_distance_mode, arc_distance_mode); // G90.1, G91.1
-    //--> set retract mode goes here
+    EXEC_FUNC(cm_set_retract_mode, retract_mode);           // G98, G99
+
+    if (model_only) {
+        return (_execute_gcode_block_seek());
+    }
 
     switch (gv.next_action) {
         case NEXT_ACTION_SET_G28_POSITION:  { status = cm_set_g28_position(); break;}                               // G28.1
@@ -1052,6 +1102,17 @@ stat_t _execute_gcode_block(char *active_comment)
                                                                         gv.motion_mode);
                                             break;
                                           }
+                case MOTION_MODE_CANNED_CYCLE_73:                                                                   // G73
+                case MOTION_MODE_CANNED_CYCLE_81:                                                                   // G81
+                case MOTION_MODE_CANNED_CYCLE_82:                                                                   // G82
+                case MOTION_MODE_CANNED_CYCLE_83: { status = cm_drill_cycle_global(gv.target,     gf.target,        // G83
+                                                                                   gv.arc_radius, gf.arc_radius,
+                                                                                   gv.Q_word,     gf.Q_word,
+                                                                                   gv.P_word,     gf.P_word,
+                                                                                   gv.L_word,     gf.L_word,
+                                                                                   gv.motion_mode);
+                                                    break;
+                                                  }
                 default: break;
             }
             cm_set_absolute_override(MODEL, ABSOLUTE_OVERRIDE_OFF);  // un-set absolute override once the move is planned
@@ -1072,6 +1133,63 @@ stat_t _execute_gcode_block(char *active_comment)
     return (status);
 }
 
+/***********************************************************************************
+ * _execute_gcode_block_seek() - steps 19 and 20 of a block before the seek line
+ *
+ *  Stored positions, G10 and G92 offsets are applied as usual. Motion only moves the
+ *  model position. Canned cycles record their sticky words and end over the last hole
+ *  at the clear level, as they would running. Homing, probing, JSON commands and
+ *  program stops and ends are skipped.
+ */
+
+static stat_t _execute_gcode_block_seek()
+{
+    stat_t status = STAT_OK;
+
+    switch (gv.next_action) {
+        case NEXT_ACTION_SET_G28_POSITION:  { status = cm_set_g28_position(); break;}                   // G28.1
+        case NEXT_ACTION_GOTO_G28_POSITION: { status = cm_seek_goto_position(cm->gmx.g28_position); break;}// G28
+        case NEXT_ACTION_SET_G30_POSITION:  { status = cm_set_g30_position(); break;}                   // G30.1
+        case NEXT_ACTION_GOTO_G30_POSITION: { status = cm_seek_goto_position(cm->gmx.g30_position); break;}// G30
+
+        case NEXT_ACTION_SET_G10_DATA:           { status = cm_set_g10_data(gv.P_word, gf.P_word,   // G10
+                                                                            gv.L_word, gf.L_word,
+                                                                            gv.target, gf.target); break;}
+
+        case NEXT_ACTION_SET_G92_OFFSETS:     { status = cm_set_g92_offsets(gv.target, gf.target); break;}      // G92
+        case NEXT_ACTION_RESET_G92_OFFSETS:   { status = cm_reset_g92_offsets(); break;}                        // G92.1
+        case NEXT_ACTION_SUSPEND_G92_OFFSETS: { status = cm_suspend_g92_offsets(); break;}                      // G92.2
+        case NEXT_ACTION_RESUME_G92_OFFSETS:  { status = cm_resume_g92_offsets(); break;}                       // G92.3
+
+        case NEXT_ACTION_DEFAULT: {
+            cm_set_absolute_override(MODEL, gv.absolute_override);
+            switch (gv.motion_mode) {
+                case MOTION_MODE_CANCEL_MOTION_MODE: { cm->gm.motion_mode = gv.motion_mode; break;}     // G80
+                case MOTION_MODE_STRAIGHT_TRAVERSE:                                                     // G0
+                case MOTION_MODE_STRAIGHT_FEED:                                                         // G1
+                case MOTION_MODE_CW_ARC:                                                                // G2
+                case MOTION_MODE_CCW_ARC: { status = cm_seek_move_global(gv.target, gf.target, gv.motion_mode); break;} // G3
+                case MOTION_MODE_CANNED_CYCLE_73:                                                       // G73
+                case MOTION_MODE_CANNED_CYCLE_81:                                                       // G81
+                case MOTION_MODE_CANNED_CYCLE_82:                                                       // G82
+                case MOTION_MODE_CANNED_CYCLE_83: { status = cm_drill_cycle_seek(gv.target,     gf.target,  // G83
+                                                                                 gv.arc_radius, gf.arc_radius,
+                                                                                 gv.Q_word,     gf.Q_word,
+                                                                                 gv.P_word,     gf.P_word,
+                                                                                 gv.L_word,     gf.L_word,
+                                                                                 gv.motion_mode);
+                                                    break;
+                                                  }
+                default: break;
+            }
+            cm_set_absolute_override(MODEL, ABSOLUTE_OVERRIDE_OFF);
+        }
+        default:
+            break;
+    }
+    return (status);
+}
+
 /***********************************************************************************
  * _execute_gcode_block_marlin() - collect Marlin Gcode execution functions here
  */
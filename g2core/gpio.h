@@ -38,6 +38,7 @@
 // Note: "board_gpio.h" is included at the end of this file
 
 #include <utility> // for std::forward
+#include <algorithm> // for std::min, std::max
 
 #include "MotatePins.h"
 using Motate::kPullUp;
@@ -1139,7 +1140,81 @@ struct ValueHistory {
     };
 };
 
-template <typename ADCPin_t>
+// constant-time alternative to ValueHistory
+//
+// ValueHistory::value() rescans every sample to drop outliers whenever a new sample
+// has arrived. ClippedValueHistory makes the outlier decision once, as each sample
+// arrives: the sample is clamped to rolling_mean +- variance_max * std_dev of the
+// window so far, and the clamped value goes into a second rolling sum. Both
+// add_sample() and value() are O(1) regardless of sample_count.
+//
+// The result differs from ValueHistory in that outliers are limited (winsorized)
+// rather than dropped, and each one is judged against the window as it was when it
+// arrived. Until half the window is filled samples are taken unclamped.
+template<uint16_t sample_count>
+struct ClippedValueHistory {
+
+    float variance_max = 2.0;
+    ClippedValueHistory() {};
+    ClippedValueHistory(float v_max) : variance_max{v_max} {};
+
+    struct sample_t {
+        float value;
+        float value_sq;
+        float clipped;
+    };
+    sample_t samples[sample_count];
+    uint16_t next_sample = 0;
+    uint16_t sampled = 0;
+
+    float rolling_sum = 0;
+    float rolling_sum_sq = 0;
+    float rolling_mean = 0;
+    float clipped_sum = 0;
+
+    void add_sample(float t) {
+        float clipped = t;
+        if (sampled >= (sample_count / 2)) {
+            float limit = variance_max * get_std_dev();
+            clipped = std::min(std::max(t, rolling_mean - limit), rolling_mean + limit);
+        }
+
+        sample_t &s = samples[next_sample];
+        if (sampled == sample_count) {          // drop the oldest sample
+            rolling_sum -= s.value;
+            rolling_sum_sq -= s.value_sq;
+            clipped_sum -= s.clipped;
+        } else {
+            ++sampled;
+        }
+        s.value = t;
+        s.value_sq = t*t;
+        s.clipped = clipped;
+        rolling_sum += s.value;
+        rolling_sum_sq += s.value_sq;
+        clipped_sum += s.clipped;
+
+        if (++next_sample == sample_count) {
+            next_sample = 0;
+        }
+        rolling_mean = rolling_sum/(float)sampled;
+    };
+
+    float get_std_dev() {
+        // POPULATION standard deviation, as in ValueHistory
+        float variance = (rolling_sum_sq/(float)sampled) - (rolling_mean*rolling_mean);
+        return std::sqrt(std::abs(variance));
+    };
+
+    float value() {
+        if (sampled == 0) {
+            return 0;
+        }
+        return clipped_sum/(float)sampled;
+    };
+};
+
+template <typename ADCPin_t, typename History_t = ValueHistory<20>>
 struct gpioAnalogInputPin : gpioAnalogInput {
 protected: // so we know if anyone tries to reach in
     ioEnabled enabled;                  // -1=unavailable, 0=disabled, 1=enabled
@@ -1151,7 +1226,7 @@ protected: // so we know if anyone tries to reach in
     uint8_t proxy_pin_number;                 // optional external number to access this pin ("ain" + proxy_pin_number)
 
     const float variance_max = 1.1;
-    ValueHistory<20> history {variance_max};
+    History_t history {variance_max};   // ValueHistory<20> or ClippedValueHistory<20>
 
     float last_raw_value;
 
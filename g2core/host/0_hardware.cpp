@@ -0,0 +1,285 @@
+/*
+ * hardware.cpp - general hardware support functions
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  The host board's "hardware" is a virtual clock. The main loop calls hardware_periodic()
+ *  once per pass, and that is where time passes:
+ *
+ *    - Pending exec and forward planning interrupts are run (exec first, as it has the
+ *      higher priority on a board). They are also run after every DDA tick, so the
+ *      runtime is never starved by the host the way it could be by a slow main loop.
+ *
+ *    - A pass that read a line or queued a block takes no time. The sender is assumed to
+ *      keep up and the parser and planner to be infinitely fast, so time only passes when
+ *      the main loop is waiting on the motion.
+ *
+ *    - Any other pass advances one millisecond: FREQUENCY_DDA/1000 DDA interrupts, then a
+ *      SysTick so dwells, spindle ramps and timeouts run. While the planner is full nothing
+ *      the main loop does can change until a block finishes, so up to
+ *      EST_MAX_FAST_FORWARD_MS are run in one pass.
+ */
+
+#include "g2core.h"  // #1
+#include "config.h"  // #2
+#include "hardware.h"
+#include "controller.h"
+#include "text_parser.h"
+#include "planner.h"
+#include "stepper.h"
+#include "spindle.h"
+
+#include "MotateUtilities.h"
+#include "MotateUniqueID.h"
+#include "MotatePower.h"
+
+#include "board_gpio.h"
+#include "board_stepper.h"
+#include "g2est.h"
+
+#include <stdlib.h>
+
+#ifndef SPINDLE_SPEED_CHANGE_PER_MS
+#define SPINDLE_SPEED_CHANGE_PER_MS 7
+#endif
+
+#define DDA_TICKS_PER_MS (FREQUENCY_DDA / 1000)
+
+#include "safety_manager.h"
+SafetyManager sm{};
+SafetyManager *safety_manager = &sm;
+
+#include "esc_spindle.h"
+ESCSpindle esc_spindle {SPINDLE_PWM_NUMBER, SPINDLE_ENABLE_OUTPUT_NUMBER, SPINDLE_DIRECTION_OUTPUT_NUMBER, SPINDLE_SPEED_CHANGE_PER_MS, SPINDLE_SPINUP_DELAY};
+
+ToolHead *toolhead_for_tool(uint8_t tool) {
+    return &esc_spindle;
+}
+
+#if KINEMATICS==KINE_OTHER
+// Boards with a laser toolhead use it as their kinematics so it can fire from the DDA.
+// There is no laser here and the laser doesn't change how the moves are timed.
+#include "kinematics_cartesian.h"
+CartesianKinematics<AXES, MOTORS> host_kinematics;
+KinematicsBase<AXES, MOTORS> *kn = &host_kinematics;
+#endif
+
+// Motate objects the core expects the platform to provide
+namespace Motate {
+    SysTickTimer_t SysTickTimer;
+    UUID_t UUID;
+
+    void System::reset(bool bootloader) {
+        fprintf(stderr, "%s: firmware requested a %s\n", est.path, bootloader ? "flash loader" : "reset");
+        exit(EST_ERROR_ALARM);
+    }
+}
+static SysTick_Type _systick;
+SysTick_Type *const SysTick = &_systick;
+
+/*
+ * hardware_init() - lowest level hardware init
+ */
+
+void hardware_init()
+{
+    toolhead_for_tool(0)->init();
+    spindle_set_toolhead(toolhead_for_tool(0));
+    return;
+}
+
+/*
+ * _service_interrupts() - run the software interrupts that have been requested
+ * _advance_one_ms()     - run one millisecond of DDA ticks and one SysTick
+ * hardware_periodic()   - callback from the main loop - runs the virtual clock
+ */
+
+static void _service_interrupts()
+{
+    while (exec_timer_type::interrupt_pending || fwd_plan_timer_type::interrupt_pending) {
+        if (exec_timer_type::interrupt_pending) {
+            exec_timer_type::interrupt();
+        } else {
+            fwd_plan_timer_type::interrupt();
+        }
+    }
+}
+
+static void _advance_one_ms()
+{
+    bool busy = st_runtime_isbusy();
+    for (uint32_t tick = 0; (tick < DDA_TICKS_PER_MS) && st_runtime_isbusy(); tick++) {
+        dda_timer_type::interrupt();            // an idle DDA only clears its step pins - skip it
+        _service_interrupts();
+    }
+    SysTickTimer.tick();
+    _service_interrupts();
+    est_ms_elapsed(busy);
+}
+
+stat_t hardware_periodic()
+{
+    static uint8_t free_buffers = 0;
+
+    _service_interrupts();
+    est_check_job();                            // exits when the job is done or has failed
+
+    uint8_t buffers = mp_get_planner_buffers(mp);
+    bool queued = (buffers < free_buffers);
+    free_buffers = buffers;
+    if (est.line_read || queued) {              // the main loop is working, not waiting
+        est.line_read = false;
+        return (STAT_OK);
+    }
+
+    uint8_t ms = 0;
+    do {
+        _advance_one_ms();
+    } while (mp_planner_is_full(mp) && (++ms < EST_MAX_FAST_FORWARD_MS));
+    free_buffers = mp_get_planner_buffers(mp);
+    return (STAT_OK);
+}
+
+/*
+ * hw_hard_reset() - hard reset using ARM reset core
+ */
+
+void hw_hard_reset(void)
+{
+    Motate::System::reset(/*bootloader: */ false);  // arg=0 resets the system
+}
+
+/*
+ * hw_flash_loader() - enter flash loader to reflash board
+ */
+
+void hw_flash_loader(void)
+{
+    Motate::System::reset(/*bootloader: */ true);   // arg=1 erases FLASH and enters FLASH loader
+}
+
+/*
+ * _get_id() - get a human readable signature
+ */
+
+void _get_id(char *id)
+{
+    char *p = id;
+    const char *uuid = Motate::UUID;
+
+    Motate::strncpy(p, uuid, Motate::strlen(uuid)+1);
+}
+
+/***** END OF SYSTEM FUNCTIONS *****/
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+/*
+ * hw_get_fb()  - get firmware build number
+ * hw_get_fv()  - get firmware version number
+ * hw_get_hp()  - get hardware platform string
+ * hw_get_hv()  - get hardware version string
+ * hw_get_fbs() - get firmware build string
+ */
+
+stat_t hw_get_fb(nvObj_t *nv) { return (get_float(nv, cs.fw_build)); }
+stat_t hw_get_fv(nvObj_t *nv) { return (get_float(nv, cs.fw_version)); }
+stat_t hw_get_hp(nvObj_t *nv) { return (get_string(nv, G2CORE_HARDWARE_PLATFORM)); }
+stat_t hw_get_hv(nvObj_t *nv) { return (get_string(nv, G2CORE_HARDWARE_VERSION)); }
+stat_t hw_get_fbs(nvObj_t *nv) { return (get_string(nv, G2CORE_FIRMWARE_BUILD_STRING)); }
+
+/*
+ * hw_get_fbc() - get configuration settings file
+ */
+
+stat_t hw_get_fbc(nvObj_t *nv)
+{
+    nv->valuetype = TYPE_STRING;
+#ifdef SETTINGS_FILE
+#define settings_file_string1(s) #s
+#define settings_file_string2(s) settings_file_string1(s)
+    ritorno(nv_copy_string(nv, settings_file_string2(SETTINGS_FILE)));
+#undef settings_file_string1
+#undef settings_file_string2
+#else
+    ritorno(nv_copy_string(nv, "<default-settings>"));
+#endif
+
+    return (STAT_OK);
+}
+
+/*
+ * hw_get_id() - get device ID (signature)
+ */
+
+stat_t hw_get_id(nvObj_t *nv)
+{
+	char tmp[SYS_ID_LEN];
+	_get_id(tmp);
+	nv->valuetype = TYPE_STRING;
+	ritorno(nv_copy_string(nv, tmp));
+	return (STAT_OK);
+}
+
+/*
+ * hw_flash() - invoke FLASH loader from command input
+ */
+
+stat_t hw_flash(nvObj_t *nv)
+{
+    hw_flash_loader();
+	return(STAT_OK);
+}
+
+constexpr cfgSubtableFromStaticArray sys_config_3{};
+const configSubtable * const getSysConfig_3() { return &sys_config_3; }
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+    static const char fmt_fb[] =  "[fb]  firmware build%18.2f\n";
+    static const char fmt_fv[] =  "[fv]  firmware version%16.2f\n";
+    static const char fmt_fbs[] = "[fbs] firmware build%34s\n";
+    static const char fmt_fbc[] = "[fbc] firmware config%33s\n";
+    static const char fmt_hp[] =  "[hp]  hardware platform%15s\n";
+    static const char fmt_hv[] =  "[hv]  hardware version%13s\n";
+    static const char fmt_id[] =  "[id]  g2core ID%37s\n";
+
+    void hw_print_fb(nvObj_t *nv)  { text_print(nv, fmt_fb);}   // TYPE_FLOAT
+    void hw_print_fv(nvObj_t *nv)  { text_print(nv, fmt_fv);}   // TYPE_FLOAT
+    void hw_print_fbs(nvObj_t *nv) { text_print(nv, fmt_fbs);}  // TYPE_STRING
+    void hw_print_fbc(nvObj_t *nv) { text_print(nv, fmt_fbc);}  // TYPE_STRING
+    void hw_print_hp(nvObj_t *nv)  { text_print(nv, fmt_hp);}   // TYPE_STRING
+    void hw_print_hv(nvObj_t *nv)  { text_print(nv, fmt_hv);}   // TYPE_STRING
+    void hw_print_id(nvObj_t *nv)  { text_print(nv, fmt_id);}   // TYPE_STRING
+
+#endif //__TEXT_MODE
@@ -0,0 +1,216 @@
+/*
+ * autotune_sim.cpp - heater relay autotune against a first-order-plus-dead-time plant
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  Usage: autotune_sim [-k gain] [-t tau] [-l dead_time] [-s set_point] [-a ambient]
+ *
+ *  Runs the heater PID from temperature_pid.h every TEMP_PID_PERIOD_MS against a
+ *  first-order-plus-dead-time (FOPDT) heater:
+ *
+ *      dT/dt = (k * u(t - l) - (T - ambient)) / tau
+ *
+ *  with u the PID output (0..1), k the rise above ambient at full power (C), tau
+ *  the time constant (s) and l the dead time (s). Defaults are a typical hot end.
+ *
+ *  1. Relay autotune at the set point. The measured ultimate gain and period are
+ *     printed next to the exact ones of the plant, where w*tau and w*l add up to pi.
+ *  2. A closed-loop step from ambient to the set point with the tuned gains:
+ *     overshoot and the time until it stays within TEMP_SETPOINT_HYSTERESIS.
+ *  3. The same tune with the heater fallen off the block (k / 20): the runaway check
+ *     has to fail the tune and raise the alarm, not let the relay heat forever.
+ */
+
+#include "g2core.h"  // #1
+#include "config.h"  // #2
+#include "canonical_machine.h"
+#include "util.h"
+#include "temperature_pid.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+
+/**** What the PID needs from the core ****/
+
+namespace Motate {
+    SysTickTimer_t SysTickTimer;
+}
+
+static int alarms = 0;
+
+stat_t cm_alarm(const stat_t status, const char *msg)
+{
+    printf("  alarm: %s\n", msg);
+    alarms++;
+    return (status);
+}
+
+/**** Simulated heater ****/
+
+#define SIM_PERIOD_S (TEMP_PID_PERIOD_MS / 1000.0)
+
+struct simHeater {
+    double k, tau, ambient;
+    double temperature;
+    std::vector<float> delay;           // outputs still in the dead time
+    size_t head = 0;
+
+    simHeater(const double k_, const double tau_, const double l, const double ambient_) :
+        k{k_}, tau{tau_}, ambient{ambient_}, temperature{ambient_},
+        delay(std::max((size_t)1, (size_t)lround(l / SIM_PERIOD_S)), 0) {}
+
+    // apply the output for one PID period, exactly (zero-order hold)
+    void advance(const float output) {
+        float u = delay[head];
+        delay[head] = output;
+        head = (head + 1) % delay.size();
+
+        double target = ambient + k * u;
+        temperature = target + (temperature - target) * exp(-SIM_PERIOD_S / tau);
+    }
+};
+
+// one PID period: read, compute, apply, and advance virtual time
+static float _step(PID &pid, simHeater &heater)
+{
+    float output = std::max(pid.getNewOutput(heater.temperature), 0.0f);
+    heater.advance(output);
+    for (int ms = 0; ms < TEMP_PID_PERIOD_MS; ms++) {
+        Motate::SysTickTimer.tick();
+    }
+    return (output);
+}
+
+// the exact ultimate point of the plant: atan(w*tau) + w*l = pi
+static void _ultimate(const double k, const double tau, const double l, double &ku, double &tu)
+{
+    double lo = 0, hi = M_PI / l;
+    for (int i = 0; i < 100; i++) {
+        double w = (lo + hi) / 2;
+        if (atan(w * tau) + w * l < M_PI) { lo = w; } else { hi = w; }
+    }
+    ku = sqrt(1 + (lo * tau) * (lo * tau)) / k;
+    tu = 2 * M_PI / lo;
+}
+
+static PID::TuneState _tune(PID &pid, simHeater &heater, const float set_point, double &seconds)
+{
+    pid._enable = true;
+    pid.startAutotune(set_point);
+    long periods = 0;
+    while (pid._tune_state == PID::TUNE_RUNNING) {
+        _step(pid, heater);
+        periods++;
+    }
+    seconds = periods * SIM_PERIOD_S;
+    return (pid._tune_state);
+}
+
+static const char *_tune_name(const PID::TuneState state)
+{
+    switch (state) {
+        case PID::TUNE_DONE:   { return ("done"); }
+        case PID::TUNE_FAILED: { return ("failed"); }
+        default:               { return ("off"); }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    double k = 250, tau = 60, l = 4, set_point = 200, ambient = 21;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "k:t:l:s:a:")) != -1) {
+        switch (opt) {
+            case 'k': { k = atof(optarg); break; }
+            case 't': { tau = atof(optarg); break; }
+            case 'l': { l = atof(optarg); break; }
+            case 's': { set_point = atof(optarg); break; }
+            case 'a': { ambient = atof(optarg); break; }
+            default:  {
+                fprintf(stderr, "usage: %s [-k gain] [-t tau] [-l dead_time] [-s set_point] [-a ambient]\n", argv[0]);
+                return (1);
+            }
+        }
+    }
+    if ((k <= 0) || (tau <= 0) || (l < SIM_PERIOD_S) || (set_point >= ambient + k)) {
+        fprintf(stderr, "need k > 0, tau > 0, dead time >= %g s and a set point below ambient + k\n", SIM_PERIOD_S);
+        return (1);
+    }
+    printf("plant     k %.1f C  tau %.1f s  dead time %.1f s  ambient %.1f C  set point %.1f C\n",
+           k, tau, l, ambient, set_point);
+
+    // 1. autotune
+    PID pid { 9.0, 0.11, 400.0, 0, TEMP_MIN_RISE_DEGREES_OVER_TIME };
+    simHeater heater(k, tau, l, ambient);
+    double seconds;
+    PID::TuneState state = _tune(pid, heater, set_point, seconds);
+    printf("autotune  %s after %.1f s\n", _tune_name(state), seconds);
+    if (state != PID::TUNE_DONE) {
+        return (1);
+    }
+    const float h = TEMP_AUTOTUNE_HYSTERESIS;
+    float a = (pid._tune_amplitude_sum / TEMP_AUTOTUNE_CYCLES) / 2;
+    float tu = (pid._tune_period_sum / TEMP_AUTOTUNE_CYCLES) * SIM_PERIOD_S;
+    float ku = (4 * (PID::output_max / 2)) / ((float)M_PI * std::sqrt(a*a - h*h));
+    double ku_exact, tu_exact;
+    _ultimate(k, tau, l, ku_exact, tu_exact);
+    printf("  Ku      %.4f   exact %.4f (%+.1f%%)\n", ku, ku_exact, (ku / ku_exact - 1) * 100);
+    printf("  Tu      %.1f s   exact %.1f s (%+.1f%%)\n", tu, tu_exact, (tu / tu_exact - 1) * 100);
+    printf("  gains   P %.4f  I %.6f  D %.4f   ({he1p} %.2f  {he1i} %.4f  {he1d} %.1f)\n",
+           pid._p_factor, pid._i_factor, pid._d_factor,
+           pid._p_factor * 100, pid._i_factor * 100, pid._d_factor * 100);
+
+    // 2. closed-loop step with the tuned gains
+    simHeater step_heater(k, tau, l, ambient);
+    pid._set_point = set_point;
+    pid._integral = 0;
+    pid._derivative = 0;
+    pid._previous_input = ambient;
+    pid._average_output = 0;
+    double peak = ambient, settled = -1;
+    const long periods = (long)(20 * (tau + l) / SIM_PERIOD_S);
+    for (long i = 0; i < periods; i++) {
+        _step(pid, step_heater);
+        peak = std::max(peak, step_heater.temperature);
+        if (std::abs(step_heater.temperature - set_point) > TEMP_SETPOINT_HYSTERESIS) {
+            settled = -1;
+        } else if (settled < 0) {
+            settled = (i + 1) * SIM_PERIOD_S;
+        }
+    }
+    printf("step      overshoot %.1f C, ", peak - set_point);
+    if (settled < 0) {
+        printf("not within %.1f C after %.0f s\n", TEMP_SETPOINT_HYSTERESIS, periods * SIM_PERIOD_S);
+    } else {
+        printf("within %.1f C from %.1f s\n", TEMP_SETPOINT_HYSTERESIS, settled);
+    }
+
+    // 3. runaway - the heater no longer reaches the set point
+    PID loose { 9.0, 0.11, 400.0, 0, TEMP_MIN_RISE_DEGREES_OVER_TIME };
+    simHeater loose_heater(k / 20, tau, l, ambient);
+    alarms = 0;
+    printf("runaway   heater at k/20\n");
+    state = _tune(loose, loose_heater, set_point, seconds);
+    printf("  autotune %s after %.1f s at %.1f C, %d alarm(s)\n",
+           _tune_name(state), seconds, loose_heater.temperature, alarms);
+
+    return (((state == PID::TUNE_FAILED) && (alarms > 0)) ? 0 : 1);
+}
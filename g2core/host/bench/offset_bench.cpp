@@ -0,0 +1,249 @@
+/*
+ * offset_bench.cpp - time a long G1 stream with and without the combined offset cache
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  Usage: offset_bench [-n blocks] [-r runs]
+ *
+ *  Feeds a stream of G1 X Y Z blocks through gcode_parser() with G55, a G92 offset
+ *  and a tool offset active, and reports the wall time per block in two ways:
+ *
+ *  - model only: the blocks are parsed with a seek armed ({seek:N}), so each one goes
+ *    through cm_set_model_target() and the model update but not the planner. This is
+ *    the part of the block the offsets are looked up in.
+ *  - planned: the blocks run normally down to mp_aline(). The planner is emptied with
+ *    planner_reset() when it fills, as nothing runs the moves out of it.
+ *
+ *  Each way is timed with the cache working, and with cm_invalidate_combined_offsets()
+ *  called before every block, so every block adds the offsets up again. The second is
+ *  close to the code before the cache, but a little faster: the old code added them up
+ *  once per axis word in cm_set_model_target() and once more for every axis in
+ *  cm_set_display_offsets(), where an invalid cache is rebuilt once per block. The
+ *  difference reported is a lower bound on what the cache saves.
+ *
+ *  The best of -r runs is reported for each. The end positions of the cached and
+ *  uncached runs are compared, as the cache must not change where a move goes.
+ *
+ *  This runs the firmware on the host board, like g2est, and links the same objects
+ *  less g2est.o. The globals g2est.cpp provides are provided here.
+ */
+
+#include "g2core.h"  // #1
+#include "config.h"  // #2
+#include "controller.h"
+#include "canonical_machine.h"
+#include "gcode_parser.h"
+#include "hardware.h"
+#include "persistence.h"
+#include "planner.h"
+#include "stepper.h"
+#include "coolant.h"
+#include "encoder.h"
+#include "spindle.h"
+#include "temperature.h"
+#include "gpio.h"
+#include "util.h"
+#include "xio.h"
+#include "g2est.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#define BENCH_BLOCK_LEN 48                  // room for one G1 X Y Z block
+
+/**** What g2est.cpp provides to the host board ****/
+
+stat_t status_code;                         // allocate a variable for the ritorno macro
+
+OutputPin<Motate::kDebug1_PinNumber> debug_pin1;
+OutputPin<Motate::kDebug2_PinNumber> debug_pin2;
+OutputPin<Motate::kDebug3_PinNumber> debug_pin3;
+OutputPin<Motate::kDebug4_PinNumber> debug_pin4;
+
+estJob_t est;
+
+char *get_status_message(stat_t status)
+{
+    return ((char *)GET_TEXT_ITEM(stat_msg, status));
+}
+
+void est_ms_elapsed(bool busy) {}
+void est_check_job() {}
+
+/**** Bench ****/
+
+typedef struct benchRun {
+    double ns;                              // best wall time per block
+    float position[AXES];                   // model position at the end of the stream
+} benchRun_t;
+
+static std::vector<char> blocks;            // the stream, BENCH_BLOCK_LEN per block
+static long block_count;
+
+static void _init_firmware()
+{
+    hardware_init();
+    persistence_init();
+    xio_init();
+
+    cm = &cm1;
+    cm->machine_state = MACHINE_INITIALIZING;
+    canonical_machine_inits();
+    stepper_init();
+    encoder_init();
+    gpio_init();
+
+    controller_init();
+    config_init();
+    canonical_machine_reset(&cm1);
+    gcode_parser_init();
+    spindle_init();
+    spindle_reset();
+    coolant_init();
+    coolant_reset();
+    temperature_init();
+    gpio_reset();
+}
+
+static void _parse(const char *block)
+{
+    char buf[BENCH_BLOCK_LEN];
+    strcpy(buf, block);                     // the parser works in place
+    stat_t status = gcode_parser(buf);
+    if (status != STAT_OK) {
+        fprintf(stderr, "\"%s\" failed with status %d\n", block, status);
+        exit(1);
+    }
+}
+
+/*
+ * _make_stream() - a zig-zag over a 40 mm square, stepping down and back up in Z
+ */
+
+static void _make_stream(const long count)
+{
+    block_count = count;
+    blocks.resize(count * BENCH_BLOCK_LEN);
+    for (long i = 0; i < count; i++) {
+        float x = (i & 1) ? 40 : 0;
+        float y = (i % 400) * 0.1;
+        float z = -(float)(i % 20) * 0.05;
+        snprintf(&blocks[i * BENCH_BLOCK_LEN], BENCH_BLOCK_LEN, "G1 X%.3f Y%.3f Z%.3f", x, y, z);
+    }
+}
+
+static double _time_stream(const bool planned, const bool cached)
+{
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (long i = 0; i < block_count; i++) {
+        if (!cached) {
+            cm_invalidate_combined_offsets();
+        }
+        _parse(&blocks[i * BENCH_BLOCK_LEN]);
+        if (planned && mp_planner_is_full(mp)) {
+            planner_reset(mp);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / block_count);
+}
+
+/*
+ * _run() - run the stream from the same start, best of runs, alternating cached and not
+ */
+
+static void _run(const bool planned, const int runs, benchRun_t &cached, benchRun_t &uncached)
+{
+    cached.ns = uncached.ns = INFINITY;
+    for (int r = 0; r < runs; r++) {
+        for (int c = 0; c < 2; c++) {
+            benchRun_t &result = c ? uncached : cached;
+            _parse("G1 X0 Y0 Z0");
+            if (planned) {
+                planner_reset(mp);
+            }
+            result.ns = std::min(result.ns, _time_stream(planned, c == 0));
+            copy_vector(result.position, cm->gmx.position);
+        }
+    }
+}
+
+static float _max_diff(const benchRun_t &a, const benchRun_t &b)
+{
+    float diff = 0;
+    for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
+        diff = std::max(diff, fabsf(a.position[axis] - b.position[axis]));
+    }
+    return (diff);
+}
+
+int main(int argc, char *argv[])
+{
+    long count = 200000;
+    int runs = 5;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:r:")) != -1) {
+        switch (opt) {
+            case 'n': { count = atol(optarg); break; }
+            case 'r': { runs = atoi(optarg); break; }
+            default:  {
+                fprintf(stderr, "usage: %s [-n blocks] [-r runs]\n", argv[0]);
+                return (1);
+            }
+        }
+    }
+    if ((count < 1) || (runs < 1)) {
+        fprintf(stderr, "usage: %s [-n blocks] [-r runs]\n", argv[0]);
+        return (1);
+    }
+
+    FILE *out = fdopen(dup(fileno(stdout)), "w");
+    if ((out == NULL) || (freopen("/dev/null", "w", stdout) == NULL)) {  // printf() is the firmware's
+        return (1);
+    }
+    _init_firmware();
+    _make_stream(count);
+
+    // work offsets on every axis the blocks use: G55, a tool length offset and G92
+    _parse("G21 G90 G17 G94 F2000");
+    _parse("G10 L2 P2 X5 Y7 Z-2");
+    _parse("G10 L1 P1 Z-1.5");
+    _parse("G55 G43 H1");
+    _parse("G92 X3 Y-4 Z0.5");
+
+    benchRun_t model_cached, model_uncached, planned_cached, planned_uncached;
+    cm_seek_start(INT32_MAX);               // the blocks have no N words - all are before the seek line
+    _run(false, runs, model_cached, model_uncached);
+    cm_seek_start(0);
+    _run(true, runs, planned_cached, planned_uncached);
+
+    fprintf(out, "blocks        %ld G1 X Y Z, best of %d runs\n", count, runs);
+    fprintf(out, "ns/block                     cached   uncached   saved\n");
+    fprintf(out, "  model only (seek)        %8.1f   %8.1f   %5.1f%%\n", model_cached.ns, model_uncached.ns,
+            100 * (1 - model_cached.ns / model_uncached.ns));
+    fprintf(out, "  planned (to mp_aline)    %8.1f   %8.1f   %5.1f%%\n", planned_cached.ns, planned_uncached.ns,
+            100 * (1 - planned_cached.ns / planned_uncached.ns));
+    fprintf(out, "end position difference, cached vs uncached: %g mm (model only), %g mm (planned)\n",
+            _max_diff(model_cached, model_uncached), _max_diff(planned_cached, planned_uncached));
+    return (0);
+}
@@ -0,0 +1,323 @@
+/*
+ * pk_bench.cpp - PressureKinematics float vs double: per-segment cost and numeric error
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  Usage: pk_bench [-n segments]
+ *
+ *  Runs the idle-segment pressure loop of PressureKinematics (kinematics_pressure.h)
+ *  against a simulated dispensing head: a closed vessel whose pressure rises with
+ *  plunger travel and bleeds out through the nozzle.
+ *
+ *  Accuracy: the double instance drives the plant. The float instance reads exactly
+ *  the same sensor values every segment, so the reported differences come from the
+ *  arithmetic alone and not from two plants drifting apart.
+ *
+ *  Closed loop: a float and a double instance each drive a plant of their own, as
+ *  on a board, and the outcomes are compared: dispensing events, pressure error
+ *  while holding, the pressure reached, plunger travel, and the error counters.
+ *  This is what decides whether float can be used - the open loop figures above
+ *  only show where the arithmetic starts to differ.
+ *
+ *  Cost: the sensor trace from the accuracy run is replayed into fresh float and
+ *  double instances and idle_task() is timed. Note that a host FPU does double in
+ *  hardware - this shows the float path is not slower and how much work a segment
+ *  is, not the software-double penalty of a single-precision Cortex-M FPU.
+ *
+ *  Nothing from the core is linked. The few globals the header touches (cm, in_r[],
+ *  the sensors, mp_set_target_steps()) are provided here.
+ */
+
+#include "g2core.h"  // #1
+#include "config.h"  // #2
+#include "canonical_machine.h"
+#include "planner.h"
+#include "gpio.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+/**** Sensors - same interface as device/honeywell-trustability-ssc ****/
+
+enum class PressureUnits { PSI, cmH2O, inH20, Pa, kPa };
+struct PressureSensor {
+    virtual double getPressure(const PressureUnits output_units) const = 0;
+};
+
+enum class FlowUnits { LPM, SLM, NLPM };
+struct FlowSensor {
+    virtual double getPressure(const PressureUnits output_units) const = 0;
+    virtual double getFlow(const FlowUnits output_units) const = 0;
+};
+
+struct BenchPressureSensor : PressureSensor {
+    double value = 0;
+    double getPressure(const PressureUnits) const override { return (value); }
+};
+
+struct BenchFlowSensor : FlowSensor {
+    double value = 0;
+    double getPressure(const PressureUnits) const override { return (0); }
+    double getFlow(const FlowUnits) const override { return (value); }
+};
+
+BenchPressureSensor pressure_sensor1;
+BenchFlowSensor flow_sensor1;
+
+/**** What the header needs from the core ****/
+
+namespace Motate {
+    SysTickTimer_t SysTickTimer;
+}
+
+static cmMachine_t bench_cm;
+cmMachine_t *cm = &bench_cm;
+
+static gpioDigitalInputReader bench_readers[18];    // no pins: anchor switches read open
+gpioDigitalInputReader* const in_r[18] = {
+    &bench_readers[0],  &bench_readers[1],  &bench_readers[2],  &bench_readers[3],
+    &bench_readers[4],  &bench_readers[5],  &bench_readers[6],  &bench_readers[7],
+    &bench_readers[8],  &bench_readers[9],  &bench_readers[10], &bench_readers[11],
+    &bench_readers[12], &bench_readers[13], &bench_readers[14], &bench_readers[15],
+    &bench_readers[16], &bench_readers[17]
+};
+
+stat_t mp_set_target_steps(const float target_steps[MOTORS], const float start_velocities[MOTORS],
+                           const float end_velocities[MOTORS], const float segment_time)
+{
+    return (STAT_OK);
+}
+
+#include "kinematics_pressure.h"
+
+/**** Simulated head ****/
+
+#define BENCH_PRESSURE_PER_MM   5.0         // cmH2O per mm of plunger travel into the closed vessel
+#define BENCH_LEAK_PER_SEC      0.5         // fraction of the pressure lost per second through the nozzle
+#define BENCH_FLOW_PER_CMH2O    0.2         // SLM through the nozzle per cmH2O
+#define BENCH_TARGET_PRESSURE   40.0        // cmH2O per dispensing event
+
+struct benchPlant {
+    double pressure = 0;
+    float last_position = 0;
+
+    void advance(const float position, const double seconds) {
+        pressure += (position - last_position) * BENCH_PRESSURE_PER_MM;
+        pressure -= pressure * BENCH_LEAK_PER_SEC * seconds;
+        last_position = position;
+    }
+};
+
+typedef struct benchSample {
+    double pressure;
+    double flow;
+} benchSample_t;
+
+template <typename real_t>
+static void _setup(PressureKinematics<AXES, MOTORS, real_t> &pk)
+{
+    const float steps_per_unit[MOTORS] = { 200, 200, 200, 200 };
+    const int8_t motor_map[MOTORS] = { 0, 1, 2, 3 };
+
+    pk.configure(steps_per_unit, motor_map);
+    pk.event_pressure_target = BENCH_TARGET_PRESSURE;
+    pk.reverse_target_pressure = -5;
+    pk.zero_pressure_value[0] = 0;
+}
+
+static void _set_sensors(const benchSample_t &s)
+{
+    pressure_sensor1.value = s.pressure;
+    flow_sensor1.value = s.flow;
+}
+
+// advance virtual time by one segment - the pressure state machine runs on Motate::Timeouts
+static void _tick_segment(double &ms)
+{
+    ms += MIN_SEGMENT_MS;
+    while (ms >= 1) {
+        SysTickTimer.tick();
+        ms -= 1;
+    }
+}
+
+template <typename real_t>
+static double _time_replay(const std::vector<benchSample_t> &trace)
+{
+    static PressureKinematics<AXES, MOTORS, real_t> pk;     // one replay per precision, so a fresh instance
+    _setup(pk);
+    SysTickTimer.ticks = 0;
+    double ms = 0;
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (const benchSample_t &s : trace) {
+        _set_sensors(s);
+        pk.idle_task();
+        _tick_segment(ms);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / trace.size());
+}
+
+typedef struct benchLoop {
+    long events;
+    long obtain_errors;                     // unable_to_obtian_error_counter
+    long maintain_errors;                   // unable_to_maintian_error_counter
+    double hold_err_max;                    // largest |pressure - target| while holding (cmH2O)
+    double hold_err_rms;
+    double pressure_max;                    // cmH2O
+    double travel;                          // total plunger travel (mm)
+    double position_end;                    // plunger position at the end (mm)
+    std::vector<float> pressure;            // the pressure every segment, to compare the runs
+} benchLoop_t;
+
+template <typename real_t>
+static void _closed_loop(const long segments, benchLoop_t &r)
+{
+    typedef PressureKinematics<AXES, MOTORS, real_t> pk_t;
+    static pk_t pk;                         // one run per precision, so a fresh instance
+    _setup(pk);
+    SysTickTimer.ticks = 0;
+    benchPlant plant;
+    double ms = 0, sum_sq = 0;
+    long hold_segments = 0;
+
+    r = benchLoop_t();
+    r.pressure.reserve(segments);
+    for (long i = 0; i < segments; i++) {
+        benchSample_t s = { plant.pressure, plant.pressure * BENCH_FLOW_PER_CMH2O };
+        _set_sensors(s);
+        float last = plant.last_position;
+        pk.idle_task();
+        plant.advance(pk.joint_position[0], MIN_SEGMENT_TIME * 60);
+        _tick_segment(ms);
+
+        r.travel += fabs(plant.last_position - last);
+        r.pressure_max = std::max(r.pressure_max, plant.pressure);
+        r.pressure.push_back(plant.pressure);
+        if (pk.pressure_state == pk_t::PressureState::Hold) {
+            double e = plant.pressure - pk.event_pressure_target;
+            r.hold_err_max = std::max(r.hold_err_max, fabs(e));
+            sum_sq += e * e;
+            hold_segments++;
+        }
+    }
+    r.events = pk.event_counter;
+    r.obtain_errors = pk.unable_to_obtian_error_counter;
+    r.maintain_errors = pk.unable_to_maintian_error_counter;
+    r.hold_err_rms = hold_segments ? sqrt(sum_sq / hold_segments) : 0;
+    r.position_end = plant.last_position;
+}
+
+static double _rel_err(const double a, const double b)
+{
+    return (fabs(a - b) / std::max(fabs(b), 1.0));   // absolute near zero, relative above 1
+}
+
+int main(int argc, char *argv[])
+{
+    long segments = 400000;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+            case 'n': { segments = atol(optarg); break; }
+            default:  {
+                fprintf(stderr, "usage: %s [-n segments]\n", argv[0]);
+                return (1);
+            }
+        }
+    }
+    if (segments < 1) {
+        fprintf(stderr, "usage: %s [-n segments]\n", argv[0]);
+        return (1);
+    }
+
+    cm->a[AXIS_X].jerk_max = 500;           // km/min^3
+    cm->a[AXIS_X].velocity_max = 600;       // mm/min
+    cm->a[AXIS_X].travel_min = -1000;
+    cm->a[AXIS_X].travel_max = 1000;
+
+    // accuracy - the double instance closes the loop, the float instance follows it
+    static PressureKinematics<AXES, MOTORS, double> pkd;
+    static PressureKinematics<AXES, MOTORS, float> pkf;
+    _setup(pkd);
+    _setup(pkf);
+
+    std::vector<benchSample_t> trace;
+    trace.reserve(segments);
+    benchPlant plant;
+    double ms = 0;
+    double err_position = 0, err_velocity = 0, err_pid = 0, err_volume = 0;
+    long diverged = 0;                      // segments where the jerk control chose differently
+
+    for (long i = 0; i < segments; i++) {
+        benchSample_t s = { plant.pressure, plant.pressure * BENCH_FLOW_PER_CMH2O };
+        trace.push_back(s);
+        _set_sensors(s);
+        pkd.idle_task();
+        pkf.idle_task();
+        plant.advance(pkd.joint_position[0], MIN_SEGMENT_TIME * 60);
+        _tick_segment(ms);
+
+        err_position = std::max(err_position, _rel_err(pkf.joint_position[0], pkd.joint_position[0]));
+        err_velocity = std::max(err_velocity, _rel_err(pkf.joint_vel[0], pkd.joint_vel[0]));
+        if (fabs(pkf.joint_vel[0] - pkd.joint_vel[0]) > cm->a[AXIS_X].velocity_max * 0.01) {
+            diverged++;
+        }
+        err_pid = std::max(err_pid, _rel_err(pkf.pressure_pid_output[0], pkd.pressure_pid_output[0]));
+        err_volume = std::max(err_volume, _rel_err(pkf.volume_value[0], pkd.volume_value[0]));
+    }
+
+    // closed loop - each precision drives its own plant
+    benchLoop_t loop_d, loop_f;
+    _closed_loop<double>(segments, loop_d);
+    _closed_loop<float>(segments, loop_f);
+    double pressure_diff = 0;
+    for (long i = 0; i < segments; i++) {
+        pressure_diff = std::max(pressure_diff, (double)fabsf(loop_f.pressure[i] - loop_d.pressure[i]));
+    }
+
+    double ns_float = _time_replay<float>(trace);
+    double ns_double = _time_replay<double>(trace);
+
+    printf("segments      %ld (%.1f s), %ld dispensing events\n",
+           segments, segments * MIN_SEGMENT_MS / 1000, (long)pkd.event_counter);
+    printf("ns/segment    float %.1f   double %.1f   (host FPU)\n", ns_float, ns_double);
+    printf("max error of float vs double (relative, absolute below 1):\n");
+    printf("  position    %.3g mm\n", err_position);
+    printf("  velocity    %.3g mm/min\n", err_velocity);
+    printf("  pid output  %.3g\n", err_pid);
+    printf("  volume      %.3g\n", err_volume);
+    printf("segments with velocity apart by more than 1%% of vmax: %ld\n", diverged);
+    printf("closed loop, each precision on its own plant:   double      float\n");
+    printf("  events                                  %10ld %10ld\n", loop_d.events, loop_f.events);
+    printf("  unable to obtain / maintain errors      %5ld/%-4ld %5ld/%-4ld\n",
+           loop_d.obtain_errors, loop_d.maintain_errors, loop_f.obtain_errors, loop_f.maintain_errors);
+    printf("  hold pressure error max / rms (cmH2O)   %5.2f/%-4.2f %5.2f/%-4.2f\n",
+           loop_d.hold_err_max, loop_d.hold_err_rms, loop_f.hold_err_max, loop_f.hold_err_rms);
+    printf("  peak pressure (cmH2O)                   %10.2f %10.2f\n", loop_d.pressure_max, loop_f.pressure_max);
+    printf("  plunger travel (mm)                     %10.1f %10.1f\n", loop_d.travel, loop_f.travel);
+    printf("  plunger position at the end (mm)        %10.3f %10.3f\n", loop_d.position_end, loop_f.position_end);
+    printf("  largest pressure difference between the runs: %.3f cmH2O\n", pressure_diff);
+    return (0);
+}
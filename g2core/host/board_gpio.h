@@ -0,0 +1,115 @@
+/*
+ * board_gpio.h - board-specific gpio definitions
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BOARD_GPIO_H_ONCE
+#define BOARD_GPIO_H_ONCE
+
+// this file is included from the bottom of gpio.h, but we do this for completeness
+#include "gpio.h"
+#include "hardware.h"
+
+//--- The host has the full complement so any settings file can be loaded ---//
+
+#define D_IN_CHANNELS      18           // number of digital inputs supported
+#define D_OUT_CHANNELS     18           // number of digital outputs supported
+#define A_IN_CHANNELS	    4           // number of analog inputs supported
+#define A_OUT_CHANNELS	    0           // number of analog outputs supported
+
+#define INPUT_LOCKOUT_MS    10          // milliseconds to go dead after input firing
+
+#ifndef SPINDLE_ENABLE_OUTPUT_NUMBER
+#define SPINDLE_ENABLE_OUTPUT_NUMBER 1
+#endif
+#ifndef SPINDLE_DIRECTION_OUTPUT_NUMBER
+#define SPINDLE_DIRECTION_OUTPUT_NUMBER 2
+#endif
+#ifndef SPINDLE_PWM_NUMBER
+#define SPINDLE_PWM_NUMBER 3
+#endif
+#ifndef MIST_ENABLE_OUTPUT_NUMBER
+#define MIST_ENABLE_OUTPUT_NUMBER 4
+#endif
+#ifndef FLOOD_ENABLE_OUTPUT_NUMBER
+#define FLOOD_ENABLE_OUTPUT_NUMBER 5
+#endif
+#ifndef SECONDARY_PWM_OUTPUT_NUMBER
+#define SECONDARY_PWM_OUTPUT_NUMBER 0
+#endif
+
+extern gpioDigitalInput*   const d_in[D_IN_CHANNELS];
+extern gpioDigitalOutput*  const d_out[D_OUT_CHANNELS];
+extern gpioAnalogInput*    const a_in[A_IN_CHANNELS];
+
+// prepare the objects as externs (for config_app to not bloat)
+using Motate::IRQPin;
+using Motate::PWMOutputPin;
+using Motate::ADCPin;
+
+extern gpioDigitalInputPin<IRQPin<Motate::kInput1_PinNumber>>  din1;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput2_PinNumber>>  din2;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput3_PinNumber>>  din3;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput4_PinNumber>>  din4;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput5_PinNumber>>  din5;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput6_PinNumber>>  din6;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput7_PinNumber>>  din7;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput8_PinNumber>>  din8;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput9_PinNumber>>  din9;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput10_PinNumber>> din10;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput11_PinNumber>> din11;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput12_PinNumber>> din12;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput13_PinNumber>> din13;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput14_PinNumber>> din14;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput15_PinNumber>> din15;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput16_PinNumber>> din16;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput17_PinNumber>> din17;
+extern gpioDigitalInputPin<IRQPin<Motate::kInput18_PinNumber>> din18;
+
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput1_PinNumber>>  dout1;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput2_PinNumber>>  dout2;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput3_PinNumber>>  dout3;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput4_PinNumber>>  dout4;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput5_PinNumber>>  dout5;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput6_PinNumber>>  dout6;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput7_PinNumber>>  dout7;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput8_PinNumber>>  dout8;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput9_PinNumber>>  dout9;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput10_PinNumber>> dout10;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput11_PinNumber>> dout11;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput12_PinNumber>> dout12;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput13_PinNumber>> dout13;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput14_PinNumber>> dout14;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput15_PinNumber>> dout15;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput16_PinNumber>> dout16;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput17_PinNumber>> dout17;
+extern gpioDigitalOutputPin<PWMOutputPin<Motate::kOutput18_PinNumber>> dout18;
+
+extern gpioAnalogInputPin<ADCPin<Motate::kADC1_PinNumber>> ai1;
+extern gpioAnalogInputPin<ADCPin<Motate::kADC2_PinNumber>> ai2;
+extern gpioAnalogInputPin<ADCPin<Motate::kADC3_PinNumber>> ai3;
+extern gpioAnalogInputPin<ADCPin<Motate::kADC4_PinNumber>> ai4;
+
+#endif // End of include guard: BOARD_GPIO_H_ONCE
@@ -0,0 +1,48 @@
+/*
+ * board_stepper.h - motor and motor driver definitions
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BOARD_STEPPER_H_ONCE
+#define BOARD_STEPPER_H_ONCE
+
+#include "hardware.h"  // for MOTORS
+#include "stepper.h"
+
+// The host has no motor drivers. The base Stepper does nothing on a step, which is
+// all the estimator needs - the DDA still runs so segment timing is exact.
+
+extern Stepper motor_1;
+extern Stepper motor_2;
+extern Stepper motor_3;
+extern Stepper motor_4;
+extern Stepper motor_5;
+extern Stepper motor_6;
+
+extern Stepper* const Motors[MOTORS];
+
+extern void board_stepper_init();
+
+#endif  // BOARD_STEPPER_H_ONCE
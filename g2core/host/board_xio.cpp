@@ -0,0 +1,189 @@
+/*
+ * board_xio.cpp - extended IO functions for the host - stands in for xio.cpp
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  There is one device: the job file, which is always a control and a data channel.
+ *  Lines are handed out one per call, as a sender that always keeps up would. Each
+ *  gcode line is numbered with its line in the file (any N word it had is replaced) so
+ *  the runtime line number says which line of the file is moving.
+ *
+ *  Lines starting with '%' are skipped - in a file they mark the start and end of the
+ *  program, but to the controller they would be a queue flush.
+ *
+ *  Output goes to stderr in verbose mode and is otherwise dropped.
+ */
+
+#include "g2core.h"
+#include "config.h"
+#include "hardware.h"
+#include "xio.h"
+#include "text_parser.h"
+#include "canonical_machine.h"
+#include "g2est.h"
+
+#include <ctype.h>
+
+static char _line[RX_BUFFER_SIZE];
+
+/*
+ * _read_job_line() - read the next line of the job file into _line, dropping the line end
+ *
+ *  Returns false at the end of the file. Over-long lines are truncated.
+ */
+
+static bool _read_job_line(const uint16_t max)
+{
+    if (fgets(_line, max, est.file) == NULL) {
+        return (false);
+    }
+    size_t len = strlen(_line);
+    if ((len > 0) && (_line[len-1] != '\n') && !feof(est.file)) {
+        int c;
+        while (((c = fgetc(est.file)) != EOF) && (c != '\n'));    // discard the rest of the line
+    }
+    while ((len > 0) && ((_line[len-1] == '\n') || (_line[len-1] == '\r'))) {
+        _line[--len] = NUL;
+    }
+    est.lineno++;
+    return (true);
+}
+
+/*
+ * _number_line() - replace or add the N word so the line carries its line number in the file
+ */
+
+static void _number_line(char *buf)
+{
+    char *p = _line;
+    while ((*p == SPC) || (*p == TAB)) { p++; }
+    if (((*p == 'N') || (*p == 'n')) && isdigit(p[1])) {
+        for (p++; isdigit(*p); p++);
+    }
+    snprintf(buf, RX_BUFFER_SIZE, "N%lu %s", (unsigned long)est.lineno, p);
+}
+
+/*
+ * xio_readline() - read a complete line from the job file
+ */
+
+char *xio_readline(devflags_t &flags, uint16_t &size)
+{
+    static char buf[RX_BUFFER_SIZE];
+
+    if (!(flags & DEV_IS_DATA) || est.eof) {                // the file holds no control-only lines
+        return (NULL);
+    }
+    const uint16_t max = RX_BUFFER_SIZE - 12;               // leave room for the N word
+    do {
+        if (!_read_job_line(max)) {
+            est.eof = true;
+            return (NULL);
+        }
+    } while (*_line == '%');
+
+    char c = *_line;
+    if ((c == '{') || (c == '$') || (c == '?') || (c == '!') || (c == '~') || (c == NUL) || (c == ENQ)) {
+        strcpy(buf, _line);                                 // not gcode - pass it through as is
+    } else {
+        _number_line(buf);
+    }
+    est.started = true;
+    est.line_read = true;
+    flags = DEV_IS_BOTH;
+    size = strlen(buf);
+    return (buf);
+}
+
+/*
+ * xio_write()     - write a buffer to the "device"
+ * xio_writeline() - write a complete line to control device
+ */
+
+size_t xio_write(const char *buffer, size_t size, bool only_to_muted /*= false*/)
+{
+    if (est.verbose && !only_to_muted) {
+        fwrite(buffer, 1, size, stderr);
+    }
+    return (size);
+}
+
+int16_t xio_writeline(const char *buffer, bool only_to_muted /*= false*/)
+{
+    return (xio_write(buffer, strlen(buffer), only_to_muted));
+}
+
+/*
+ * xio_set_sr_compact() - the job file is the only channel, so it holds the one format setting
+ * xio_get_sr_compact()
+ * xio_has_sr_channel()
+ * xio_writeline_sr()
+ */
+
+static bool _sr_compact = false;
+
+void xio_set_sr_compact(bool compact) { _sr_compact = compact; }
+bool xio_get_sr_compact() { return (_sr_compact); }
+bool xio_has_sr_channel(bool compact) { return (_sr_compact == compact); }
+
+int16_t xio_writeline_sr(const char *buffer, bool compact)
+{
+    if (_sr_compact != compact) {
+        return (0);
+    }
+    return (xio_writeline(buffer));
+}
+
+/*
+ * xio_init()            - nothing to set up
+ * xio_test_assertions() - nothing to test
+ * xio_connected()       - the job file is not a connection that comes and goes
+ * xio_send_file()       - in-flash files are not supported
+ * xio_flush_to_command()- a flush drops the rest of the job
+ * xio_flush_device()    - nothing to flush
+ */
+
+void xio_init() {}
+stat_t xio_test_assertions() { return (STAT_OK); }
+bool xio_connected() { return (false); }
+bool xio_send_file(xio_flash_file &file) { return (false); }
+void xio_flush_to_command() { est.eof = true; }
+void xio_flush_device(devflags_t &flags) {}
+
+#if MARLIN_COMPAT_ENABLED == true
+void xio_exit_fake_bootloader() {}
+#endif
+
+/***********************************************************************************
+ * TEXT MODE SUPPORT
+ * Functions to print variables from the cfgArray table
+ ***********************************************************************************/
+
+#ifdef __TEXT_MODE
+
+static const char fmt_spi[] = "[spi] SPI state%20d [0=disabled,1=enabled]\n";
+void xio_print_spi(nvObj_t *nv) { text_print(nv, fmt_spi);} // TYPE_INT
+
+#endif // __TEXT_MODE
@@ -0,0 +1,281 @@
+/*
+ * g2est.cpp - job runtime estimator - runs gcode files through the firmware in virtual time
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  Usage: g2est [-l] [-v] [-j jobs] file...
+ *
+ *    -l    also report the time spent on each line of the file
+ *    -v    copy firmware output (responses, status reports) to stderr
+ *    -j    number of files to run at once (default: one per CPU)
+ *
+ *  Prints one "<file>\t<seconds>" line per file, in the order given, followed by
+ *  "<file>:<line>\t<seconds>" lines if -l is used. Time is attributed to the line the
+ *  runtime is moving on, so dwells and spindle spin-up show up on the next line that
+ *  moves. Line 0 is the time before the first move started.
+ *
+ *  The machine is the settings file the estimator was built with (see Makefile).
+ *  JSON and $ configuration lines in a job are applied as they would be on the board.
+ *
+ *  Each file runs in its own process so every job starts from a freshly initialized
+ *  firmware - the core keeps all of its state in globals.
+ */
+
+#include "g2core.h"  // #1
+#include "config.h"  // #2
+#include "controller.h"
+#include "canonical_machine.h"
+#include "gcode_parser.h"
+#include "hardware.h"
+#include "persistence.h"
+#include "planner.h"
+#include "stepper.h"
+#include "coolant.h"
+#include "encoder.h"
+#include "spindle.h"
+#include "temperature.h"
+#include "gpio.h"
+#include "xio.h"
+#include "g2est.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/******************** System Globals *************************/
+
+stat_t status_code;                         // allocate a variable for the ritorno macro
+
+OutputPin<Motate::kDebug1_PinNumber> debug_pin1;
+OutputPin<Motate::kDebug2_PinNumber> debug_pin2;
+OutputPin<Motate::kDebug3_PinNumber> debug_pin3;
+OutputPin<Motate::kDebug4_PinNumber> debug_pin4;
+
+estJob_t est;
+
+/*
+ * get_status_message() - global support for status messages.
+ */
+
+char *get_status_message(stat_t status)
+{
+    return ((char *)GET_TEXT_ITEM(stat_msg, status));
+}
+
+/******************** Estimator ************************/
+
+/*
+ * est_ms_elapsed() - account for one virtual millisecond
+ */
+
+void est_ms_elapsed(bool busy)
+{
+    if (!est.started) {
+        return;
+    }
+    est.ms++;
+    est.idle_ms = (busy || est.line_read) ? 0 : est.idle_ms + 1;
+
+    if (est.per_line) {
+        uint32_t line = cm_get_linenum(RUNTIME);
+        if (line >= est.line_ms_size) {
+            uint32_t size = (line + 1024) & ~1023;
+            est.line_ms = (uint32_t *)realloc(est.line_ms, size * sizeof(uint32_t));
+            memset(est.line_ms + est.line_ms_size, 0, (size - est.line_ms_size) * sizeof(uint32_t));
+            est.line_ms_size = size;
+        }
+        est.line_ms[line]++;
+    }
+}
+
+/*
+ * _report() - write the results for the job
+ */
+
+static void _report()
+{
+    fprintf(est.out, "%s\t%.3f\n", est.path, (double)est.ms / 1000);
+    for (uint32_t line = 0; line < est.line_ms_size; line++) {
+        if (est.line_ms[line]) {
+            fprintf(est.out, "%s:%lu\t%.3f\n", est.path, (unsigned long)line, (double)est.line_ms[line] / 1000);
+        }
+    }
+    fflush(est.out);
+}
+
+/*
+ * est_check_job() - exit when the job is done or has failed
+ *
+ *  The job is done when the whole file has been read and the machine has stopped with
+ *  nothing left in the planner. A feedhold in the job is resumed as an operator would.
+ */
+
+void est_check_job()
+{
+    cmMachineState state = cm_get_machine_state();
+    if ((state == MACHINE_ALARM) || (state == MACHINE_SHUTDOWN) || (state == MACHINE_PANIC)) {
+        fprintf(stderr, "%s:%lu: machine stopped (state %d)\n", est.path, (unsigned long)est.lineno, state);
+        exit(EST_ERROR_ALARM);
+    }
+    if (est.idle_ms > EST_STALL_MS) {
+        fprintf(stderr, "%s:%lu: job stalled\n", est.path, (unsigned long)est.lineno);
+        exit(EST_ERROR_STALLED);
+    }
+    if (cm->hold_state == FEEDHOLD_HOLD) {
+        cm_request_cycle_start();
+    }
+    if (!est.eof) {
+        return;
+    }
+    if ((state == MACHINE_CYCLE) || st_runtime_isbusy() || (mp_get_planner_buffers(mp) != mp->q.queue_size)) {
+        return;
+    }
+    _report();
+    exit(EST_OK);
+}
+
+/*
+ * _run_job() - run one job file to completion - does not return
+ *
+ *  Same init order as main.cpp. There is no USB to wait for.
+ */
+
+static void _run_job(const char *path, FILE *out)
+{
+    est.path = path;
+    est.out = out;
+    if ((est.file = fopen(path, "r")) == NULL) {
+        fprintf(stderr, "%s: can't open\n", path);
+        exit(EST_ERROR_FILE);
+    }
+    // printf() is the firmware's - keep it out of the results
+    if (freopen(est.verbose ? "/dev/stderr" : "/dev/null", "w", stdout) == NULL) {
+        exit(EST_ERROR_FILE);
+    }
+
+    hardware_init();
+    persistence_init();
+    xio_init();
+
+    cm = &cm1;
+    cm->machine_state = MACHINE_INITIALIZING;
+    canonical_machine_inits();
+    stepper_init();
+    encoder_init();
+    gpio_init();
+
+    controller_init();
+    config_init();
+    canonical_machine_reset(&cm1);
+    gcode_parser_init();
+    spindle_init();
+    spindle_reset();
+    coolant_init();
+    coolant_reset();
+    temperature_init();
+    gpio_reset();
+
+    controller_run();                       // est_check_job() exits from inside
+    exit(EST_OK);
+}
+
+/*
+ * main() - run the files given, several at a time, and print the results in order
+ */
+
+int main(int argc, char *argv[])
+{
+    long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "lvj:")) != -1) {
+        switch (opt) {
+            case 'l': { est.per_line = true; break; }
+            case 'v': { est.verbose = true; break; }
+            case 'j': { jobs = atol(optarg); break; }
+            default:  {
+                fprintf(stderr, "usage: %s [-l] [-v] [-j jobs] file...\n", argv[0]);
+                return (EST_ERROR_USAGE);
+            }
+        }
+    }
+    int files = argc - optind;
+    if ((files == 0) || (jobs < 1)) {
+        fprintf(stderr, "usage: %s [-l] [-v] [-j jobs] file...\n", argv[0]);
+        return (EST_ERROR_USAGE);
+    }
+
+    FILE **results = (FILE **)calloc(files, sizeof(FILE *));
+    pid_t *pids = (pid_t *)calloc(files, sizeof(pid_t));
+    bool *done = (bool *)calloc(files, sizeof(bool));
+    int status = EST_OK;
+    int next = 0;                           // next file to start
+    int printed = 0;                        // files whose results have been printed
+    int running = 0;
+
+    fflush(stdout);
+    while (printed < files) {
+        while ((running < jobs) && (next < files)) {
+            if ((results[next] = tmpfile()) == NULL) {
+                perror("tmpfile");
+                return (EST_ERROR_FILE);
+            }
+            if ((pids[next] = fork()) == 0) {
+                _run_job(argv[optind + next], results[next]);
+            }
+            next++;
+            running++;
+        }
+
+        int child_status;
+        pid_t pid = wait(&child_status);
+        if (pid < 0) {
+            break;
+        }
+        running--;
+        for (int i = 0; i < next; i++) {
+            if (pids[i] == pid) {
+                done[i] = true;
+                if (!WIFEXITED(child_status)) {
+                    fprintf(stderr, "%s: estimator crashed\n", argv[optind + i]);
+                    status = EST_ERROR_ALARM;
+                } else if (WEXITSTATUS(child_status) != EST_OK) {
+                    status = WEXITSTATUS(child_status);     // the job has already said why
+                }
+            }
+        }
+        for (; (printed < next) && done[printed]; printed++) {   // print in the order given
+            char buf[4096];
+            size_t n;
+            rewind(results[printed]);
+            while ((n = fread(buf, 1, sizeof(buf), results[printed])) > 0) {
+                fwrite(buf, 1, n, stdout);
+            }
+            fclose(results[printed]);
+        }
+        fflush(stdout);
+    }
+    return (status);
+}
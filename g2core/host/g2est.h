@@ -0,0 +1,68 @@
+/*
+ * g2est.h - job runtime estimator
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef G2EST_H_ONCE
+#define G2EST_H_ONCE
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define EST_STALL_MS (60UL * 60 * 1000)     // give up after an hour of virtual time with nothing moving
+#define EST_MAX_FAST_FORWARD_MS 100         // virtual ms per main loop pass while the planner is full
+
+typedef enum {
+    EST_OK = 0,
+    EST_ERROR_USAGE,                        // bad command line
+    EST_ERROR_FILE,                         // job file can't be read
+    EST_ERROR_ALARM,                        // the job alarmed, shut down or panicked the machine
+    EST_ERROR_STALLED                       // the job stopped making progress (e.g. waiting on an input)
+} estStatus;
+
+typedef struct estJob {
+    const char *path;                       // job file
+    FILE *file;
+    FILE *out;                              // results go here - stdout belongs to the firmware
+    bool per_line;                          // report the time for every line as well as the total
+    bool verbose;                           // copy firmware output to stderr
+
+    bool started;                           // the first job line has been read - the clock is counting
+    bool eof;                               // the job file has been read to the end
+    bool line_read;                         // a line went to the controller since the last main loop pass
+    uint32_t lineno;                        // lines read from the job file
+
+    uint64_t ms;                            // virtual milliseconds since the first job line
+    uint64_t idle_ms;                       // virtual milliseconds since anything last happened
+    uint32_t *line_ms;                      // time attributed to each line (by runtime line number)
+    uint32_t line_ms_size;
+} estJob_t;
+
+extern estJob_t est;
+
+void est_ms_elapsed(bool busy);             // called by the host board for every virtual millisecond
+void est_check_job(void);                   // exits the process when the job is done or has failed
+
+#endif  // End of include guard: G2EST_H_ONCE
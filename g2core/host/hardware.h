@@ -0,0 +1,142 @@
+/*
+ * hardware.h - system hardware configuration
+ * For: /host
+ * THIS FILE IS HARDWARE PLATFORM SPECIFIC - Linux host (no hardware, virtual time)
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+#include "settings.h"
+#include "error.h"
+
+#ifndef HARDWARE_H_ONCE
+#define HARDWARE_H_ONCE
+
+/*--- Hardware platform enumerations ---*/
+
+#define G2CORE_HARDWARE_PLATFORM    "host"
+#define G2CORE_HARDWARE_VERSION     "1"
+
+/*************************
+ * Global System Defines *
+ *************************/
+
+#define MOTORS 6                    // number of motors supported the hardware
+#define PWMS 2                      // number of PWM channels supported the hardware
+#ifndef AXES
+#define AXES 6                      // axes to support -- must be 6 or 9 (make AXES=9)
+#endif
+
+#define MILLISECONDS_PER_TICK 1     // MS for system tick (systick * N)
+#define SYS_ID_LEN 40               // total length including dashes and NUL
+
+/*************************
+ * Motate Setup          *
+ *************************/
+
+#include "MotatePins.h"
+#include "MotateTimers.h"           // for TimerChanel<> and related...
+#include "MotateUtilities.h"
+
+using Motate::TimerChannel;
+
+using Motate::pin_number;
+using Motate::Pin;
+using Motate::PWMOutputPin;
+using Motate::OutputPin;
+
+/************************************************************************************
+ **** HOST SPECIFIC HARDWARE ********************************************************
+ ************************************************************************************/
+
+/**** Stepper DDA and dwell timer settings ****/
+
+// The DDA is clocked in virtual time by hardware_periodic() (host/0_hardware.cpp).
+// Segment times are quantized to DDA ticks exactly as they are on a board, so keep
+// these in step with the board being estimated (the defaults are the sbv300's).
+#ifndef FREQUENCY_DDA
+#define FREQUENCY_DDA		150000UL
+#endif
+#define FREQUENCY_DWELL		1000UL
+#define MIN_SEGMENT_MS ((float)1.0)
+
+#define PLANNER_QUEUE_SIZE (48)
+#define SECONDARY_QUEUE_SIZE (10)
+
+/**** Motate Definitions ****/
+
+// Timer definitions. See stepper.h and other headers for setup
+typedef TimerChannel<3,0> dda_timer_type;	// stepper pulse generation in stepper.cpp
+typedef TimerChannel<4,0> exec_timer_type;	// request exec timer in stepper.cpp
+typedef TimerChannel<5,0> fwd_plan_timer_type;	// request exec timer in stepper.cpp
+
+/**** SPI Setup ****/
+// Not needed
+
+/**** Motate Global Pin Allocations ****/
+
+static PWMOutputPin<Motate::kLED_USBRXPinNumber> IndicatorLed;
+
+/********************************
+ * Function Prototypes (Common) *
+ ********************************/
+
+const configSubtable *const getSysConfig_3();
+
+void hardware_init(void);			// master hardware init
+stat_t hardware_periodic();  // callback from the main loop (time sensitive)
+void hw_hard_reset(void);
+stat_t hw_flash(nvObj_t *nv);
+
+stat_t hw_get_fb(nvObj_t *nv);
+stat_t hw_get_fv(nvObj_t *nv);
+stat_t hw_get_hp(nvObj_t *nv);
+stat_t hw_get_hv(nvObj_t *nv);
+stat_t hw_get_fbs(nvObj_t *nv);
+stat_t hw_get_fbc(nvObj_t *nv);
+stat_t hw_get_id(nvObj_t *nv);
+
+#ifdef __TEXT_MODE
+
+    void hw_print_fb(nvObj_t *nv);
+    void hw_print_fv(nvObj_t *nv);
+    void hw_print_fbs(nvObj_t *nv);
+    void hw_print_fbc(nvObj_t *nv);
+    void hw_print_hp(nvObj_t *nv);
+    void hw_print_hv(nvObj_t *nv);
+    void hw_print_id(nvObj_t *nv);
+
+#else
+
+    #define hw_print_fb tx_print_stub
+    #define hw_print_fv tx_print_stub
+    #define hw_print_fbs tx_print_stub
+    #define hw_print_fbc tx_print_stub
+    #define hw_print_hp tx_print_stub
+    #define hw_print_hv tx_print_stub
+    #define hw_print_id tx_print_stub
+
+#endif // __TEXT_MODE
+
+#endif	// end of include guard: HARDWARE_H_ONCE
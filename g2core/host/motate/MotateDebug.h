@@ -0,0 +1,2 @@
+// MotateDebug.h - see MotateHost.h
+#include "MotateHost.h"
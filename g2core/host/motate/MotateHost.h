@@ -0,0 +1,249 @@
+/*
+ * MotateHost.h - just enough of Motate to run the g2core motion stack on a Linux host
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  There is no hardware. Pins, SPI and ADCs do nothing. What is real is time:
+ *
+ *    - SysTickTimer counts virtual milliseconds and runs registered SysTickEvents,
+ *      so dwells, spindle spin-up and Timeouts behave as they do on a board.
+ *    - TimerChannel interrupts are never fired by a clock. Software interrupts only
+ *      set a pending flag, and the host board (host/0_hardware.cpp) runs the exec and
+ *      forward planning interrupts when they are pending and clocks the DDA interrupt
+ *      as virtual time advances.
+ */
+
+#ifndef MOTATEHOST_H_ONCE
+#define MOTATEHOST_H_ONCE
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+#include <functional>
+
+#define HOT_FUNC
+#define HOT_DATA
+#define CLANG_ALWAYS_INLINE
+#ifndef __always_inline
+#define __always_inline inline
+#endif
+
+namespace Motate {
+
+typedef int16_t pin_number;
+
+/**** SysTick - virtual milliseconds ****/
+
+struct SysTickEvent {
+    std::function<void(void)> callback;
+    SysTickEvent *next;
+};
+
+struct SysTickTimer_t {
+    uint32_t ticks = 0;
+    SysTickEvent *first_event = nullptr;
+
+    uint32_t getValue() { return ticks; }
+
+    void registerEvent(SysTickEvent *new_event) {
+        if (first_event == nullptr) {
+            first_event = new_event;
+            new_event->next = nullptr;
+            return;
+        }
+        SysTickEvent *event = first_event;
+        while (true) {
+            if (event == new_event) { return; }             // already registered
+            if (event->next == nullptr) { break; }
+            event = event->next;
+        }
+        event->next = new_event;
+        new_event->next = nullptr;
+    }
+
+    void unregisterEvent(SysTickEvent *old_event) {
+        if (first_event == old_event) {
+            first_event = old_event->next;
+            return;
+        }
+        for (SysTickEvent *event = first_event; event != nullptr; event = event->next) {
+            if (event->next == old_event) {
+                event->next = old_event->next;
+                return;
+            }
+        }
+    }
+
+    // advance one millisecond - events may unregister themselves from their callback
+    void tick() {
+        ticks++;
+        SysTickEvent *event = first_event;
+        while (event != nullptr) {
+            SysTickEvent *next = event->next;
+            if (event->callback) { event->callback(); }
+            event = next;
+        }
+    }
+};
+extern SysTickTimer_t SysTickTimer;
+
+struct Timeout {
+    uint32_t start = 0;
+    uint32_t delay = 0;
+    bool set_flag = false;
+
+    void set(uint32_t ms, bool = false) { start = SysTickTimer.getValue(); delay = ms; set_flag = true; }
+    bool isSet() { return set_flag; }
+    bool isPast() { return set_flag && ((SysTickTimer.getValue() - start) >= delay); }
+    void clear() { set_flag = false; }
+};
+
+inline void delay(uint32_t) {}
+
+/**** Timers - interrupts are run by the host board, never by a clock ****/
+
+enum TimerMode { kTimerUpToMatch, kTimerUp };
+enum {
+    kInterruptOnOverflow = 1, kInterruptOnMatch = 2, kInterruptOnSoftwareTrigger = 4,
+    kInterruptPriorityHighest = 0, kInterruptPriorityHigh = 0, kInterruptPriorityMedium = 0,
+    kInterruptPriorityLow = 0, kInterruptPriorityLowest = 0, kInterruptUnknown = 0
+};
+
+template<uint8_t timerNum, uint8_t channelNum>
+struct TimerChannel {
+    static bool running;
+    static bool interrupt_pending;
+
+    TimerChannel() {}
+    TimerChannel(int, uint32_t) {}
+
+    static void interrupt();
+    void setModeAndFrequency(int, uint32_t) {}
+    void setInterrupts(uint32_t) {}
+    void setInterruptPending() { interrupt_pending = true; }
+    uint32_t getInterruptCause() { interrupt_pending = false; return 0; }
+    void start() { running = true; }
+    void stop() { running = false; }
+    void setExactDutyCycle(uint32_t) {}
+    uint32_t getTopValue() { return 0; }
+};
+template<uint8_t t, uint8_t c> bool TimerChannel<t, c>::running = false;
+template<uint8_t t, uint8_t c> bool TimerChannel<t, c>::interrupt_pending = false;
+
+/**** Pins - all null ****/
+
+enum PinMode { kUnchanged, kOutput, kInput, kPWMPinOutput };
+enum PinOptions_t {
+    kNormal = 0, kTotem = 0, kPullUp = 1, kDebounce = 2, kStartHigh = 4, kStartLow = 8,
+    kPinInterruptOnChange = 16, kPinInterruptOnRisingEdge = 32, kPinInterruptOnFallingEdge = 64,
+    kPinInterruptPriorityHigh = 128, kPinInterruptPriorityMedium = 256, kPinInterruptPriorityLow = 512
+};
+inline PinOptions_t operator|(PinOptions_t a, PinOptions_t b) { return (PinOptions_t)((int)a | (int)b); }
+
+template<pin_number... n>
+struct Pin {
+    Pin() {}
+    template <typename... T> Pin(T&&...) {}
+    void set() {}
+    void clear() {}
+    void toggle() {}
+    bool get() { return false; }
+    operator bool() { return false; }
+    bool isNull() { return true; }
+    void write(bool) {}
+    void setOptions(PinOptions_t, bool = true) {}
+    void setMode(PinMode) {}
+};
+template<pin_number... n>
+struct OutputPin : Pin<n...> {
+    OutputPin() {}
+    template <typename... T> OutputPin(T&&...) {}
+    void operator=(bool) {}
+};
+template<pin_number... n>
+struct InputPin : Pin<n...> {
+    InputPin() {}
+    template <typename... T> InputPin(T&&...) {}
+};
+template<pin_number... n>
+struct IRQPin : Pin<n...> {
+    IRQPin() {}
+    template <typename... T> IRQPin(T&&...) {}
+    void setInterruptHandler(std::function<void()>) {}
+};
+template<pin_number... n>
+struct PWMOutputPin : Pin<n...> {
+    PWMOutputPin() {}
+    template <typename... T> PWMOutputPin(T&&...) {}
+    void operator=(float) {}
+    void setFrequency(uint32_t) {}
+    float getDutyCycle() { return 0; }
+    void write(float) {}
+};
+template<pin_number... n>
+struct PWMLikeOutputPin : PWMOutputPin<n...> {
+    using PWMOutputPin<n...>::PWMOutputPin;
+};
+template<pin_number... n>
+struct ADCPin : Pin<n...> {
+    static constexpr bool is_differential = false;
+
+    ADCPin() {}
+    template <typename... T> ADCPin(T&&...) {}
+    int32_t getRaw() { return 0; }
+    float getVoltage() { return 0; }
+    void startSampling() {}
+    static constexpr float getTopVoltage() { return 3.3; }
+    void setInterrupts(int) {}
+    void setVoltageRange(float, float, float, float) {}
+};
+template<pin_number... n>
+struct ADCDifferentialPair : ADCPin<n...> {
+    static constexpr bool is_differential = true;
+    using ADCPin<n...>::ADCPin;
+};
+
+/**** System ****/
+
+namespace System {
+    void reset(bool bootloader);                // host/0_hardware.cpp
+}
+
+struct UUID_t {
+    operator const char *() { return "host"; }
+};
+extern UUID_t UUID;
+
+using ::strlen;
+using ::strncpy;
+inline uint16_t fromLittleEndian(uint16_t v) { return v; }
+
+} // namespace Motate
+
+using namespace Motate;
+
+static inline void __NOP() {}
+static inline void __disable_irq() {}
+static inline void __enable_irq() {}
+
+struct SysTick_Type { volatile uint32_t CTRL, LOAD, VAL, CALIB; };   // for trace.cpp sub-ms timestamps
+extern SysTick_Type *const SysTick;
+
+#include "motate_pin_assignments.h"
+
+#endif // MOTATEHOST_H_ONCE
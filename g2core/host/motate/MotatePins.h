@@ -0,0 +1,2 @@
+// MotatePins.h - see MotateHost.h
+#include "MotateHost.h"
@@ -0,0 +1,2 @@
+// MotatePower.h - see MotateHost.h
+#include "MotateHost.h"
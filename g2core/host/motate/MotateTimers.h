@@ -0,0 +1,2 @@
+// MotateTimers.h - see MotateHost.h
+#include "MotateHost.h"
@@ -0,0 +1,2 @@
+// MotateUniqueID.h - see MotateHost.h
+#include "MotateHost.h"
@@ -0,0 +1,2 @@
+// MotateUtilities.h - see MotateHost.h
+#include "MotateHost.h"
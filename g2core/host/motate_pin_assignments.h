@@ -0,0 +1,156 @@
+/*
+ * motate_pin_assignments.h - pin names for the host board
+ * For: /host
+ *
+ * This file is part of the g2core project
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/> .
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ *  Every pin the core code names is a null pin (-1) on the host.
+ */
+
+#ifndef MOTATE_PIN_ASSIGNMENTS_H_ONCE
+#define MOTATE_PIN_ASSIGNMENTS_H_ONCE
+
+namespace Motate {
+
+constexpr pin_number kADC1_Neg_PinNumber = -1;
+constexpr pin_number kADC1_PinNumber = -1;
+constexpr pin_number kADC1_Pos_PinNumber = -1;
+constexpr pin_number kADC2_Neg_PinNumber = -1;
+constexpr pin_number kADC2_PinNumber = -1;
+constexpr pin_number kADC2_Pos_PinNumber = -1;
+constexpr pin_number kADC3_Neg_PinNumber = -1;
+constexpr pin_number kADC3_PinNumber = -1;
+constexpr pin_number kADC4_PinNumber = -1;
+constexpr pin_number kCoolant_EnablePinNumber = -1;
+constexpr pin_number kDebug1_PinNumber = -1;
+constexpr pin_number kDebug2_PinNumber = -1;
+constexpr pin_number kDebug3_PinNumber = -1;
+constexpr pin_number kDebug4_PinNumber = -1;
+constexpr pin_number kExternalClock1_PinNumber = -1;
+constexpr pin_number kGRBL_CommonEnablePinNumber = -1;
+constexpr pin_number kGRBL_CycleStartPinNumber = -1;
+constexpr pin_number kGRBL_FeedHoldPinNumber = -1;
+constexpr pin_number kGRBL_ResetPinNumber = -1;
+constexpr pin_number kI2C_SCLPinNumber = -1;
+constexpr pin_number kI2C_SDAPinNumber = -1;
+constexpr pin_number kInput10_PinNumber = -1;
+constexpr pin_number kInput11_PinNumber = -1;
+constexpr pin_number kInput12_PinNumber = -1;
+constexpr pin_number kInput13_PinNumber = -1;
+constexpr pin_number kInput14_PinNumber = -1;
+constexpr pin_number kInput15_PinNumber = -1;
+constexpr pin_number kInput16_PinNumber = -1;
+constexpr pin_number kInput17_PinNumber = -1;
+constexpr pin_number kInput18_PinNumber = -1;
+constexpr pin_number kInput1_PinNumber = -1;
+constexpr pin_number kInput2_PinNumber = -1;
+constexpr pin_number kInput3_PinNumber = -1;
+constexpr pin_number kInput4_PinNumber = -1;
+constexpr pin_number kInput5_PinNumber = -1;
+constexpr pin_number kInput6_PinNumber = -1;
+constexpr pin_number kInput7_PinNumber = -1;
+constexpr pin_number kInput8_PinNumber = -1;
+constexpr pin_number kInput9_PinNumber = -1;
+constexpr pin_number kKinen_SyncPinNumber = -1;
+constexpr pin_number kLEDPWM_PinNumber = -1;
+constexpr pin_number kLED_RGBWPixelPinNumber = -1;
+constexpr pin_number kLED_USBRXPinNumber = -1;
+constexpr pin_number kOutput10_PinNumber = -1;
+constexpr pin_number kOutput11_PinNumber = -1;
+constexpr pin_number kOutput12_PinNumber = -1;
+constexpr pin_number kOutput13_PinNumber = -1;
+constexpr pin_number kOutput14_PinNumber = -1;
+constexpr pin_number kOutput15_PinNumber = -1;
+constexpr pin_number kOutput16_PinNumber = -1;
+constexpr pin_number kOutput17_PinNumber = -1;
+constexpr pin_number kOutput18_PinNumber = -1;
+constexpr pin_number kOutput1_PinNumber = -1;
+constexpr pin_number kOutput2_PinNumber = -1;
+constexpr pin_number kOutput3_PinNumber = -1;
+constexpr pin_number kOutput4_PinNumber = -1;
+constexpr pin_number kOutput5_PinNumber = -1;
+constexpr pin_number kOutput6_PinNumber = -1;
+constexpr pin_number kOutput7_PinNumber = -1;
+constexpr pin_number kOutput8_PinNumber = -1;
+constexpr pin_number kOutput9_PinNumber = -1;
+constexpr pin_number kOutputSAFE_PinNumber = -1;
+constexpr pin_number kPressure_ChipSelectPinNumber = -1;
+constexpr pin_number kSD_CardDetectPinNumber = -1;
+constexpr pin_number kSD_ChipSelectPinNumber = -1;
+constexpr pin_number kSPI0_MISOPinNumber = -1;
+constexpr pin_number kSPI0_MOSIPinNumber = -1;
+constexpr pin_number kSPI0_SCKPinNumber = -1;
+constexpr pin_number kSPI_MISOPinNumber = -1;
+constexpr pin_number kSPI_MOSIPinNumber = -1;
+constexpr pin_number kSPI_SCKPinNumber = -1;
+constexpr pin_number kSerial_CTSPinNumber = -1;
+constexpr pin_number kSerial_RTSPinNumber = -1;
+constexpr pin_number kSerial_RXPinNumber = -1;
+constexpr pin_number kSerial_TXPinNumber = -1;
+constexpr pin_number kServo1_PinNumber = -1;
+constexpr pin_number kSocket1_DirPinNumber = -1;
+constexpr pin_number kSocket1_EnablePinNumber = -1;
+constexpr pin_number kSocket1_Microstep_0PinNumber = -1;
+constexpr pin_number kSocket1_Microstep_1PinNumber = -1;
+constexpr pin_number kSocket1_Microstep_2PinNumber = -1;
+constexpr pin_number kSocket1_SPISlaveSelectPinNumber = -1;
+constexpr pin_number kSocket1_StepPinNumber = -1;
+constexpr pin_number kSocket1_VrefPinNumber = -1;
+constexpr pin_number kSocket2_DirPinNumber = -1;
+constexpr pin_number kSocket2_EnablePinNumber = -1;
+constexpr pin_number kSocket2_Microstep_0PinNumber = -1;
+constexpr pin_number kSocket2_Microstep_1PinNumber = -1;
+constexpr pin_number kSocket2_Microstep_2PinNumber = -1;
+constexpr pin_number kSocket2_SPISlaveSelectPinNumber = -1;
+constexpr pin_number kSocket2_StepPinNumber = -1;
+constexpr pin_number kSocket2_VrefPinNumber = -1;
+constexpr pin_number kSocket3_DirPinNumber = -1;
+constexpr pin_number kSocket3_EnablePinNumber = -1;
+constexpr pin_number kSocket3_Microstep_0PinNumber = -1;
+constexpr pin_number kSocket3_Microstep_1PinNumber = -1;
+constexpr pin_number kSocket3_Microstep_2PinNumber = -1;
+constexpr pin_number kSocket3_SPISlaveSelectPinNumber = -1;
+constexpr pin_number kSocket3_StepPinNumber = -1;
+constexpr pin_number kSocket3_VrefPinNumber = -1;
+constexpr pin_number kSocket4_DirPinNumber = -1;
+constexpr pin_number kSocket4_EnablePinNumber = -1;
+constexpr pin_number kSocket4_Microstep_0PinNumber = -1;
+constexpr pin_number kSocket4_Microstep_1PinNumber = -1;
+constexpr pin_number kSocket4_Microstep_2PinNumber = -1;
+constexpr pin_number kSocket4_SPISlaveSelectPinNumber = -1;
+constexpr pin_number kSocket4_StepPinNumber = -1;
+constexpr pin_number kSocket4_VrefPinNumber = -1;
+constexpr pin_number kSocket5_DirPinNumber = -1;
+constexpr pin_number kSocket5_EnablePinNumber = -1;
+constexpr pin_number kSocket5_Microstep_0PinNumber = -1;
+constexpr pin_number kSocket5_Microstep_1PinNumber = -1;
+constexpr pin_number kSocket5_Microstep_2PinNumber = -1;
+constexpr pin_number kSocket5_StepPinNumber = -1;
+constexpr pin_number kSocket5_VrefPinNumber = -1;
+constexpr pin_number kSocket6_DirPinNumber = -1;
+constexpr pin_number kSocket6_EnablePinNumber = -1;
+constexpr pin_number kSocket6_Microstep_0PinNumber = -1;
+constexpr pin_number kSocket6_Microstep_1PinNumber = -1;
+constexpr pin_number kSocket6_Microstep_2PinNumber = -1;
+constexpr pin_number kSocket6_StepPinNumber = -1;
+constexpr pin_number kSocket6_VrefPinNumber = -1;
+constexpr pin_number kSpindle_DirPinNumber = -1;
+constexpr pin_number kSpindle_EnablePinNumber = -1;
+constexpr pin_number kUSBVBUS_PinNumber = -1;
+
+} // namespace Motate
+
+#endif // MOTATE_PIN_ASSIGNMENTS_H_ONCE
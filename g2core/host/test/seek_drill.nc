@@ -0,0 +1,23 @@
+(seek_drill.nc - resume a job inside canned drilling cycle hole lists)
+(run by make check - see seek_test.sh, the resume lines are in the Makefile)
+G21 G90 G17 G54
+G0 Z10
+G0 X0 Y0
+(G98 - absolute hole list, retract to the initial level between holes)
+G98 G81 X10 Y10 Z-5 R2 F300
+X20 Y10
+X30 Y10
+X40 Y15
+G80
+(G99 - peck drilling, incremental holes with L repeats, retract to R)
+G0 X0 Y30 Z5
+G99 G83 X5 Y30 Z-6 R1 Q2 F200
+G91 X5 L3
+Y5 L2
+G90 X50 Y50
+(the clear level of the last cycle and the incremental moves below only land where)
+(the full run does if the seek left the model where the cycles would)
+G91 G83 X5 L2
+G80
+G1 X5 Y5 Z1 F600
+G90
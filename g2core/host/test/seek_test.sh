@@ -0,0 +1,77 @@
+#!/bin/sh
+#
+# seek_test.sh - check that a job resumed with {seek:N} ends where the full job does
+#
+# This file is part of the g2core project.
+#
+# This file ("the software") is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License, version 2 as published by the
+# Free Software Foundation. You should have received a copy of the GNU General Public
+# License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+#
+# THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+# WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+# OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+# SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+# OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+#   test/seek_test.sh build/settings_shopbot_sbv300/g2est test/seek_drill.nc 8 15
+#
+# Runs the job, then once for each line given with {seek:line} in front of it. A resumed
+# run fails if any block returns an error, or if it doesn't end at the position of the
+# full run. Use jobs with incremental moves after the resume points, so a model left in
+# the wrong place by the skipped blocks shows up in the end position.
+#
+# g2est numbers the lines by their position in the file, so the seek line is moved down
+# by one for the {seek} line put in front of the job.
+#
+
+G2EST=$1
+JOB=$2
+shift 2
+TMP=${TMPDIR:-/tmp}/seek_test.$$
+trap 'rm -f $TMP.*' EXIT
+
+# errors - the status of every response after the first (the startup message)
+# end     - the last posx, posy and posz reported (status reports only send changes)
+run() {
+    "$G2EST" -v "$1" 2>&1 >/dev/null | awk '
+        /"f":\[/ {
+            if (n++ && match($0, /"f":\[[0-9]+,[0-9]+/)) {
+                split(substr($0, RSTART, RLENGTH), f, ",");
+                if (f[2] != 0) { print "error " f[2] ": " $0 }
+            }
+        }
+        /"sr":/ {
+            for (i = 0; i < 3; i++) {
+                axis = substr("xyz", i + 1, 1);
+                if (match($0, "\"pos" axis "\":-?[0-9.]+")) {
+                    pos[axis] = substr($0, RSTART + 7, RLENGTH - 7);
+                }
+            }
+        }
+        END { printf("end %.3f %.3f %.3f\n", pos["x"], pos["y"], pos["z"]) }'
+}
+
+run "$JOB" > $TMP.full
+if grep -q '^error' $TMP.full; then
+    echo "$JOB: the full job reports errors"
+    grep '^error' $TMP.full
+    exit 1
+fi
+
+failed=0
+for line in "$@"; do
+    { echo "{\"seek\":$((line + 1))}"; cat "$JOB"; } > $TMP.nc
+    run $TMP.nc > $TMP.seek
+    if grep -q '^error' $TMP.seek || ! diff -q $TMP.full $TMP.seek >/dev/null; then
+        echo "$JOB: resume at line $line FAILED"
+        echo "  full:    $(grep '^end' $TMP.full)"
+        sed 's/^/  resumed: /' $TMP.seek
+        failed=1
+    else
+        echo "$JOB: resume at line $line ok ($(grep '^end' $TMP.seek))"
+    fi
+done
+exit $failed
@@ -199,6 +199,7 @@ static stat_t _json_parser_kernal(nvObj_t *nv, char *str)
         // propagate the group from previous NV pair (if relevant)
         if (group[0] != NUL) {
             strncpy(nv->group, group, GROUP_LEN);   // copy the parent's group to this child
+            nv->group[GROUP_LEN] = NUL;
         }
         // validate the token and get the index
         if ((nv->index = nv_get_index(nv->group, nv->token)) == NO_MATCH) {
@@ -207,6 +208,7 @@ static stat_t _json_parser_kernal(nvObj_t *nv, char *str)
         }
         if ((nv_index_is_group(nv->index)) && (nv_group_is_prefixed(nv->token))) {
             strncpy(group, nv->token, GROUP_LEN);   // record the group ID
+            group[GROUP_LEN] = NUL;
         }
         nv_coerce_types(nv);                        // adjust types based on type fields in configApp table
         if ((nv = nv->nx) == NULL) {
@@ -302,7 +304,8 @@ static stat_t _get_nv_pair(nvObj_t *nv, char **pstr, int8_t *depth)
     for (i=0; true; i++, (*pstr)++) {
         if (strchr(separators, (int)**pstr) != NULL) {
             *(*pstr)++ = NUL;
-            strncpy(nv->token, name, TOKEN_LEN+1);      // copy the string to the token
+            strncpy(nv->token, name, TOKEN_LEN);        // copy the string to the token
+            nv->token[TOKEN_LEN] = NUL;
             break;
         }
         if (i == TOKEN_LEN) {
@@ -297,6 +297,15 @@ struct FourCableKinematics : KinematicsBase<axes, motors> {
 
                     this->cable_external_encoder_position[joint] = new_position;
 
+                    // Also give the reading to the encoder module, so the following error
+                    // (_fe) sees lost steps. This kinematics already corrects from the same
+                    // encoders, so leave the motor's correction gains ({Ncp:, {Nci:) at 0.
+                    auto motor = this->joint_map[joint];
+                    if (motor >= 0) {
+                        en_set_external_steps(motor, new_position * this->external_encoder_mm_per_rev[joint] *
+                                                         this->steps_per_unit[motor]);
+                    }
+
                     ExternalEncoders[joint]->requestAngleFraction();
                 });
 
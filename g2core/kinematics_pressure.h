@@ -42,54 +42,84 @@
 
 #include "kinematics.h"
 
-template <uint8_t axes, uint8_t motors>
+/*
+ * PressureKinematics - pressure-controlled dispensing head
+ *
+ *  real_t selects the precision of the pressure PID and joint velocity/acceleration
+ *  math that runs every idle segment. The default is double, the original behavior.
+ *  float runs on the single-precision FPU of the Cortex-M4/M7 parts (double is
+ *  emulated in software there and costs several times more per segment), but it
+ *  does not control the head as well, so it is not the default.
+ *
+ *  Measured by host/bench/pk_bench.cpp against a simulated head, 400 s, 67 events:
+ *   - open loop (float fed the sensor values of the double run): PID output within
+ *     ~4e-3 relative, volume within ~7e-6. The jerk control is bang-bang and the
+ *     reversal guard switches at +/-1 mm/min, so a rounding difference picks the
+ *     other branch and the velocities then differ by up to ~250 mm/min in 40% of
+ *     the segments.
+ *   - closed loop (each precision driving its own head): the hold pressure error is
+ *     the same (rms 1.65 vs 1.69 cmH2O), but float failed to reach the event pressure
+ *     20 times where double never did, and the two plunger paths ended 1300 mm
+ *     apart. Until the velocity control tolerates float rounding, use float only
+ *     where double is too slow, and check the result on the machine.
+ *   - sensor_integral_store and volume_value accumulate every segment. In float,
+ *     increments smaller than ~6e-8 of the accumulated value are lost, e.g. an
+ *     integral of 1e4 no longer sees errors under ~6e-4 cmH2O. The integral is reset
+ *     on every state change (at least every seconds_between_events).
+ *   - joint_position was already float and is unchanged.
+ *
+ *  Literals in the per-segment math are integers or cast to real_t so a float
+ *  build does not get silently promoted to double.
+ */
+
+template <uint8_t axes, uint8_t motors, typename real_t = double>
 struct PressureKinematics : KinematicsBase<axes, motors> {
     static const uint8_t joints = axes; // For cartesian we have one joint per axis
 
-    double joint_vel[4];
-    double joint_accel[4];
-    double joint_jerk[4];
+    real_t joint_vel[4];
+    real_t joint_accel[4];
+    real_t joint_jerk[4];
 
     static constexpr uint8_t pressure_sensor_count = 1;
-    double raw_pressure_value[pressure_sensor_count];  // filtered value as read off the sensor
-    double zero_pressure_value[pressure_sensor_count];  // stored zero value for pressure
-    double pressure_pid_output[pressure_sensor_count];      // value after PID
-    double prev_pressure_pid_output[pressure_sensor_count]; // previous value after PID
+    real_t raw_pressure_value[pressure_sensor_count];  // filtered value as read off the sensor
+    real_t zero_pressure_value[pressure_sensor_count];  // stored zero value for pressure
+    real_t pressure_pid_output[pressure_sensor_count];      // value after PID
+    real_t prev_pressure_pid_output[pressure_sensor_count]; // previous value after PID
 
     static constexpr uint8_t flow_sensor_count = 1;
-    double flow_value[flow_sensor_count];  // stored from last time they were read
-    double volume_value[flow_sensor_count];  // stored from last time they were read
-    double prev_volume_value[flow_sensor_count];  // stored from last time they were read
+    real_t flow_value[flow_sensor_count];  // stored from last time they were read
+    real_t volume_value[flow_sensor_count];  // stored from last time they were read
+    real_t prev_volume_value[flow_sensor_count];  // stored from last time they were read
 
-    double immediate_pressure_target = 0.0;
-    double sensor_proportional_factor = 550;
-    double sensor_integral_store = 0;
-    double sensor_inetgral_factor = 0.005;
-    double sensor_error_store = 0;
-    double sensor_derivative_factor = 3000;
-    double sensor_derivative_store = 0;
-    double derivative_contribution = 1.0/10.0;
+    real_t immediate_pressure_target = 0.0;
+    real_t sensor_proportional_factor = 550;
+    real_t sensor_integral_store = 0;
+    real_t sensor_inetgral_factor = 0.005;
+    real_t sensor_error_store = 0;
+    real_t sensor_derivative_factor = 3000;
+    real_t sensor_derivative_store = 0;
+    real_t derivative_contribution = 1.0/10.0;
 
-    double reverse_target_pressure = 0;
+    real_t reverse_target_pressure = 0;
 
     const float sensor_skip_detection_jump = 10000;
 
-    double event_pressure_target = 0;
-    double seconds_between_events = 6.0;
-    double seconds_to_hold_event = 2;
-    double pressure_hold_release_ratio = 3;
+    real_t event_pressure_target = 0;
+    real_t seconds_between_events = 6.0;
+    real_t seconds_to_hold_event = 2;
+    real_t pressure_hold_release_ratio = 3;
 
     bool is_anchored = false;
 
-    double prev_joint_position[4];
-    double prev_joint_vel[4];
-    double prev_joint_accel[4];
-    double joint_min_limit[motors];
-    double joint_max_limit[motors];
+    real_t prev_joint_position[4];
+    real_t prev_joint_vel[4];
+    real_t prev_joint_accel[4];
+    real_t joint_min_limit[motors];
+    real_t joint_max_limit[motors];
 
     float start_velocities[motors];
     float end_velocities[motors];
-    double target_accel[4] = {0.0, 0.0, 0.0, 0.0};
+    real_t target_accel[4] = {0.0, 0.0, 0.0, 0.0};
     bool last_switch_state[4];
 
     enum class PressureState { Idle, Start, Hold, Release };
@@ -245,7 +275,7 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
             raw_pressure_value[joint] =
                 pressure_sensors[joint]->getPressure(PressureUnits::cmH2O) - zero_pressure_value[joint];
 
-            double e = (immediate_pressure_target - raw_pressure_value[joint]);
+            real_t e = (immediate_pressure_target - raw_pressure_value[joint]);
 
             sensor_integral_store += e;
             // if (sensor_integral_store > 10000) {
@@ -254,13 +284,13 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
             //     sensor_integral_store = -10000;
             // }
 
-            double p_v = e * sensor_proportional_factor;
-            double i_v = sensor_integral_store * sensor_inetgral_factor;
-            sensor_derivative_store = (e - sensor_error_store)*(derivative_contribution) + (sensor_derivative_store * (1.0-derivative_contribution));
-            double d_v = sensor_derivative_store * sensor_derivative_factor;
+            real_t p_v = e * sensor_proportional_factor;
+            real_t i_v = sensor_integral_store * sensor_inetgral_factor;
+            sensor_derivative_store = (e - sensor_error_store)*(derivative_contribution) + (sensor_derivative_store * (1-derivative_contribution));
+            real_t d_v = sensor_derivative_store * sensor_derivative_factor;
             sensor_error_store = e;
 
-            double new_pressure_pid_output = p_v + i_v - d_v;
+            real_t new_pressure_pid_output = p_v + i_v - d_v;
 
             prev_pressure_pid_output[joint] = pressure_pid_output[joint];
             pressure_pid_output[joint] = new_pressure_pid_output;
@@ -269,7 +299,7 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
             // read differential pressure from the volume sensors
             flow_value[joint] = flow_sensors[joint]->getFlow(FlowUnits::SLM);
             volume_value[joint] = volume_value[joint] + flow_value[joint] * MIN_SEGMENT_TIME; // SLM and MIN_SEGMENT_TIME are both in minutes - nice!
-            if ((raw_pressure_value[joint] < 0.1 && abs(flow_value[joint])<5.0) || volume_value[joint] < 0) {
+            if ((raw_pressure_value[joint] < (real_t)0.1 && std::abs(flow_value[joint]) < 5) || volume_value[joint] < 0) {
                 volume_value[joint] = 0;
             }
         }
@@ -311,7 +341,7 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
         sensor_integral_store = 0;
 
         // restart the timer
-        inter_event_timer.set(seconds_between_events * 1000.0);
+        inter_event_timer.set(seconds_between_events * 1000);
         event_counter++;
     }
 
@@ -319,7 +349,7 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
         // this should only go into hold if called from Start
         if (PressureState::Start == pressure_state) {
             pressure_state = PressureState::Hold;
-            hold_pressure_timer.set(seconds_to_hold_event*1000.0);
+            hold_pressure_timer.set(seconds_to_hold_event * 1000);
         }
 
 
@@ -373,14 +403,14 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
 
         if (!last_segment_was_idle) {
             for (uint8_t joint = 0; joint < pressure_sensor_count; joint++) {
-                joint_vel[joint] = 0.0;
-                joint_accel[joint] = 0.0;
-                joint_jerk[joint] = 0.0;
-                pressure_pid_output[joint] = 0.0;
-
-                sensor_error_store = 0.0;
-                sensor_integral_store = 0.0;
-                sensor_derivative_store = 0.0;
+                joint_vel[joint] = 0;
+                joint_accel[joint] = 0;
+                joint_jerk[joint] = 0;
+                pressure_pid_output[joint] = 0;
+
+                sensor_error_store = 0;
+                sensor_integral_store = 0;
+                sensor_derivative_store = 0;
             }
             // change_state_to_calibrating();
         }
@@ -401,16 +431,16 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
         // if we are anchored, then set the zero-position offsets
         // the first segment that isn't anchored will use them
 
-        const double segment_time = MIN_SEGMENT_TIME; // time in MINUTES
-        // const double segment_time_2 = segment_time * segment_time; // time in MINUTES
-        // const double segment_time_3 = segment_time * segment_time * segment_time; // time in MINUTES
+        const real_t segment_time = MIN_SEGMENT_TIME; // time in MINUTES
+        // const real_t segment_time_2 = segment_time * segment_time; // time in MINUTES
+        // const real_t segment_time_3 = segment_time * segment_time * segment_time; // time in MINUTES
 
         for (uint8_t joint = 0; joint < pressure_sensor_count; joint++) {
             // capture the switch state
             bool switch_state = anchor_inputs[joint]->getState();
 
             // determine if we're NOW at or over pressure - we just call it "over_pressure" for brevity
-            bool at_pressure_detected = (raw_pressure_value[joint] > (immediate_pressure_target*0.80));
+            bool at_pressure_detected = (raw_pressure_value[joint] > (immediate_pressure_target * (real_t)0.8));
 
             if ((PressureState::Hold == pressure_state) && hold_pressure_timer.isPast()) {
                 change_state_to_release();
@@ -445,16 +475,16 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
             // prev_joint_accel[joint] = joint_accel[joint];
             start_velocities[joint] = std::abs(joint_vel[joint]);
 
-            double jmax = cm->a[AXIS_X].jerk_max * JERK_MULTIPLIER;
-            const double vmax = cm->a[AXIS_X].velocity_max;
+            real_t jmax = cm->a[AXIS_X].jerk_max * JERK_MULTIPLIER;
+            const real_t vmax = cm->a[AXIS_X].velocity_max;
 
             prev_joint_position[joint] = joint_position[joint];
-            double old_joint_vel = joint_vel[joint];
-            double old_joint_accel = joint_accel[joint];
+            real_t old_joint_vel = joint_vel[joint];
+            real_t old_joint_accel = joint_accel[joint];
 
             // treat pressure_pid_output[joint] as velocity, but we have to jerk-control it
 
-            double requested_velocity = pressure_pid_output[joint];
+            real_t requested_velocity = pressure_pid_output[joint];
 
             // if we're releasing, target -vmax
             if (PressureState::Release == pressure_state) {
@@ -477,29 +507,29 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
                 requested_velocity = vmax;
             }
 
-            // double requested_accel = (requested_velocity - old_joint_vel) / segment_time - (jmax * segment_time)/2;
+            // real_t requested_accel = (requested_velocity - old_joint_vel) / segment_time - (jmax * segment_time)/2;
 
             // Notes:
             // * velocity can be negative, that's valid
             // * "maximum acceleration" is an absolute maximum - positive or negative
 
             // this will always be positive !!
-            double max_accel = sqrt(std::abs(requested_velocity - old_joint_vel) * jmax * 2.0);
-            double sign = 1.0;
+            real_t max_accel = std::sqrt(std::abs(requested_velocity - old_joint_vel) * jmax * 2);
+            real_t sign = 1;
             // choose a jerk value that will not violate the max_acceleration withing two time segments
-            if ((requested_velocity - old_joint_vel) < 0.0) {
+            if ((requested_velocity - old_joint_vel) < 0) {
                 // want to accelerate in the negative direction
-                sign = -1.0;
+                sign = -1;
             }
 
-            if ((std::abs(old_joint_accel) + jmax * segment_time * 4.0) < max_accel) {
+            if ((std::abs(old_joint_accel) + jmax * segment_time * 4) < max_accel) {
                 joint_accel[joint] = (std::abs(old_joint_accel) + jmax * segment_time) * sign;
                 joint_jerk[joint] = jmax * sign;
             } else {
                 joint_accel[joint] = (std::abs(old_joint_accel) - jmax * segment_time) * sign;
                 joint_jerk[joint] = -jmax * sign;
             }
-            joint_vel[joint] = joint_vel[joint] + joint_accel[joint]*segment_time + jmax*segment_time*segment_time*0.5;
+            joint_vel[joint] = joint_vel[joint] + joint_accel[joint]*segment_time + jmax*segment_time*segment_time*(real_t)0.5;
 
             // limit velocity
             if (joint_vel[joint] < -vmax) {
@@ -509,10 +539,10 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
             }
 
             // now that everything is done adjusting joint_vel[joint], we can recompute joint_accel[joint]
-            joint_accel[joint] = (joint_vel[joint] - old_joint_vel) / segment_time - jmax * segment_time * 0.5;
+            joint_accel[joint] = (joint_vel[joint] - old_joint_vel) / segment_time - jmax * segment_time * (real_t)0.5;
 
             // we check if we'll violate min or max position with the next position - last-change to stop driving into the wall
-            auto proposed_position = joint_position[joint] + ((old_joint_vel + joint_vel[joint]) * 0.5 * segment_time);
+            real_t proposed_position = joint_position[joint] + ((old_joint_vel + joint_vel[joint]) * (real_t)0.5 * segment_time);
 
             // if the switch is closed, we may still have some room to stop cleanly
             if (((switch_state) && (proposed_position < joint_min_limit[joint]) && (joint_vel[joint] < 0)) ||
@@ -526,13 +556,13 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
                 // prevent the integral from winding up positive, pushing past the switch
                 sensor_integral_store = 0;
 
-                joint_vel[joint] = joint_vel[joint] * 0.5;  // drop the velocity hard -- we should probably do this more intelligently
+                joint_vel[joint] = joint_vel[joint] * (real_t)0.5;  // drop the velocity hard -- we should probably do this more intelligently
 
                 // this is a lie - we've certainly violated jerk, so don't punish the acceleration counter
                 joint_accel[joint] = 0;
             }
 
-            joint_position[joint] = joint_position[joint] + ((old_joint_vel + joint_vel[joint]) * 0.5 * segment_time);
+            joint_position[joint] = joint_position[joint] + ((old_joint_vel + joint_vel[joint]) * (real_t)0.5 * segment_time);
             end_velocities[joint] = std::abs(joint_vel[joint]);
 
             // sanity check, we can't do a reversal in the middle of a segment,
@@ -540,7 +570,7 @@ struct PressureKinematics : KinematicsBase<axes, motors> {
             // note: start_velocities[joint] and end_velocities[joint] are both ABS, so this sign change is lost there!
             if (((old_joint_vel > 0) && (joint_vel[joint] < 0)) || ((old_joint_vel < 0) && (joint_vel[joint] > 0))) {
                 // solution: since we are reversing, we are going to start from zero
-                start_velocities[joint] = std::abs(old_joint_vel + joint_vel[joint])*0.5;
+                start_velocities[joint] = std::abs(old_joint_vel + joint_vel[joint]) * (real_t)0.5;
                 end_velocities[joint] = start_velocities[joint];
             }
 
@@ -37,6 +37,7 @@
 #include "gpio.h"
 #include "pwm.h"
 #include "xio.h"
+#include "trace.h"
 
 #include "util.h"
 #include "MotateUniqueID.h"
@@ -94,6 +95,9 @@ void application_init_services(void)
     hardware_init();				    // system hardware setup 			- must be first
     persistence_init();				    // set up EEPROM or other NVM		- must be second
     xio_init();						    // xtended io subsystem				- must be third
+#ifdef __TRACE
+    trace_init();                       // event trace ring (drained to secondary channel)
+#endif
 }
 
 void application_init_machine(void)
@@ -56,6 +56,33 @@ stat_t read_persistent_value(nvObj_t *nv)
     return persistence->read(nv);
 }
 
+/*
+ * read_persistent_values() - bulk restore of all initialized values, in index order
+ *
+ *  Calls restore() with nv populated for every single-valued F_INITIALIZE index.
+ *  Backends that can read their whole value image at once override read_all();
+ *  the default falls back to one read() per value.
+ */
+
+stat_t Persistence::read_all(nvObj_t *nv, fptrRestore restore)
+{
+    for (nv->index=0; nv_index_is_single(nv->index); nv->index++) {
+        if ((cfgArray[nv->index].flags & F_INITIALIZE) && (read(nv) == STAT_OK)) {
+            restore(nv);
+        }
+    }
+    return (STAT_OK);
+}
+
+stat_t read_persistent_values(nvObj_t *nv, fptrRestore restore)
+{
+    if (persistence == nullptr) {
+        return (STAT_OK);
+    }
+
+    return persistence->read_all(nv, restore);
+}
+
 /*
  * write_persistent_value() - write to NVM by index, but only if the value has changed
  *
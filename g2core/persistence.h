@@ -32,10 +32,13 @@
 
 //**** persistence function prototypes ****
 
+typedef void (*fptrRestore)(nvObj_t *nv);   // receives each value restored by a bulk read
+
 class Persistence {
    public:
     virtual void init();
     virtual stat_t read(nvObj_t *nv);
+    virtual stat_t read_all(nvObj_t *nv, fptrRestore restore);
     virtual stat_t write(nvObj_t *nv);
     virtual stat_t periodic();
 };
@@ -44,6 +47,7 @@ extern Persistence *persistence;
 
 void persistence_init(void);
 stat_t read_persistent_value(nvObj_t *nv);
+stat_t read_persistent_values(nvObj_t *nv, fptrRestore restore);
 stat_t write_persistent_value(nvObj_t *nv);
 stat_t write_persistent_values_callback();
 
@@ -36,6 +36,8 @@
 #include "report.h"
 #include "util.h"
 #include "spindle.h"
+#include "trace.h"
+#include "raster.h"
 #include "xio.h"    // DIAGNOSTIC
 
 // execute routines (NB: These are all called from the LO interrupt)
@@ -45,6 +47,7 @@ static stat_t _exec_aline_tail(mpBuf_t *bf);
 static stat_t _exec_aline_segment(void);
 static void   _exec_aline_normalize_block(mpBlockRuntimeBuf_t *b);
 static stat_t _exec_aline_feedhold(mpBuf_t *bf);
+static void   _exec_aline_override(mpBuf_t *bf, const float factor);
 
 static void _init_forward_diffs(float v_0, float v_1);
 
@@ -181,6 +184,7 @@ static stat_t _plan_aline(mpBuf_t *bf, float entry_velocity)
         "_plan_line() zero or negative length block after calculate_ramps()");
 
     bf->buffer_state = MP_BUFFER_FULLY_PLANNED;     //...here
+    TRACE(TRACE_BUFFER_STATE, bf->buffer_number, MP_BUFFER_FULLY_PLANNED);
     bf->plannable = false;
     return (STAT_OK);                               // report that we planned something...
 }
@@ -190,11 +194,15 @@ stat_t mp_forward_plan()
     mpBuf_t *bf = mp_get_run_buffer();
     float entry_velocity;
 
+    TRACE(TRACE_FORWARD_PLAN_START, 0, 0);
+
     // Case 0: Examine current running buffer for early exit conditions
     if (bf == NULL) {                               // case 0a: NULL means nothing is running - this is OK
+        TRACE(TRACE_FORWARD_PLAN_END, 0, 0);
         return (STAT_OK);
     }
     if (bf->buffer_state < MP_BUFFER_BACK_PLANNED) { // case 0b: nothing to do. get outta here.
+        TRACE(TRACE_FORWARD_PLAN_END, 0, 0);
         return (STAT_OK);
     }
 
@@ -213,6 +221,7 @@ stat_t mp_forward_plan()
         while (bf->block_type >= BLOCK_TYPE_COMMAND) {
             if (bf->buffer_state == MP_BUFFER_BACK_PLANNED) {
                 bf->buffer_state = MP_BUFFER_FULLY_PLANNED; // "planning" is just setting the state (for now)
+                TRACE(TRACE_BUFFER_STATE, bf->buffer_number, MP_BUFFER_FULLY_PLANNED);
                 planned_something = true;
             }
             bf = bf->nx;
@@ -231,6 +240,7 @@ stat_t mp_forward_plan()
             planned_something = true;
         }
     }
+    TRACE(TRACE_FORWARD_PLAN_END, planned_something, 0);
     return (planned_something ? STAT_OK : STAT_NOOP);
 }
 
@@ -257,6 +267,9 @@ stat_t mp_exec_move()
     // NULL means nothing's running - this is OK
     // If something is MP_BUFFER_BACK_PLANNED, we don't want to idle or prep_null()
     if ((bf = mp_get_run_buffer()) == NULL || (bf->buffer_state < MP_BUFFER_BACK_PLANNED)) {
+        if (cm_jgv_exec()) {
+            return STAT_OK; // velocity jog is driving the runtime directly (cycle_jgv.cpp)
+        }
         if (kn->idle_task()) {
             return STAT_OK; // IOW: we need something loaded
         }
@@ -292,6 +305,7 @@ stat_t mp_exec_move()
 
             if (bf->buffer_state == MP_BUFFER_FULLY_PLANNED) {
                 bf->buffer_state = MP_BUFFER_RUNNING;       // must precede mp_planner_time_acccounting()
+                TRACE(TRACE_BUFFER_STATE, bf->buffer_number, MP_BUFFER_RUNNING);
             } else {
                 return (STAT_NOOP);
             }
@@ -450,6 +464,7 @@ stat_t mp_exec_aline(mpBuf_t *bf)
 
         // Check to make sure no sections are less than MIN_SEGMENT_TIME & adjust if necessary
         _exec_aline_normalize_block(mr->r);
+        mp->run_time_remaining = mr->r->head_time + mr->r->body_time + mr->r->tail_time;  // counted down per segment
 
         // transfer move parameters from planner buffer to the runtime
         copy_vector(mr->unit, bf->unit);
@@ -491,7 +506,15 @@ stat_t mp_exec_aline(mpBuf_t *bf)
         }
     }
 
-    // Feed Override Processing - We need to handle the following cases (listed in rough sequence order):
+    // Feed Override Processing - If the override changed since this block was planned reshape what's
+    // left of it now. Only from a section start or a body, where jerk is zero. A head or tail that is
+    // already ramping finishes first. Feedholds take precedence.
+    if ((cm->hold_state == FEEDHOLD_OFF) && ((mr->section_state == SECTION_NEW) || (mr->section == SECTION_BODY))) {
+        float factor = mp_get_override_factor(bf);
+        if (std::abs(factor - bf->override_factor) > EPSILON4) {
+            _exec_aline_override(bf, factor);
+        }
+    }
 
     // Feedhold Processing - We need to handle the following cases (listed in rough sequence order):
     if (cm->hold_state != FEEDHOLD_OFF) {
@@ -537,6 +560,7 @@ stat_t mp_exec_aline(mpBuf_t *bf)
     if (cm->hold_state == FEEDHOLD_DECEL_TO_ZERO) {
         if ((status == STAT_OK) || (status == STAT_NOOP)) {
             cm->hold_state = FEEDHOLD_DECEL_COMPLETE;
+            TRACE(TRACE_FEEDHOLD, FEEDHOLD_DECEL_COMPLETE, cm->hold_type);
             bf->block_state = BLOCK_INITIAL_ACTION;     // reset bf so it can restart the rest of the move
         }
     }
@@ -879,6 +903,161 @@ static stat_t _exec_aline_tail(mpBuf_t *bf)
     return (STAT_EAGAIN);
 }
 
+/*********************************************************************************************
+ * Height-map (mesh) compensation
+ *
+ *  mp_mesh_load()    - load a Z height map and enable compensation
+ *  mp_mesh_disable() - disable compensation
+ *  mp_mesh_enabled() - true if compensation is active
+ *  mp_mesh_offset()  - Z offset of the map at a machine XY (for use outside the runtime)
+ *  mp_inverse_kinematics() - inverse kinematics of a runtime target with the map applied
+ *
+ *  The map is a grid of Z heights in machine coordinates, stored flat and row-major,
+ *  made relative to its first point so the surface at that point is the reference.
+ *  The offset is added to the Z target of every runtime segment just before inverse
+ *  kinematics, so long moves follow the surface without being subdivided upstream.
+ *  Positions in the planner, runtime and reports stay uncompensated (nominal).
+ *
+ *  Every path that turns a runtime position into steps must apply the map the same way:
+ *  segments from the planner and the direct jog runtime use mp_inverse_kinematics(),
+ *  and mp_set_steps_to_runtime_position() syncs the encoders to the compensated position.
+ *
+ *  Outside the map the offset is taken from the nearest edge. Within a cell the
+ *  bilinear patch is reduced to z = z0 + dx*(dzx + dzxy*dy) + dzy*dy around the cell
+ *  corner. The runtime keeps the patch of the cell it's in, so a segment that stays
+ *  in the same cell as the previous one costs 4 compares and a few multiply-adds.
+ *
+ *  Loading or clearing the map does not move the tool. The planner and runtime Z are
+ *  shifted by the change of offset at the current XY so the steps stay where they are,
+ *  and the next move takes up the difference as part of its planned (jerk limited)
+ *  motion. Until then the reported Z differs from the model by that amount. The map
+ *  may only be changed while the planner is empty - see cm_set_mesh().
+ */
+
+typedef struct mpMeshCell {             // bilinear patch for one cell of the map
+    float lo[2];                        // XY of the low corner
+    float hi[2];                        // XY of the high corner
+    float z0;                           // Z offset at the low corner
+    float dzx, dzy, dzxy;               // slope terms
+} mpMeshCell_t;
+
+struct mpMeshSingleton {
+    volatile bool enabled;              // read by the runtime (LO interrupt)
+    uint8_t nx, ny;                     // number of points along X and Y
+    float origin[2];                    // XY of point (0,0) - the low corner of the map
+    float limit[2];                     // XY of the high corner of the map
+    float step[2];                      // spacing between points (always positive)
+    float inv_step[2];
+    float z[PROBE_GRID_MAX * PROBE_GRID_MAX];
+    mpMeshCell_t cell;                  // runtime cache - cell the last segment was in
+};
+static struct mpMeshSingleton mesh;
+
+static void _mesh_find_cell(const float x, const float y, mpMeshCell_t *c)
+{
+    uint8_t i = std::min((int)((x - mesh.origin[0]) * mesh.inv_step[0]), mesh.nx - 2);
+    uint8_t j = std::min((int)((y - mesh.origin[1]) * mesh.inv_step[1]), mesh.ny - 2);
+    const float *z = &mesh.z[j * mesh.nx + i];
+
+    c->lo[0] = mesh.origin[0] + mesh.step[0] * i;
+    c->lo[1] = mesh.origin[1] + mesh.step[1] * j;
+    c->hi[0] = c->lo[0] + mesh.step[0];
+    c->hi[1] = c->lo[1] + mesh.step[1];
+    c->z0 = z[0];
+    c->dzx = (z[1] - z[0]) * mesh.inv_step[0];
+    c->dzy = (z[mesh.nx] - z[0]) * mesh.inv_step[1];
+    c->dzxy = (z[mesh.nx + 1] - z[mesh.nx] - z[1] + z[0]) * mesh.inv_step[0] * mesh.inv_step[1];
+}
+
+static float _mesh_offset(float x, float y, mpMeshCell_t *c)
+{
+    x = std::min(std::max(x, mesh.origin[0]), mesh.limit[0]);
+    y = std::min(std::max(y, mesh.origin[1]), mesh.limit[1]);
+
+    if ((x < c->lo[0]) || (x > c->hi[0]) || (y < c->lo[1]) || (y > c->hi[1])) {
+        _mesh_find_cell(x, y, c);
+    }
+    float dx = x - c->lo[0];
+    float dy = y - c->lo[1];
+    return (c->z0 + dx * (c->dzx + c->dzxy * dy) + c->dzy * dy);
+}
+
+static void _mesh_take_up(const float offset_before)
+{
+    float change = mp_mesh_offset(mr->position[AXIS_X], mr->position[AXIS_Y]) - offset_before;
+    mr->position[AXIS_Z] -= change;
+    mp->position[AXIS_Z] -= change;
+}
+
+stat_t mp_mesh_load(const float z[], const uint8_t nx, const uint8_t ny, const float origin[], const float step[])
+{
+    if ((nx < 2) || (nx > PROBE_GRID_MAX) || (ny < 2) || (ny > PROBE_GRID_MAX) ||
+        fp_ZERO(step[0]) || fp_ZERO(step[1])) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    float offset_before = mp_mesh_offset(mr->position[AXIS_X], mr->position[AXIS_Y]);
+    mesh.enabled = false;               // the runtime ignores the map while it's being written
+
+    // store with positive steps so cell lookup and clamping only have to go one way
+    bool flip_x = (step[0] < 0);
+    bool flip_y = (step[1] < 0);
+    for (uint8_t j = 0; j < ny; j++) {
+        uint8_t src_j = flip_y ? (ny - 1 - j) : j;
+        for (uint8_t i = 0; i < nx; i++) {
+            uint8_t src_i = flip_x ? (nx - 1 - i) : i;
+            mesh.z[j * nx + i] = z[src_j * nx + src_i] - z[0];
+        }
+    }
+    for (uint8_t a = 0; a < 2; a++) {
+        uint8_t n = (a == 0) ? nx : ny;
+        mesh.step[a] = std::abs(step[a]);
+        mesh.inv_step[a] = 1 / mesh.step[a];
+        mesh.origin[a] = (step[a] < 0) ? (origin[a] + step[a] * (n - 1)) : origin[a];
+        mesh.limit[a] = mesh.origin[a] + mesh.step[a] * (n - 1);
+        mesh.cell.lo[a] = 1;            // empty bounds force a lookup on the next segment
+        mesh.cell.hi[a] = 0;
+    }
+    mesh.nx = nx;
+    mesh.ny = ny;
+    mesh.enabled = true;
+    _mesh_take_up(offset_before);
+    return (STAT_OK);
+}
+
+void mp_mesh_disable()
+{
+    float offset_before = mp_mesh_offset(mr->position[AXIS_X], mr->position[AXIS_Y]);
+    mesh.enabled = false;
+    _mesh_take_up(offset_before);
+}
+
+bool mp_mesh_enabled() { return (mesh.enabled); }
+
+float mp_mesh_offset(const float x, const float y)
+{
+    if (!mesh.enabled) {
+        return (0);
+    }
+    mpMeshCell_t c;                     // don't disturb the runtime's cache
+    c.lo[0] = 1;
+    c.hi[0] = 0;
+    return (_mesh_offset(x, y, &c));
+}
+
+void mp_inverse_kinematics(const GCodeState_t &gm, const float target[], const float position[],
+                           const float start_velocity, const float end_velocity,
+                           const float segment_time, float steps[])
+{
+    if (mesh.enabled) {
+        float mesh_target[AXES];
+        copy_vector(mesh_target, target);
+        mesh_target[AXIS_Z] += _mesh_offset(target[AXIS_X], target[AXIS_Y], &mesh.cell);
+        kn->inverse_kinematics(gm, mesh_target, position, start_velocity, end_velocity, segment_time, steps);
+    } else {
+        kn->inverse_kinematics(gm, target, position, start_velocity, end_velocity, segment_time, steps);
+    }
+}
+
 /*********************************************************************************************
  * _exec_aline_segment() - segment runner helper
  *
@@ -933,7 +1112,10 @@ static stat_t _exec_aline_segment()
     ////    ... original g2 method; this means that previously, all speeds and times 
     ////    ... were based on conceptual distance, not real distances between steps.
     ////   Now corrected by converting locations to nearest true step location in plan_line.cpp
-    kn->inverse_kinematics(mr->gm, mr->gm.target, mr->position, mr->segment_velocity, mr->target_velocity, mr->segment_time, exec_target_steps);
+    if (mr->gm.raster) {
+        raster_take(mr->gm.raster);     // mark the scanline started even if no laser toolhead uses it
+    }
+    mp_inverse_kinematics(mr->gm, mr->gm.target, mr->position, mr->segment_velocity, mr->target_velocity, mr->segment_time, exec_target_steps);
 
     // Update the mb->run_time_remaining -- we know it's missing the current segment's time before it's loaded, that's ok.
     mp->run_time_remaining -= mr->segment_time;
@@ -1008,6 +1190,160 @@ static void _exec_aline_normalize_block(mpBlockRuntimeBuf_t *b)
     }
 }
 
+/*********************************************************************************************
+ * _exec_aline_override() - replan the remainder of the running block for a new override factor
+ *
+ *  Builds a new head / body / tail for the length left in the block: a head from the current
+ *  velocity to the new cruise velocity (this is the jerk-limited transition, and may decelerate),
+ *  a body, and a tail to the block's original exit velocity. The exit velocity is not changed
+ *  so the block that was forward planned behind this one still joins correctly. That block is
+ *  reshaped the same way when it starts.
+ *
+ *  If a faster cruise does not fit, the highest one that does is found by bisection. If a slower
+ *  cruise does not fit the block is left as it was. Either way bf->override_factor is updated so
+ *  this only runs once per override change.
+ */
+
+static void _exec_aline_override(mpBuf_t *bf, const float factor)
+{
+    bf->override_factor = factor;
+    if (mp->mfo_request_time != 0) {
+        mp->mfo_latency = (float)(SysTickTimer.getValue() - mp->mfo_request_time);
+        mp->mfo_request_time = 0;
+    }
+
+    float length = get_axis_vector_length(mr->target, mr->position);
+    if (length < EPSILON4) {
+        return;
+    }
+    const float entry_velocity = (mr->section == SECTION_HEAD) ? mr->entry_velocity : mr->r->cruise_velocity;
+    const float exit_velocity = mr->r->exit_velocity;
+    float cruise_velocity = std::max(std::min(bf->absolute_vmax, factor * bf->cruise_vset), exit_velocity);
+
+    float head_length = mp_get_target_length(entry_velocity, cruise_velocity, bf);
+    float tail_length = mp_get_target_length(exit_velocity, cruise_velocity, bf);
+    if ((head_length + tail_length) > length) {
+        if (cruise_velocity < entry_velocity) {
+            return;
+        }
+        float lo = std::max(entry_velocity, exit_velocity);
+        float hi = cruise_velocity;
+        for (uint8_t i=0; i<10; i++) {
+            float v = (lo + hi) * 0.5;
+            if ((mp_get_target_length(entry_velocity, v, bf) + mp_get_target_length(exit_velocity, v, bf)) > length) {
+                hi = v;
+            } else {
+                lo = v;
+            }
+        }
+        cruise_velocity = lo;
+        head_length = mp_get_target_length(entry_velocity, cruise_velocity, bf);
+        tail_length = mp_get_target_length(exit_velocity, cruise_velocity, bf);
+        if ((head_length + tail_length) > length) {
+            return;
+        }
+    }
+
+    mr->entry_velocity = entry_velocity;
+    mr->r->cruise_velocity = cruise_velocity;
+    mr->r->head_length = head_length;
+    mr->r->body_length = length - head_length - tail_length;
+    mr->r->tail_length = tail_length;
+    mr->r->head_time = (head_length > 0) ? (2 * head_length / (entry_velocity + cruise_velocity)) : 0;
+    mr->r->body_time = (mr->r->body_length > 0) ? (mr->r->body_length / cruise_velocity) : 0;
+    mr->r->tail_time = (tail_length > 0) ? (2 * tail_length / (cruise_velocity + exit_velocity)) : 0;
+    _exec_aline_normalize_block(mr->r);
+    bf->block_time = mr->r->head_time + mr->r->body_time + mr->r->tail_time;
+    mp->run_time_remaining = bf->block_time;            // the reshaped block starts here
+
+    mr->section = SECTION_HEAD;                         // head and body generators skip ahead if empty
+    mr->section_state = SECTION_NEW;
+    for (uint8_t axis=0; axis<AXES; axis++) {
+        mr->waypoint[SECTION_HEAD][axis] = mr->position[axis] + mr->unit[axis] * mr->r->head_length;
+        mr->waypoint[SECTION_BODY][axis] = mr->position[axis] + mr->unit[axis] * (mr->r->head_length + mr->r->body_length);
+        mr->waypoint[SECTION_TAIL][axis] = mr->position[axis] + mr->unit[axis] * (mr->r->head_length + mr->r->body_length + mr->r->tail_length);
+    }
+}
+
+/*********************************************************************************************
+ * _feedhold_stop_length()   - minimum jerk-limited stopping distance from the current runtime state
+ * _feedhold_stats_sync()    - record where the runtime was when it picked up the hold
+ * _feedhold_stats_predict() - record the hold planner's predicted stopping distance
+ * _feedhold_stats_stopped() - record latency and stopping distance once motion has stopped
+ *
+ *  _feedhold_stop_length() follows the same path _exec_aline_feedhold() will take: brake
+ *  from the current segment velocity at the block's jerk (already raised to jerk_high for
+ *  fast stops). If the braking length does not fit in what is left of the block the
+ *  deceleration carries into the following blocks at each block's own jerk (Cases 1b2, 1c2),
+ *  so the queue is walked until the velocity reaches zero or the planned moves run out.
+ *
+ *  The measured distance includes the segment that was already running in the steppers when
+ *  the hold was picked up, so it covers the travel from the request (within one segment time)
+ *  to zero velocity. The prediction includes the same segment and anything run while a head
+ *  was played out (Case 1a), so the two are directly comparable.
+ */
+
+static float _feedhold_stop_length(mpBuf_t *bf)
+{
+    mpBuf_t *start = bf;
+    float velocity = mr->segment_velocity;
+    float available = get_axis_vector_length(mr->target, mr->position);
+    float length = 0;
+
+    while (velocity > EPSILON2) {
+        float braking = mp_get_target_length(0, velocity, bf);
+        if ((available + EPSILON2 - braking) > 0) {
+            return (length + braking);
+        }
+        length += available;
+        float exit_velocity = mp_get_decel_velocity(velocity, available, bf);
+        if (exit_velocity >= 0) {                   // otherwise the block runs as a body (see below)
+            velocity = exit_velocity;
+        }
+        bf = mp_get_next_buffer(bf);
+        if ((bf == start) || (bf->buffer_state == MP_BUFFER_EMPTY) || (bf->block_type != BLOCK_TYPE_ALINE)) {
+            break;                                  // the planner already stops at the end of the queue
+        }
+        available = bf->length;
+    }
+    return (length);
+}
+
+static void _feedhold_stats_sync()
+{
+    cmHoldStats_t *hs = &cm->hold_stats;
+    if (hs->synced) {
+        return;
+    }
+    if (hs->request_time == 0) {                    // hold was started internally, not by cm_request_feedhold()
+        hs->request_time = SysTickTimer.getValue();
+    }
+    hs->synced = true;
+    hs->predicted = false;
+    copy_vector(hs->start_position, mr->position);
+    hs->committed_length = mr->segment_velocity * mr->segment_time;
+}
+
+static void _feedhold_stats_predict(const float stop_length)
+{
+    cmHoldStats_t *hs = &cm->hold_stats;
+    if (hs->predicted) {
+        return;
+    }
+    hs->predicted = true;
+    hs->predicted_length = hs->committed_length + get_axis_vector_length(mr->position, hs->start_position) + stop_length;
+}
+
+static void _feedhold_stats_stopped()
+{
+    cmHoldStats_t *hs = &cm->hold_stats;
+    hs->latency = (float)(SysTickTimer.getValue() - hs->request_time);
+    hs->stop_length = hs->committed_length + get_axis_vector_length(mr->position, hs->start_position);
+    hs->request_time = 0;
+    hs->synced = false;
+    TRACE(TRACE_FEEDHOLD_STOP, cm->hold_type, (uint32_t)(hs->stop_length * 1000));  // microns
+}
+
 /*********************************************************************************************
  * _exec_aline_feedhold() - feedhold helper for mp_exec_aline()
  *
@@ -1052,10 +1388,11 @@ static stat_t _exec_aline_feedhold(mpBuf_t *bf)
                     copy_vector(mp->position, mr->position);// update planner position to the final runtime position
                     mp_free_run_buffer();                   // advance to next block, discarding the zero-length move
                 } else {
-                    // Restore the original motion profile and recompute cached jerk values for
-                    // SCRAM so the resumed block accelerates at normal jerk, not fast-stop jerk.
-                    if (cm->hold_type == FEEDHOLD_TYPE_SCRAM) {
+                    // Restore the original motion profile and recompute cached jerk values after
+                    // a SCRAM or high jerk stop so the resumed block accelerates at normal jerk.
+                    if (cm->hold_profile_saved) {
                         mp_restore_jerk_for_feedhold(bf, cm->hold_saved_motion_profile);
+                        cm->hold_profile_saved = false;
                     }
                     bf->block_state = BLOCK_INITIAL_ACTION;   // tell _exec to re-use the bf buffer
                     while (bf->buffer_state > MP_BUFFER_BACK_PLANNED) {
@@ -1065,9 +1402,11 @@ static stat_t _exec_aline_feedhold(mpBuf_t *bf)
                     }
                 }
             }
+            _feedhold_stats_stopped();                      // record latency and stopping distance before MR is reset
             mr->reset();                                    // reset MR for next use and for forward planning
             cm_set_motion_state(MOTION_STOP);
             cm->hold_state = FEEDHOLD_MOTION_STOPPED;
+            TRACE(TRACE_FEEDHOLD, FEEDHOLD_MOTION_STOPPED, cm->hold_type);
             sr_request_status_report(SR_REQUEST_IMMEDIATE);
         }
         return (STAT_NOOP);                                 // hold here. leave with a NOOP so it does not attempt another load and exec.
@@ -1085,10 +1424,14 @@ static stat_t _exec_aline_feedhold(mpBuf_t *bf)
     if ((cm->hold_state == FEEDHOLD_SYNC) ||
         ((cm->hold_state == FEEDHOLD_DECEL_CONTINUE) && (mr->block_state == BLOCK_INITIAL_ACTION))) {
 
+        _feedhold_stats_sync();
+        cm->hold_profile_saved = false;                 // any earlier override belonged to a finished block
+
         // Force high jerk profile for SCRAM (fast stop) or instant stop for HALT
         // This MUST happen before the recalculate check, and we force recalculation
         if (cm->hold_type == FEEDHOLD_TYPE_SCRAM) {
             cm->hold_saved_motion_profile = bf->gm.motion_profile;  // save for restore when block is re-queued on resume
+            cm->hold_profile_saved = true;
             bf->gm.motion_profile = PROFILE_FAST_STOP;
             mp_recalculate_jerk_for_feedhold(bf);  // Force recalculation for high jerk
         }
@@ -1102,6 +1445,7 @@ static stat_t _exec_aline_feedhold(mpBuf_t *bf)
             // Instant halt: skip deceleration entirely. Jump to DECEL_COMPLETE so Case(3')
             // and Case(4) handle cleanup naturally. The current DDA segment drains on its
             // own (< 1 segment duration). The remaining block is kept for resume, like SCRAM.
+            _feedhold_stats_predict(0);
             cm->hold_state = FEEDHOLD_DECEL_COMPLETE;
             return (STAT_OK);
         }
@@ -1113,6 +1457,7 @@ static stat_t _exec_aline_feedhold(mpBuf_t *bf)
         else {
             // Case (1d) - Already decelerating (in a tail), continue the deceleration.
             if (mr->section == SECTION_TAIL) {          // if already in a tail don't decelerate. You already are
+                _feedhold_stats_predict(_feedhold_stop_length(bf));
                 if (mr->r->exit_velocity < EPSILON2) {  // allow near-zero velocities to be treated as zero
                     cm->hold_state = FEEDHOLD_DECEL_TO_ZERO;
                 } else {
@@ -1127,7 +1472,16 @@ static stat_t _exec_aline_feedhold(mpBuf_t *bf)
             if ((mr->section == SECTION_HEAD) && (mr->section_state != SECTION_NEW)) {
                 return (STAT_EAGAIN);
             }
+
+            // Shortest stop: brake at jerk_high instead of the jerk the block was planned with
+            if (cm->feedhold_high_jerk) {
+                cm->hold_saved_motion_profile = bf->gm.motion_profile;
+                cm->hold_profile_saved = true;
+                bf->gm.motion_profile = PROFILE_FAST_STOP;
+                mp_recalculate_jerk_for_feedhold(bf);
+            }
         }
+        _feedhold_stats_predict(_feedhold_stop_length(bf));
 
         // Case (1b, 1c) - Block is in a body or about to start a new head. Turn it into a new tail.
         // In the new_head case plan deceleration move (tail) starting at the at the entry velocity
@@ -1176,6 +1530,7 @@ static stat_t _exec_aline_feedhold(mpBuf_t *bf)
             }
         }
         _exec_aline_normalize_block(mr->r);
+        mp->run_time_remaining = mr->r->body_time + mr->r->tail_time;   // the stop replaces the rest of the block
     }
     return (STAT_EAGAIN);                           // exiting with EAGAIN will continue exec_aline() execution
 }
@@ -36,6 +36,7 @@
 #include "util.h"
 #include "spindle.h"
 #include "settings.h"
+#include "trace.h"
 #include "xio.h"
 
 // using Motate::Timeout;
@@ -89,18 +90,18 @@ float mp_get_runtime_display_position(uint8_t axis) {
     // target_rotated[1] = a y_1 + b y_2 + c y_3
     // target_rotated[2] = a z_1 + b z_2 + c z_3 + z_offset
 
-    if (axis == AXIS_X) {
+    if (!cm->rotation_active || (axis > AXIS_Z)) {
+        // no tram, or ABC, UVW - we don't rotate them
+        return (mr->position[axis] - mr->gm.display_offset[axis]);
+    } else if (axis == AXIS_X) {
         return mr->position[0] * cm->rotation_matrix[0][0] + mr->position[1] * cm->rotation_matrix[1][0] +
                mr->position[2] * cm->rotation_matrix[2][0] - mr->gm.display_offset[0];
     } else if (axis == AXIS_Y) {
         return mr->position[0] * cm->rotation_matrix[0][1] + mr->position[1] * cm->rotation_matrix[1][1] +
                mr->position[2] * cm->rotation_matrix[2][1] - mr->gm.display_offset[1];
-    } else if (axis == AXIS_Z) {
+    } else {    // AXIS_Z
         return mr->position[0] * cm->rotation_matrix[0][2] + mr->position[1] * cm->rotation_matrix[1][2] +
                mr->position[2] * cm->rotation_matrix[2][2] - cm->rotation_z_offset - mr->gm.display_offset[2];
-    } else {
-        // ABC, UVW, we don't rotate them
-        return (mr->position[axis] - mr->gm.display_offset[axis]);
     }
 }
 
@@ -170,19 +171,27 @@ stat_t mp_aline(GCodeState_t* _gm)
     //  b being target[1],
     //  c being target[2],
     //  x_1 being cm->rotation_matrix[1][0]
+    //
+    // Without a tram the matrix is identity and the target is used as-is.
 
-    target_rotated[AXIS_X] = _gm->target[AXIS_X] * cm->rotation_matrix[0][0] +
-                             _gm->target[AXIS_Y] * cm->rotation_matrix[0][1] +
-                             _gm->target[AXIS_Z] * cm->rotation_matrix[0][2];
+    if (cm->rotation_active) {
+        target_rotated[AXIS_X] = _gm->target[AXIS_X] * cm->rotation_matrix[0][0] +
+                                 _gm->target[AXIS_Y] * cm->rotation_matrix[0][1] +
+                                 _gm->target[AXIS_Z] * cm->rotation_matrix[0][2];
 
-    target_rotated[AXIS_Y] = _gm->target[AXIS_X] * cm->rotation_matrix[1][0] +
-                             _gm->target[AXIS_Y] * cm->rotation_matrix[1][1] +
-                             _gm->target[AXIS_Z] * cm->rotation_matrix[1][2];
+        target_rotated[AXIS_Y] = _gm->target[AXIS_X] * cm->rotation_matrix[1][0] +
+                                 _gm->target[AXIS_Y] * cm->rotation_matrix[1][1] +
+                                 _gm->target[AXIS_Z] * cm->rotation_matrix[1][2];
 
-    target_rotated[AXIS_Z] = _gm->target[AXIS_X] * cm->rotation_matrix[2][0] +
-                             _gm->target[AXIS_Y] * cm->rotation_matrix[2][1] +
-                             _gm->target[AXIS_Z] * cm->rotation_matrix[2][2] +
-                             cm->rotation_z_offset;
+        target_rotated[AXIS_Z] = _gm->target[AXIS_X] * cm->rotation_matrix[2][0] +
+                                 _gm->target[AXIS_Y] * cm->rotation_matrix[2][1] +
+                                 _gm->target[AXIS_Z] * cm->rotation_matrix[2][2] +
+                                 cm->rotation_z_offset;
+    } else {
+        target_rotated[AXIS_X] = _gm->target[AXIS_X];
+        target_rotated[AXIS_Y] = _gm->target[AXIS_Y];
+        target_rotated[AXIS_Z] = _gm->target[AXIS_Z];
+    }
 
 #if (AXES == 9)
     // copy rotation axes for UVW (no changes)
@@ -337,6 +346,7 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
 
         if (bf->buffer_state == MP_BUFFER_INITIALIZING) {
             bf->buffer_state = MP_BUFFER_NOT_PLANNED;
+            TRACE(TRACE_BUFFER_STATE, bf->buffer_number, MP_BUFFER_NOT_PLANNED);
             bf->hint = NO_HINT;                             // ensure we've cleared the hints
         }
 
@@ -460,6 +470,7 @@ static mpBuf_t* _plan_block(mpBuf_t* bf)
             // We might back plan into the running or planned buffer, so we have to check.
             if (bf->buffer_state < MP_BUFFER_BACK_PLANNED) {
                 bf->buffer_state = MP_BUFFER_BACK_PLANNED;
+                TRACE(TRACE_BUFFER_STATE, bf->buffer_number, MP_BUFFER_BACK_PLANNED);
             }
         }  // for loop
     }      // exits with bf pointing to a locked or EMPTY block
@@ -115,6 +115,24 @@ static float _get_meet_velocity(const float          v_0,
  *
  */
 
+/****************************************************************************************
+ * mp_get_override_factor() - feed or traverse override factor currently in effect for a block
+ *
+ *  Used by forward planning and by the runtime, which compares it to bf->override_factor
+ *  to see if the override has changed since the block was planned.
+ */
+
+float mp_get_override_factor(const mpBuf_t* bf)
+{
+    if (bf->gm.motion_mode == MOTION_MODE_STRAIGHT_TRAVERSE) {
+        return (cm->gmx.mto_enable ? cm->gmx.mto_factor : BASE_STATE_MTO_FACTOR);
+    }
+    if ((bf->gm.motion_mode == MOTION_MODE_STRAIGHT_FEED) || (bf->gm.motion_mode == MOTION_MODE_CW_ARC) || (bf->gm.motion_mode == MOTION_MODE_CCW_ARC)) {
+        return (cm->gmx.mfo_enable ? cm->gmx.mfo_factor : BASE_STATE_MFO_FACTOR);
+    }
+    return (1.0);
+}
+
 // Hint will be one of these from back-planning: COMMAND_BLOCK, PERFECT_DECELERATION, PERFECT_CRUISE,
 // MIXED_DECELERATION, ASYMMETRIC_BUMP
 // We are incorporating both the forward planning and ramp-planning into one function, since we use the same data.
@@ -140,13 +158,7 @@ stat_t mp_calculate_ramps(mpBlockRuntimeBuf_t* block, mpBuf_t* bf, const float e
     block->tail_length = 0;
 
     // handle overrides
-    bf->override_factor = 1.0;
-    if (bf->gm.motion_mode == MOTION_MODE_STRAIGHT_TRAVERSE) {
-        bf->override_factor = cm->gmx.mto_enable ? cm->gmx.mto_factor : BASE_STATE_MTO_FACTOR;
-    }
-    else if ((bf->gm.motion_mode == MOTION_MODE_STRAIGHT_FEED) || (bf->gm.motion_mode == MOTION_MODE_CW_ARC) || (bf->gm.motion_mode == MOTION_MODE_CCW_ARC)) {
-        bf->override_factor = cm->gmx.mfo_enable ? cm->gmx.mfo_factor : BASE_STATE_MFO_FACTOR;
-    }
+    bf->override_factor = mp_get_override_factor(bf);
 
     // bf->cruise_vmax adjusted by override cannot go above absolute vmax,
     //   and should stay below the back-planned cruise velocity.
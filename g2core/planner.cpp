@@ -62,6 +62,7 @@
 #include "report.h"
 #include "util.h"
 #include "json_parser.h"
+#include "trace.h"
 #include "xio.h"    //+++++ DIAGNOSTIC - only needed if xio_writeline() direct prints are used
 
 // Allocate planner structures
@@ -181,7 +182,7 @@ void _init_planner_queue(mpPlanner_t *_mp, mpBuf_t *queue, uint8_t size)
 void planner_init(mpPlanner_t *_mp, mpPlannerRuntime_t *_mr, mpBuf_t *queue, uint8_t queue_size)
 {
     // init planner master structure
-    memset(_mp, 0, sizeof(mpPlanner_t));    // clear all values, pointers and status
+    memset((void *)_mp, 0, sizeof(mpPlanner_t)); // clear all values, pointers and status
     _mp->magic_start = MAGICNUM;            // set boundary condition assertions
     _mp->magic_end = MAGICNUM;
     _mp->mfo_factor = BASE_STATE_MFO_FACTOR;
@@ -276,6 +277,7 @@ void mp_set_steps_to_runtime_position()
     // after handling the steps, allowing the kinematics to intelligently handle the offset of step and position.
 
     // Reset everything to match the internal encoders
+    en_zero_external_encoders();                    // the position is redefined, so are any lost steps
     for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
         mr->encoder_steps[motor] = en_read_encoder(motor);
         step_position[motor] = mr->encoder_steps[motor];
@@ -286,8 +288,13 @@ void mp_set_steps_to_runtime_position()
         // These must be zero:
         mr->following_error[motor] = 0;
         st_pre.mot[motor].corrected_steps = 0;
+        st_pre.mot[motor].correction_pending = 0;
+        st_pre.mot[motor].correction_integral = 0;
     }
-    kn->sync_encoders(mr->encoder_steps, mr->position);
+    float position[AXES];                           // the steps include the height map, if any
+    copy_vector(position, mr->position);
+    position[AXIS_Z] += mp_mesh_offset(position[AXIS_X], position[AXIS_Y]);
+    kn->sync_encoders(mr->encoder_steps, position);
 }
 
 
@@ -379,9 +386,11 @@ void mp_queue_command(cm_exec_t cm_exec, float *value, bool *flag)
     bf->bf_func = _exec_command;      // callback to planner queue exec function
     bf->cm_func = cm_exec;            // callback to canonical machine exec function
 
+    // Callers that take no arguments pass nullptrs. Reading through them "works" on the
+    // ARM (address 0 is flash), but nowhere else, and the values are garbage anyway.
     for (uint8_t axis = AXIS_X; axis < AXES; axis++) {
-        bf->unit[axis] = value[axis];               // use the unit vector to store command values
-        bf->axis_flags[axis] = flag[axis];
+        bf->unit[axis] = (value != nullptr) ? value[axis] : 0;  // use the unit vector to store command values
+        bf->axis_flags[axis] = (flag != nullptr) ? flag[axis] : false;
     }
     mp_commit_write_buffer(BLOCK_TYPE_COMMAND);     // must be final operation before exit
 }
@@ -538,6 +547,7 @@ void mp_request_out_of_band_dwell(float seconds)
  * Planner helpers
  *
  * mp_get_planner_buffers()  - return # of available planner buffers
+ * mp_get_planned_time_ms()  - return time of motion queued in the planner, including the running block
  * mp_planner_is_full()      - true if planner has no room for a new block
  * mp_has_runnable_buffer()  - true if next buffer is runnable, indicating motion has not stopped.
  * mp_is_it_phat_city_time() - test if there is time for non-essential processes
@@ -548,6 +558,29 @@ uint8_t mp_get_planner_buffers(const mpPlanner_t *_mp)  // which planner are you
     return (_mp->q.buffers_available);
 }
 
+// Blocks that are not yet fully planned contribute their current estimate, so the
+// result runs a little optimistic while the planner is filling.
+float mp_get_planned_time_ms(const mpPlanner_t *_mp)    // which planner are you interested in?
+{
+    float time = 0;
+    mpBuf_t *bf = _mp->q.r;
+
+    do {
+        if ((bf->buffer_state == MP_BUFFER_EMPTY) ||
+            ((bf == _mp->q.w) && (bf->buffer_state == MP_BUFFER_INITIALIZING))) {
+            break;                                      // end of the committed blocks
+        }
+        if (bf->buffer_state == MP_BUFFER_RUNNING) {
+            time += _mp->run_time_remaining;            // what's left of the running block
+        } else if (bf->block_type == BLOCK_TYPE_ALINE) {
+            time += bf->block_time;
+        } else if (bf->block_type == BLOCK_TYPE_DWELL) {
+            time += bf->block_time / 60.0;              // dwell block_time is in seconds
+        }
+    } while ((bf = bf->nx) != _mp->q.r);
+    return (time * 60000.0);
+}
+
 bool mp_planner_is_full(const mpPlanner_t *_mp)         // which planner are you interested in?
 {
     // We also need to ensure we have room for another JSON command
@@ -611,9 +644,12 @@ stat_t mp_planner_callback()
         // exit because there are no ALINE blocks left to drive the decel state machine.
         // This can happen when a feedhold arrives near the end of the last move (e.g.
         // probe contact at the move endpoint) and DECEL_CONTINUE spans past the last block.
-        if (cm->hold_state == FEEDHOLD_SYNC ||
-            cm->hold_state == FEEDHOLD_DECEL_CONTINUE ||
-            cm->hold_state == FEEDHOLD_DECEL_TO_ZERO) {
+        // A direct-runtime velocity jog moves with an empty planner and stops its own holds
+        // (see cm_jgv_callback()), so leave those alone.
+        if (!cm_jgv_direct_active() &&
+            (cm->hold_state == FEEDHOLD_SYNC ||
+             cm->hold_state == FEEDHOLD_DECEL_CONTINUE ||
+             cm->hold_state == FEEDHOLD_DECEL_TO_ZERO)) {
             cm->hold_state = FEEDHOLD_MOTION_STOPPED;
         }
 
@@ -670,6 +706,7 @@ void mp_replan_queue(mpBuf_t *bf, bool back_too/*=false*/)
         } else {
             if (bf->buffer_state >= MP_BUFFER_FULLY_PLANNED) {  // revert from FULLY PLANNED state
                 bf->buffer_state = MP_BUFFER_BACK_PLANNED;
+                TRACE(TRACE_BUFFER_STATE, bf->buffer_number, MP_BUFFER_BACK_PLANNED);
             } else {    // If it's not fully-planned then it's either backplanned or earlier.
                 break;  // We don't need to adjust it.
             }
@@ -691,17 +728,20 @@ void mp_replan_queue(mpBuf_t *bf, bool back_too/*=false*/)
  *      The ramp will attempt to meet the time specified but it will not be exact.
  */
 /*  Function:
- *  The override takes effect as close to real-time as possible. Practically, this means about 20 or
- *  so behind the current running move. How it works:
+ *  The override takes effect as close to real-time as possible. How it works:
  *
  *    - If the planner is idle just apply the override factor and be done with it. That's easy.
- *    - Otherwise look for the "break point" at 20 ms
+ *    - Blocks not yet forward planned pick up the new factor in mp_calculate_ramps().
+ *    - The running block (and the one already forward planned behind it) are reshaped by
+ *      the runtime the next time it reaches a section boundary or is in a body. See
+ *      _exec_aline_override() in plan_exec.cpp. mfo_request_time is used to report latency.
  */
 
 ////##fro
 void mp_start_feed_override(const float ramp_time, const float override_factor)
 {
     cm->mfo_state = MFO_REQUESTED;
+    mp->mfo_request_time = SysTickTimer.getValue();
 
     if (mp->planner_state == PLANNER_IDLE) {
         mp->mfo_factor = override_factor;             // that was easy
@@ -856,6 +896,7 @@ mpBuf_t * mp_get_write_buffer()     // get & clear a buffer
     if (q->w->buffer_state == MP_BUFFER_EMPTY) {
         _clear_buffer(q->w);        // NB: this is redundant if the buffer was cleared mp_free_run_buffer()
         q->w->buffer_state = MP_BUFFER_INITIALIZING;
+        TRACE(TRACE_BUFFER_STATE, q->w->buffer_number, MP_BUFFER_INITIALIZING);
         q->buffers_available--;
         return (mp_get_w());
     }
@@ -925,6 +966,7 @@ bool mp_free_run_buffer()           // EMPTY current run buffer & advance to the
     _audit_buffers();               // DIAGNOSTIC audit for buffer chain integrity (only runs in DEBUG mode)
     q->r = q->r->nx;                // advance to next run buffer first...
     _clear_buffer(r_now);           // ... then clear out the old buffer (& set MP_BUFFER_EMPTY)
+    TRACE(TRACE_BUFFER_STATE, r_now->buffer_number, MP_BUFFER_EMPTY);
 //    r_now->buffer_state = MP_BUFFER_EMPTY; //... then mark the buffer empty while preserving content for debug inspection
     q->buffers_available++;
     qr_request_queue_report(-1);    // request a QR and add to the "removed buffers" count
@@ -281,6 +281,8 @@ typedef enum {                      // code blocks for planning and trapezoid ge
 #define VELOCITY_ROUGHLY_EQ(v0,v1) ( (v0 > Vthr2) ? std::abs(v0-v1) < Veq2_hi : std::abs(v0-v1) < Veq2_lo )
 
 /* Planner Diagnostics */
+// ASCII_ART() and friends print synchronously and perturb timing. For latency work
+// use the binary event trace instead (__TRACE in g2core.h, see trace.h).
 
 //#define __PLANNER_DIAGNOSTICS   // comment this out to drop diagnostics
 
@@ -522,7 +524,7 @@ typedef struct mpPlanner {              // common variables for a planner contex
     float position[AXES];               // final move position for planning purposes
 
     // timing variables
-    float run_time_remaining;           // time left in runtime (including running block)
+    float run_time_remaining;           // time left in the running block (set at its start, counted down per segment)
     float plannable_time;               // time in planner that can actually be planned
 
     // planner state variables
@@ -537,6 +539,8 @@ typedef struct mpPlanner {              // common variables for a planner contex
     float mfo_factor;                   // runtime override factor
     float ramp_target;
     float ramp_dvdt;
+    uint32_t mfo_request_time;          // SysTick ms of the last override change, 0 once the runtime has applied it
+    float mfo_latency;                  // ms from the last override change to the runtime reshaping the running block
 
     // objects
     Timeout block_timeout;              // Timeout object for block planning
@@ -608,6 +612,7 @@ void mp_request_out_of_band_dwell(float seconds);
 
 //**** planner functions and helpers
 uint8_t mp_get_planner_buffers(const mpPlanner_t *_mp);
+float mp_get_planned_time_ms(const mpPlanner_t *_mp);
 bool mp_planner_is_full(const mpPlanner_t *_mp);
 bool mp_has_runnable_buffer(const mpPlanner_t *_mp);
 bool mp_is_phat_city_time(void);
@@ -656,6 +661,7 @@ bool mp_should_recalculate_jerk_for_feedhold(mpBuf_t *bf);
 
 //**** plan_zoid.c functions
 stat_t mp_calculate_ramps(mpBlockRuntimeBuf_t *block, mpBuf_t *bf, const float entry_velocity);
+float mp_get_override_factor(const mpBuf_t *bf);
 float mp_get_target_length(const float v_0, const float v_1, const mpBuf_t *bf);
 float mp_get_target_velocity(const float v_0, const float L, const mpBuf_t *bf); // acceleration ONLY
 float mp_get_decel_velocity(const float v_0, const float L, const mpBuf_t *bf);  // deceleration ONLY
@@ -672,6 +678,14 @@ stat_t mp_exec_move(void);
 stat_t mp_exec_aline(mpBuf_t *bf);
 void mp_exit_hold_state(void);
 
+stat_t mp_mesh_load(const float z[], const uint8_t nx, const uint8_t ny, const float origin[], const float step[]);
+void mp_mesh_disable(void);
+bool mp_mesh_enabled(void);
+float mp_mesh_offset(const float x, const float y);
+void mp_inverse_kinematics(const GCodeState_t &gm, const float target[], const float position[],
+                           const float start_velocity, const float end_velocity,
+                           const float segment_time, float steps[]);
+
 void mp_dump_planner(mpBuf_t *bf_start);
 
 #endif    // End of include Guard: PLANNER_H_ONCE
@@ -0,0 +1,238 @@
+/*
+ * raster.cpp - packed scanline buffers for raster laser engraving
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2026 FabMo
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"     // #1
+#include "config.h"     // #2
+#include "raster.h"
+#include "canonical_machine.h"
+#include "settings.h"
+#include "text_parser.h"
+#include "util.h"
+
+/*
+ * Ring accounting. 'committed' is advanced by raster_attach() (main loop) and 'taken' by
+ * raster_take() (exec). Both are free-running counters; the slot for a count is count % RASTER_LINES.
+ * The slot at 'committed' is the pending line while pending_bytes is non-zero.
+ */
+
+typedef struct rasterSingleton {
+    uint8_t bits;                       // {rstb:} bits per pixel for lines claimed from now on
+    float overscan;                     // {rsto:} run-in / run-out at each end of a raster move (mm)
+
+    uint16_t pending_bytes;             // bytes loaded into the pending line
+    uint16_t pending_pixels;            // {rstn:} pixels in the pending line, 0 = derive from bytes
+    uint16_t seq;                       // last sequence number handed out
+
+    uint8_t committed;                  // lines claimed by a move
+    volatile uint8_t taken;             // lines started by the runtime
+    volatile uint8_t held;              // started lines not yet free for re-use (0, 1 or 2)
+    volatile uint16_t taken_seq;        // sequence number of the last line started
+
+    rasterLine_t line[RASTER_LINES];
+} rasterSingleton_t;
+static rasterSingleton_t rs;
+
+static uint8_t _lines_in_use()
+{
+    return ((uint8_t)(rs.committed - rs.taken) + rs.held);
+}
+
+/*
+ * raster_reset() - drop all pending and queued lines. Only call while motion is stopped.
+ */
+
+void raster_reset()
+{
+    rs.pending_bytes = 0;
+    rs.pending_pixels = 0;
+    rs.committed = 0;
+    rs.taken = 0;
+    rs.held = 0;
+    rs.taken_seq = 0;
+}
+
+/*
+ * raster_is_full() - true if input should not be read until the runtime frees a line
+ *
+ * A pending line always has a slot, so it never blocks the G1 that will claim it.
+ */
+
+bool raster_is_full()
+{
+    return ((rs.pending_bytes == 0) && (_lines_in_use() >= RASTER_LINES));
+}
+
+/*
+ * raster_attach() - claim the pending line for a G1 from position to target (machine coordinates)
+ * raster_detach() - return the line claimed by the last raster_attach() to pending
+ *
+ * raster_attach() returns the value for GCodeState_t.raster - 0 if there is no pending line.
+ * Call raster_detach() if the move was not queued after all (e.g. a minimum length move).
+ */
+
+uint8_t raster_attach(const float position[], const float target[])
+{
+    if (rs.pending_bytes == 0) {
+        return (0);
+    }
+    uint8_t slot = rs.committed % RASTER_LINES;
+    rasterLine_t *line = &rs.line[slot];
+    float dx = target[AXIS_X] - position[AXIS_X];
+    float dy = target[AXIS_Y] - position[AXIS_Y];
+    uint16_t pixels = (rs.pending_bytes * 8) / rs.bits;
+
+    if ((rs.pending_pixels != 0) && (rs.pending_pixels < pixels)) {
+        pixels = rs.pending_pixels;     // trailing bits of the last byte are padding
+    }
+    if (++rs.seq == 0) {                // 0 is never a valid sequence number
+        rs.seq = 1;
+    }
+    line->seq = rs.seq;
+    line->pixels = pixels;
+    line->bits = rs.bits;
+    line->length = std::sqrt(dx*dx + dy*dy);
+    line->overscan = rs.overscan;
+    line->reverse = (std::abs(dx) >= std::abs(dy)) ? (dx < 0) : (dy < 0);
+
+    rs.pending_bytes = 0;
+    rs.pending_pixels = 0;
+    rs.committed++;
+    return (slot + 1);
+}
+
+void raster_detach()
+{
+    rasterLine_t *line = &rs.line[--rs.committed % RASTER_LINES];
+    rs.pending_bytes = (line->pixels * line->bits + 7) / 8;
+    rs.pending_pixels = line->pixels;
+}
+
+/*
+ * raster_take() - return the line claimed by a move, marking it started the first time it is seen
+ *
+ * Called by the runtime for every segment of a raster move. Starting a line frees the line
+ * started two lines ago - the stepper is at most one segment behind, so it is done with it.
+ */
+
+const rasterLine_t *raster_take(const uint8_t raster)
+{
+    const rasterLine_t *line = &rs.line[raster - 1];
+
+    if (line->seq != rs.taken_seq) {
+        rs.taken_seq = line->seq;
+        rs.taken++;
+        if (rs.held < 2) {
+            rs.held++;
+        }
+    }
+    return (line);
+}
+
+/***********************************************************************************
+ * CONFIGURATION AND INTERFACE FUNCTIONS
+ * Functions to get and set variables from the cfgArray table
+ ***********************************************************************************/
+
+stat_t raster_get_rstb(nvObj_t *nv) { return (get_integer(nv, rs.bits)); }
+stat_t raster_set_rstb(nvObj_t *nv)
+{
+    uint8_t bits = 0;
+    ritorno(set_integer(nv, bits, 1, 8));
+    if ((bits != 1) && (bits != 4) && (bits != 8)) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    if (rs.pending_bytes != 0) {        // don't re-interpret a half loaded line
+        return (STAT_COMMAND_NOT_ACCEPTED);
+    }
+    rs.bits = bits;
+    return (STAT_OK);
+}
+
+stat_t raster_get_rsto(nvObj_t *nv) { return (get_float(nv, rs.overscan)); }
+stat_t raster_set_rsto(nvObj_t *nv) { return (set_float_range(nv, rs.overscan, 0, 1000)); }
+
+stat_t raster_get_rstn(nvObj_t *nv) { return (get_integer(nv, rs.pending_pixels)); }
+stat_t raster_set_rstn(nvObj_t *nv)
+{
+    int32_t pixels = 0;
+    ritorno(set_int32(nv, pixels, 0, RASTER_LINE_BYTES * 8));
+    rs.pending_pixels = pixels;
+    return (STAT_OK);
+}
+
+static int8_t _hex_digit(const char c)
+{
+    if ((c >= '0') && (c <= '9')) { return (c - '0'); }
+    if ((c >= 'a') && (c <= 'f')) { return (c - 'a' + 10); }
+    if ((c >= 'A') && (c <= 'F')) { return (c - 'A' + 10); }
+    return (-1);
+}
+
+// Append hex encoded pixel data to the pending line, starting a new line if none is pending
+stat_t raster_set_rstd(nvObj_t *nv)
+{
+    const char *p = *nv->stringp;
+    uint16_t length = strlen(p);
+
+    if ((length == 0) || (length & 1)) {
+        return (STAT_INVALID_OR_MALFORMED_COMMAND);
+    }
+    if ((rs.pending_bytes == 0) && (_lines_in_use() >= RASTER_LINES)) {
+        return (STAT_BUFFER_FULL);      // only reachable if the controller's flow control is bypassed
+    }
+    if (rs.pending_bytes + length/2 > RASTER_LINE_BYTES) {
+        return (STAT_BUFFER_FULL);
+    }
+    uint8_t *data = &rs.line[rs.committed % RASTER_LINES].data[rs.pending_bytes];
+    for (uint16_t i = 0; i < length; i += 2) {
+        int8_t hi = _hex_digit(p[i]);
+        int8_t lo = _hex_digit(p[i+1]);
+        if ((hi < 0) || (lo < 0)) {
+            return (STAT_INVALID_OR_MALFORMED_COMMAND);   // the partial chunk is discarded
+        }
+        data[i/2] = (hi << 4) | lo;
+    }
+    rs.pending_bytes += length/2;
+    return (STAT_OK);
+}
+
+stat_t raster_get_rstq(nvObj_t *nv)
+{
+    uint8_t in_use = _lines_in_use() + ((rs.pending_bytes != 0) ? 1 : 0);
+    return (get_integer(nv, (in_use >= RASTER_LINES) ? 0 : RASTER_LINES - in_use));
+}
+
+constexpr cfgItem_t raster_config_items_1[] = {
+    // Raster engraving: {"rst":{"n":300,"d":"00ff7f..."}} then a G1 - see raster.h
+    { "rst","rstb", _iip, 0, tx_print_nul, raster_get_rstb, raster_set_rstb, nullptr, RASTER_BITS_PER_PIXEL },
+    { "rst","rsto", _fip, 3, tx_print_nul, raster_get_rsto, raster_set_rsto, nullptr, RASTER_OVERSCAN },
+    { "rst","rstn", _i0,  0, tx_print_nul, raster_get_rstn, raster_set_rstn, nullptr, 0 },  // pixels in the pending line
+    { "rst","rstd", _s0,  0, tx_print_nul, get_nul,         raster_set_rstd, nullptr, 0 },  // append hex pixel data
+    { "rst","rstq", _i0,  0, tx_print_nul, raster_get_rstq, set_ro,          nullptr, 0 },  // free scanline slots
+};
+constexpr cfgSubtableFromStaticArray raster_config_1 {raster_config_items_1};
+const configSubtable * const getRasterConfig_1() { return &raster_config_1; }
@@ -0,0 +1,96 @@
+/*
+ * raster.h - packed scanline buffers for raster laser engraving
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2026 FabMo
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ * Raster engraving sends one scanline of packed pixel power values per G1 instead of one G1
+ * (with its own S word) per power change. The host loads a line with one or more JSON chunks:
+ *
+ *   {"rst":{"n":300,"d":"00ff7f..."}}      n = pixels in this line (optional), d = hex data
+ *   {"rstd":"..."}                         further chunks are appended to the same line
+ *   G1 X120 F6000                          the next G1 claims the pending line
+ *
+ * The claimed line travels with the move (GCodeState_t.raster) and is indexed by position
+ * inside the DDA path by the laser toolhead, so the carriage can run at full speed regardless
+ * of the serial line rate. Pixels are always given in order of increasing coordinate along the
+ * dominant axis of the move; a move that runs the other way plays the line back reversed, so
+ * bidirectional (serpentine) scans need no re-ordering on the host. {rsto:} is an unlit run-in
+ * and run-out at each end of every raster move, used to hide acceleration at the line ends.
+ *
+ * Lines live in a small ring. One slot may be pending (being loaded), the rest are queued with
+ * their moves. The two most recently started lines are held back from re-use since the stepper
+ * may still be running the older one when the runtime starts the newer. The controller stops
+ * reading input while no slot is free and nothing is pending - see raster_is_full().
+ */
+
+#ifndef RASTER_H_ONCE
+#define RASTER_H_ONCE
+
+#include "config.h"
+
+#define RASTER_LINES 4                  // scanline slots. Must be a power of 2
+#define RASTER_LINE_BYTES 512           // packed pixel bytes per scanline (512 px at 8 bits, 4096 at 1 bit)
+
+typedef struct rasterLine {
+    uint16_t seq;                       // claim sequence number - identifies the line to the runtime
+    uint16_t pixels;                    // pixels in the line
+    uint8_t bits;                       // bits per pixel: 1, 4 or 8
+    bool reverse;                       // true if the move runs toward decreasing coordinates
+    float length;                       // XY length of the move (mm)
+    float overscan;                     // unlit run-in and run-out at each end of the move (mm)
+    uint8_t data[RASTER_LINE_BYTES];    // packed pixels, most significant bits first
+} rasterLine_t;
+
+void raster_reset(void);
+bool raster_is_full(void);
+
+uint8_t raster_attach(const float position[], const float target[]);
+void raster_detach(void);
+const rasterLine_t *raster_take(const uint8_t raster);
+
+/*
+ * raster_pixel() - return the value of pixel 'index' (0 is off, (1<<bits)-1 is full power)
+ *
+ * Called from the DDA interrupt, so keep it short.
+ */
+static inline uint8_t raster_pixel(const rasterLine_t *line, const uint16_t index)
+{
+    uint32_t bit = (uint32_t)index * line->bits;
+    uint8_t shift = 8 - line->bits - (bit & 7);
+    return ((line->data[bit >> 3] >> shift) & ((1 << line->bits) - 1));
+}
+
+stat_t raster_get_rstb(nvObj_t *nv);
+stat_t raster_set_rstb(nvObj_t *nv);
+stat_t raster_get_rsto(nvObj_t *nv);
+stat_t raster_set_rsto(nvObj_t *nv);
+stat_t raster_get_rstn(nvObj_t *nv);
+stat_t raster_set_rstn(nvObj_t *nv);
+stat_t raster_set_rstd(nvObj_t *nv);
+stat_t raster_get_rstq(nvObj_t *nv);
+
+const configSubtable *const getRasterConfig_1();
+
+#endif  // End of include guard: RASTER_H_ONCE
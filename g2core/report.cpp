@@ -164,9 +164,29 @@ void rpt_print_system_ready_message(void)
  *      the system into text mode.
  *
  *    - Automatic status reports in text mode return CSV format according to si setting
+ *
+ *  Compact format: In JSON mode a channel can ask for automatic status reports in a
+ *  compact delta-encoded form by sending {sf:1} on that channel ({sf:0} goes back to JSON).
+ *  Other channels keep getting JSON, and ad-hoc {sr:...} requests are always answered
+ *  in JSON. Values are sent as integers scaled by 10^precision of the SR item (so posx
+ *  at precision 3 is in thousandths). A compact report is one of:
+ *
+ *    @F:posx.3,posy.3,vel.2,stat.0,...   field list: tokens and their precision
+ *    @K:12345,-2000,0,3,...              keyframe: absolute values in field order
+ *    @D:<hexmask>:<delta>,<delta>,...    delta: bit N of the mask is field N, and one
+ *                                        delta (from the last value sent) per set bit
+ *
+ *  Field list and keyframe lines are sent together - after {sf:1}, after the SR list is
+ *  changed, and for full (verbose) reports. Filtered reports are sent as deltas. Fields
+ *  with no value (null) are empty in keyframes, and a delta has nothing to add to them,
+ *  so a field going from null to a value or back is sent as a new keyframe. Lines that
+ *  don't start with '@' are the usual JSON. Resources/sr_decode.py decodes the stream.
  */
 static stat_t _populate_unfiltered_status_report(void);
 static uint8_t _populate_filtered_status_report(void);
+static bool _compact_reports_active(void);
+static void _print_status_report(void);
+static void _print_compact_status_report(bool keyframe);
 
 /*
  * sr_init_status_report()
@@ -181,6 +201,7 @@ void sr_init_status_report()
     sr.status_report_request = SR_OFF;
     sr.runtime_command_report_pending = false;
     sr.nested_hold_report_count = 0;
+    sr.compact_keyframe_pending = true;
     char sr_defaults[NV_STATUS_REPORT_LEN][TOKEN_LEN+1] = { STATUS_REPORT_DEFAULTS };
     nv->index = nv_get_index((const char *)"", (char *)"se00");    // set first SR persistence index
 
@@ -275,6 +296,7 @@ stat_t sr_set_status_report(nvObj_t *nv)
         return (STAT_INPUT_LESS_THAN_MIN_VALUE);
     }
     memcpy(sr.status_report_list, status_report_list, sizeof(status_report_list));
+    sr.compact_keyframe_pending = true;                     // compact hosts need the new field list
     return(_populate_unfiltered_status_report());            // return current values
 }
 
@@ -378,7 +400,8 @@ stat_t sr_status_report_callback()
             cm1.hold_state = FEEDHOLD_OFF;
 
             _populate_unfiltered_status_report();
-            nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_OBJECT_FORMAT);
+            _print_status_report();
+            _print_compact_status_report(true);
 
             cm1.machine_state = saved_machine_state;
             cm1.hold_state = saved_hold_state;
@@ -395,7 +418,8 @@ stat_t sr_status_report_callback()
             cm1.hold_state = FEEDHOLD_HOLD;
 
             _populate_unfiltered_status_report();
-            nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_OBJECT_FORMAT);
+            _print_status_report();
+            _print_compact_status_report(true);
 
             cm1.machine_state = saved_machine_state;
             cm1.hold_state = saved_hold_state;
@@ -408,18 +432,173 @@ stat_t sr_status_report_callback()
     }
 
     // Normal report generation continues below
-    if ((sr.status_report_request == SR_VERBOSE) ||
-        (sr.status_report_verbosity == SR_VERBOSE)) {
-        _populate_unfiltered_status_report();
-    } else {
-        if (_populate_filtered_status_report() == false) {
-            return (STAT_OK);
+    bool full = ((sr.status_report_request == SR_VERBOSE) ||
+                 (sr.status_report_verbosity == SR_VERBOSE));
+
+    // skip the JSON report if every channel takes compact reports
+    if (!_compact_reports_active() || xio_has_sr_channel(false)) {
+        if (full) {
+            _populate_unfiltered_status_report();
+            _print_status_report();
+        } else if (_populate_filtered_status_report()) {
+            _print_status_report();
         }
     }
-    nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_OBJECT_FORMAT);
+    _print_compact_status_report(full);
     return (STAT_OK);
 }
 
+/*
+ * _compact_reports_active() - true if any channel takes compact SRs (JSON mode only)
+ * _print_status_report()    - print a populated SR to the channels that take JSON or text SRs
+ */
+static bool _compact_reports_active()
+{
+    return ((js.json_mode == JSON_MODE) && xio_has_sr_channel(true));
+}
+
+static void _print_status_report()
+{
+    if (_compact_reports_active()) {
+        json_serialize(nv_body, cs.out_buf, sizeof(cs.out_buf));
+        xio_writeline_sr(cs.out_buf, false);
+        return;
+    }
+    nv_print_list(STAT_OK, TEXT_MULTILINE_FORMATTED, JSON_OBJECT_FORMAT);
+}
+
+/*
+ * _print_compact_status_report() - send a keyframe or delta SR to the compact channels
+ *
+ *  Reads the SR values itself (rather than from the nv list) so it works whether or not
+ *  a JSON report was just populated. The line is built in cs.out_buf and sent in pieces
+ *  if it doesn't fit, so long SR lists are not truncated.
+ */
+static_assert(NV_STATUS_REPORT_LEN <= 64, "compact SR change mask is 64 bits");
+
+static char *_compact_ptr;              // write position in cs.out_buf
+
+static void _compact_put(const char *str)
+{
+    size_t len = strlen(str);
+    if ((_compact_ptr + len) >= (cs.out_buf + sizeof(cs.out_buf) - 1)) {  // send what we have
+        *_compact_ptr = NUL;
+        xio_writeline_sr(cs.out_buf, true);
+        _compact_ptr = cs.out_buf;
+    }
+    strcpy(_compact_ptr, str);
+    _compact_ptr += len;
+}
+
+static void _compact_end_line()
+{
+    _compact_put("\n");
+    xio_writeline_sr(cs.out_buf, true);
+    _compact_ptr = cs.out_buf;
+}
+
+static void _print_compact_status_report(bool keyframe)
+{
+    if (!_compact_reports_active()) {
+        return;
+    }
+    const int32_t scale[8] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000 };
+    int32_t value[NV_STATUS_REPORT_LEN];
+    bool has_value[NV_STATUS_REPORT_LEN];
+    int8_t precision[NV_STATUS_REPORT_LEN];
+    uint64_t changed = 0;
+    uint8_t count = 0;
+    char num[24];
+    nvObj_t *nv = nv_reset_nv_list();   // scratch object for the getters
+
+    keyframe = keyframe || sr.compact_keyframe_pending;
+
+    for (uint8_t i=0; i<NV_STATUS_REPORT_LEN; i++) {
+        if (sr.status_report_list[i].index == 0) {  // end of list
+            break;
+        }
+        count = i+1;
+        nv_reset_nv(nv);
+        nv->index = sr.status_report_list[i].index;
+        strcpy(nv->group, sr.status_report_list[i].group);
+        strcpy(nv->token, sr.status_report_list[i].token);
+
+        sr.status_report_list[i].get(nv);
+
+        has_value[i] = true;
+        precision[i] = 0;
+        if (nv->valuetype == TYPE_FLOAT) {
+            precision[i] = std::max((int8_t)0, std::min((int8_t)7, sr.status_report_list[i].precision));
+            value[i] = (int32_t)lround(nv->value_flt * scale[precision[i]]);
+        } else if ((nv->valuetype == TYPE_INTEGER) || (nv->valuetype == TYPE_BOOLEAN)) {
+            value[i] = nv->value_int;
+        } else {
+            has_value[i] = false;               // null, string, etc. - not encoded
+        }
+        if (has_value[i] == (bool)(sr.compact_null & ((uint64_t)1 << i))) {
+            keyframe = true;                    // went from null to a value or back
+        }
+        if (!has_value[i]) {
+            continue;
+        }
+        // as for filtered JSON reports, always report stops and ends
+        if ((value[i] != sr.compact_value[i]) ||
+            ((nv->index == sr.stat_index) &&
+             ((value[i] == COMBINED_PROGRAM_STOP) || (value[i] == COMBINED_PROGRAM_END)))) {
+            changed |= ((uint64_t)1 << i);
+        }
+    }
+    _compact_ptr = cs.out_buf;
+
+    if (keyframe) {
+        _compact_put("@F:");
+        for (uint8_t i=0; i<count; i++) {
+            if (i) { _compact_put(","); }
+            _compact_put(sr.status_report_list[i].group);
+            _compact_put(sr.status_report_list[i].token);
+            sprintf(num, ".%d", precision[i]);
+            _compact_put(num);
+        }
+        _compact_end_line();
+
+        _compact_put("@K:");
+        sr.compact_null = 0;
+        for (uint8_t i=0; i<count; i++) {
+            if (i) { _compact_put(","); }
+            if (has_value[i]) {
+                sprintf(num, "%ld", (long)value[i]);
+                _compact_put(num);
+                sr.compact_value[i] = value[i];
+            } else {
+                sr.compact_null |= ((uint64_t)1 << i);
+            }
+        }
+        _compact_end_line();
+        sr.compact_keyframe_pending = false;
+        return;
+    }
+    if (changed == 0) {
+        return;
+    }
+    if (changed >> 32) {
+        sprintf(num, "@D:%lx%08lx:", (unsigned long)(changed >> 32), (unsigned long)(changed & 0xFFFFFFFF));
+    } else {
+        sprintf(num, "@D:%lx:", (unsigned long)changed);
+    }
+    _compact_put(num);
+    bool first = true;
+    for (uint8_t i=0; i<count; i++) {
+        if (changed & ((uint64_t)1 << i)) {
+            if (!first) { _compact_put(","); }
+            first = false;
+            sprintf(num, "%ld", (long)(value[i] - sr.compact_value[i]));
+            _compact_put(num);
+            sr.compact_value[i] = value[i];
+        }
+    }
+    _compact_end_line();
+}
+
 /*
  * sr_run_text_status_report() - generate a text mode status report in multiline format
  */
@@ -570,6 +749,8 @@ static uint8_t _populate_filtered_status_report()
  * sr_set_sv() - set status report verbosity
  * sr_get_si() - get status report interval
  * sr_set_si() - set status report interval
+ * sr_get_sf() - get status report format of the channel the command came from
+ * sr_set_sf() - set status report format for that channel (and send it a keyframe)
  */
 
 stat_t sr_get(nvObj_t *nv) { return (_populate_unfiltered_status_report()); }
@@ -579,6 +760,18 @@ stat_t sr_get_sv(nvObj_t *nv) { return(get_integer(nv, (uint8_t &)sr.status_repo
 stat_t sr_set_sv(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)sr.status_report_verbosity, SR_OFF, SR_VERBOSE)); }
 stat_t sr_get_si(nvObj_t *nv) { return(get_integer(nv, sr.status_report_interval)); }
 stat_t sr_set_si(nvObj_t *nv) { return(set_int32(nv, sr.status_report_interval, STATUS_REPORT_MIN_MS, STATUS_REPORT_MAX_MS)); }
+stat_t sr_get_sf(nvObj_t *nv) { return(get_integer(nv, xio_get_sr_compact() ? SR_FORMAT_COMPACT : SR_FORMAT_JSON)); }
+stat_t sr_set_sf(nvObj_t *nv)
+{
+    uint8_t format = SR_FORMAT_JSON;
+    ritorno(set_integer(nv, format, SR_FORMAT_JSON, SR_FORMAT_COMPACT));
+    xio_set_sr_compact(format == SR_FORMAT_COMPACT);
+    if (format == SR_FORMAT_COMPACT) {
+        sr.compact_keyframe_pending = true;
+        sr_request_status_report(SR_REQUEST_IMMEDIATE);
+    }
+    return (STAT_OK);
+}
 
 /*********************
  * TEXT MODE SUPPORT *
@@ -587,10 +780,12 @@ stat_t sr_set_si(nvObj_t *nv) { return(set_int32(nv, sr.status_report_interval,
 
 static const char fmt_sv[] = "[sv]  status report verbosity%6d [0=off,1=filtered,2=verbose]\n";
 static const char fmt_si[] = "[si]  status interval%14d ms\n";
+static const char fmt_sf[] = "[sf]  status report format%8d [0=json,1=compact]\n";
 
 void sr_print_sr(nvObj_t *nv) { _populate_unfiltered_status_report();}
 void sr_print_sv(nvObj_t *nv) { text_print(nv, fmt_sv);}
 void sr_print_si(nvObj_t *nv) { text_print(nv, fmt_si);}
+void sr_print_sf(nvObj_t *nv) { text_print(nv, fmt_sf);}
 
 #endif // __TEXT_MODE
 
@@ -605,6 +800,14 @@ void sr_print_si(nvObj_t *nv) { text_print(nv, fmt_si);}
  *
  *  A QR_SINGLE report returns qr only. A QR_TRIPLE returns all 3 values
  *
+ *  QR_SINGLE and QR_TRIPLE report every change, which can be one report per line
+ *  sent. QR_WATERMARK (qv=3) coalesces them: it reports when the buffers available
+ *  fall to the low watermark (qrl) or rise to the high watermark (qrh), and otherwise
+ *  at most every qri ms while the queue is changing. It also reports qt - the planned
+ *  time in the queue in ms, including what is left of the running block - so a host can
+ *  flow-control on time to starvation rather than on buffer count. qt can also be
+ *  requested alone.
+ *
  *  There are 2 ways to get queue reports:
  *
  *   1. Enable single or triple queue reports using the QV variable. This will
@@ -632,6 +835,17 @@ void qr_init_queue_report()
  *  since the last init (usually re-initted when a report is generated).
  */
 
+static qrWaterZone _qr_water_zone(uint8_t buffers_available)
+{
+    if (buffers_available <= qr.low_water) {
+        return (QR_BELOW_LOW_WATER);
+    }
+    if (buffers_available >= qr.high_water) {
+        return (QR_ABOVE_HIGH_WATER);
+    }
+    return (QR_BETWEEN_WATERS);
+}
+
 void qr_request_queue_report(int8_t buffers)
 {
     // get buffer depth and added/removed count
@@ -642,6 +856,14 @@ void qr_request_queue_report(int8_t buffers)
         qr.buffers_removed -= buffers;
     }
 
+    // watermark reports only request on a crossing - the callback handles the interval
+    if (qr.queue_report_verbosity == QR_WATERMARK) {
+        if (_qr_water_zone(qr.buffers_available) != qr.water_zone) {
+            qr.queue_report_requested = true;
+        }
+        return;
+    }
+
     // time-throttle requests while generating arcs
 //    qr.motion_mode = cm_get_motion_mode(ACTIVE_MODEL);
     qr.motion_mode = cm_get_motion_mode((GCodeState_t *)&(cm->gm));
@@ -666,30 +888,48 @@ void qr_request_queue_report(int8_t buffers)
 stat_t qr_queue_report_callback()         // called by controller dispatcher
 {
     if ((qr.queue_report_verbosity == QR_OFF) ||
-        (js.json_verbosity == JV_SILENT) ||
-        (qr.queue_report_requested == false) ||
+        (js.json_verbosity == JV_SILENT)) {
+        return (STAT_NOOP);
+    }
+
+    // no crossing - send what has changed once the interval is up
+    if ((qr.queue_report_verbosity == QR_WATERMARK) && (qr.queue_report_requested == false)) {
+        if (((qr.buffers_added != 0) || (qr.buffers_removed != 0)) &&
+            ((SysTickTimer.getValue() - qr.init_tick) >= (uint32_t)qr.min_interval)) {
+            qr.queue_report_requested = true;
+        }
+    }
+
+    if ((qr.queue_report_requested == false) ||
         (!mp_is_phat_city_time())) {
         return (STAT_NOOP);
     }
 
     qr.queue_report_requested = false;
 
-    char report[32];    // we know these reports can't be longer than 30 bytes
+    char report[64];    // we know these reports can't be longer than 60 bytes
 
     if (cs.comm_mode == TEXT_MODE) {
         if (qr.queue_report_verbosity == QR_SINGLE) {
             sprintf(report, "qr:%d\n", qr.buffers_available);
-        } else  {
+        } else if (qr.queue_report_verbosity == QR_TRIPLE) {
             sprintf(report, "qr:%d, qi:%d, qo:%d\n", qr.buffers_available,qr.buffers_added,qr.buffers_removed);
+        } else {
+            sprintf(report, "qr:%d, qi:%d, qo:%d, qt:%ld\n", qr.buffers_available,qr.buffers_added,qr.buffers_removed,
+                    (long)mp_get_planned_time_ms(mp));
         }
     } else {
         if (qr.queue_report_verbosity == QR_SINGLE) {
             sprintf(report, "{\"qr\":%d}\n", qr.buffers_available);
-        } else {
+        } else if (qr.queue_report_verbosity == QR_TRIPLE) {
             sprintf(report, "{\"qr\":%d,\"qi\":%d,\"qo\":%d}\n", qr.buffers_available, qr.buffers_added,qr.buffers_removed);
+        } else {
+            sprintf(report, "{\"qr\":%d,\"qi\":%d,\"qo\":%d,\"qt\":%ld}\n", qr.buffers_available, qr.buffers_added,qr.buffers_removed,
+                    (long)mp_get_planned_time_ms(mp));
         }
     }
     xio_writeline(report);
+    qr.water_zone = _qr_water_zone(qr.buffers_available);
     qr_init_queue_report();
     return (STAT_OK);
 }
@@ -716,6 +956,7 @@ stat_t qr_queue_report_callback()         // called by controller dispatcher
  * qr_get() - run a queue report (as data)
  * qi_get() - run a queue report - buffers in
  * qo_get() - run a queue report - buffers out
+ * qt_get() - run a queue report - planned time in queue (ms)
  */
 stat_t qr_get(nvObj_t *nv)
 {
@@ -740,8 +981,21 @@ stat_t qo_get(nvObj_t *nv)
     return (STAT_OK);
 }
 
+stat_t qt_get(nvObj_t *nv)
+{
+    nv->value_int = (int32_t)mp_get_planned_time_ms(mp);
+    nv->valuetype = TYPE_INTEGER;
+    return (STAT_OK);
+}
+
 stat_t qr_get_qv(nvObj_t *nv) { return(get_integer(nv, (uint8_t &)qr.queue_report_verbosity)); }
-stat_t qr_set_qv(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)qr.queue_report_verbosity, QR_OFF, QR_TRIPLE)); }
+stat_t qr_set_qv(nvObj_t *nv) { return(set_integer(nv, (uint8_t &)qr.queue_report_verbosity, QR_OFF, QR_WATERMARK)); }
+stat_t qr_get_qrl(nvObj_t *nv) { return(get_integer(nv, qr.low_water)); }
+stat_t qr_set_qrl(nvObj_t *nv) { return(set_integer(nv, qr.low_water, 0, PLANNER_QUEUE_SIZE)); }
+stat_t qr_get_qrh(nvObj_t *nv) { return(get_integer(nv, qr.high_water)); }
+stat_t qr_set_qrh(nvObj_t *nv) { return(set_integer(nv, qr.high_water, 0, PLANNER_QUEUE_SIZE)); }
+stat_t qr_get_qri(nvObj_t *nv) { return(get_integer(nv, qr.min_interval)); }
+stat_t qr_set_qri(nvObj_t *nv) { return(set_int32(nv, qr.min_interval, 0, STATUS_REPORT_MAX_MS)); }
 
 /*****************************************************************************
  * JOB ID REPORTS
@@ -822,11 +1076,19 @@ void job_print_job(nvObj_t *nv) { job_populate_job_report();}
 static const char fmt_qr[] = "qr:%d\n";
 static const char fmt_qi[] = "qi:%d\n";
 static const char fmt_qo[] = "qo:%d\n";
-static const char fmt_qv[] = "[qv]  queue report verbosity%7d [0=off,1=single,2=triple]\n";
+static const char fmt_qt[] = "qt:%d\n";
+static const char fmt_qv[] = "[qv]  queue report verbosity%7d [0=off,1=single,2=triple,3=watermark]\n";
+static const char fmt_qrl[] = "[qrl] queue report low water%7d buffers\n";
+static const char fmt_qrh[] = "[qrh] queue report high water%6d buffers\n";
+static const char fmt_qri[] = "[qri] queue report interval%8d ms\n";
 
 void qr_print_qr(nvObj_t *nv) { text_print(nv, fmt_qr);}    // TYPE_INT
 void qr_print_qi(nvObj_t *nv) { text_print(nv, fmt_qi);}    // TYPE_INT
 void qr_print_qo(nvObj_t *nv) { text_print(nv, fmt_qo);}    // TYPE_INT
+void qr_print_qt(nvObj_t *nv) { text_print(nv, fmt_qt);}    // TYPE_INT
 void qr_print_qv(nvObj_t *nv) { text_print(nv, fmt_qv);}    // TYPE_INT
+void qr_print_qrl(nvObj_t *nv) { text_print(nv, fmt_qrl);}  // TYPE_INT
+void qr_print_qrh(nvObj_t *nv) { text_print(nv, fmt_qrh);}  // TYPE_INT
+void qr_print_qri(nvObj_t *nv) { text_print(nv, fmt_qri);}  // TYPE_INT
 
 #endif // __TEXT_MODE
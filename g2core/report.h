@@ -44,6 +44,11 @@ typedef enum {                      // status report enable, verbosity and reque
     SR_VERBOSE                      // reports all values specified
 } srVerbosity;
 
+typedef enum {                      // status report format, set per channel
+    SR_FORMAT_JSON = 0,             // JSON (or text) as set by the communications mode
+    SR_FORMAT_COMPACT               // compact delta-encoded lines - see report.cpp
+} srFormat;
+
 typedef enum {
     SR_REQUEST_IMMEDIATE = 0,       // request a full or filtered status report ASAP (depending on SR_VERBOSITY setting)
     SR_REQUEST_IMMEDIATE_FULL,      // request a full status report ASAP (regardless of SR_VERBOSITY setting)
@@ -54,9 +59,16 @@ typedef enum {
 typedef enum {                      // planner queue enable and verbosity
     QR_OFF = 0,                     // no response is provided
     QR_SINGLE,                      // queue depth reported
-    QR_TRIPLE                       // queue depth reported for buffers, buffers added, buffered removed
+    QR_TRIPLE,                      // queue depth reported for buffers, buffers added, buffered removed
+    QR_WATERMARK                    // triple plus planned time, only on watermark crossings or every qri ms
 } qrVerbosity;
 
+typedef enum {                      // where available buffers are relative to the QR watermarks
+    QR_BELOW_LOW_WATER = 0,
+    QR_BETWEEN_WATERS,
+    QR_ABOVE_HIGH_WATER
+} qrWaterZone;
+
 
 struct status_report_item { // structure to hold the cached status report items, saving time for lookup
     char group[GROUP_LEN + 1];
@@ -81,12 +93,18 @@ typedef struct srSingleton {
     index_t stat_index;                                 // table index value for stat - determined during initialization
     uint8_t throttle_counter;                           // slow down SRs when in a constrained time (not phat_city)
     status_report_item status_report_list[NV_STATUS_REPORT_LEN];   // status report elements to report
+    bool compact_keyframe_pending;                      // next compact SR must send absolute values
+    int32_t compact_value[NV_STATUS_REPORT_LEN];        // scaled values last sent in compact SRs
+    uint64_t compact_null;                              // bit N set if field N was null in the last keyframe
 } srSingleton_t;
 
 typedef struct qrSingleton {        // data for queue reports
 
     /*** config values (PUBLIC) ***/
     qrVerbosity queue_report_verbosity;     // queue reports enabled and verbosity level
+    uint8_t low_water;                      // QR_WATERMARK: report when buffers available fall to this
+    uint8_t high_water;                     // QR_WATERMARK: report when buffers available rise to this
+    int32_t min_interval;                   // QR_WATERMARK: report other changes at most this often (ms)
 
     /*** runtime values (PRIVATE) ***/
     uint8_t queue_report_requested;         // set to true to request a report
@@ -96,6 +114,7 @@ typedef struct qrSingleton {        // data for queue reports
     uint16_t buffers_removed;               // buffers removed since last report
     uint8_t motion_mode;                    // used to detect arc movement
     uint32_t init_tick;                     // time when values were last initialized or cleared
+    qrWaterZone water_zone;                 // QR_WATERMARK: zone at the last report
 
 } qrSingleton_t;
 
@@ -127,6 +146,8 @@ stat_t sr_get_sv(nvObj_t *nv);
 stat_t sr_set_sv(nvObj_t *nv);
 stat_t sr_get_si(nvObj_t *nv);
 stat_t sr_set_si(nvObj_t *nv);
+stat_t sr_get_sf(nvObj_t *nv);
+stat_t sr_set_sf(nvObj_t *nv);
 
 void qr_init_queue_report(void);
 void qr_request_queue_report(int8_t buffers);
@@ -138,29 +159,46 @@ stat_t rx_report_callback(void);
 stat_t qr_get(nvObj_t *nv);
 stat_t qi_get(nvObj_t *nv);
 stat_t qo_get(nvObj_t *nv);
+stat_t qt_get(nvObj_t *nv);
 
 stat_t qr_get_qv(nvObj_t *nv);
 stat_t qr_set_qv(nvObj_t *nv);
+stat_t qr_get_qrl(nvObj_t *nv);
+stat_t qr_set_qrl(nvObj_t *nv);
+stat_t qr_get_qrh(nvObj_t *nv);
+stat_t qr_set_qrh(nvObj_t *nv);
+stat_t qr_get_qri(nvObj_t *nv);
+stat_t qr_set_qri(nvObj_t *nv);
 
 #ifdef __TEXT_MODE
 
     void sr_print_sr(nvObj_t *nv);
     void sr_print_si(nvObj_t *nv);
     void sr_print_sv(nvObj_t *nv);
+    void sr_print_sf(nvObj_t *nv);
     void qr_print_qv(nvObj_t *nv);
     void qr_print_qr(nvObj_t *nv);
     void qr_print_qi(nvObj_t *nv);
     void qr_print_qo(nvObj_t *nv);
+    void qr_print_qt(nvObj_t *nv);
+    void qr_print_qrl(nvObj_t *nv);
+    void qr_print_qrh(nvObj_t *nv);
+    void qr_print_qri(nvObj_t *nv);
 
 #else
 
     #define sr_print_sr tx_print_stub
     #define sr_print_si tx_print_stub
     #define sr_print_sv tx_print_stub
+    #define sr_print_sf tx_print_stub
     #define qr_print_qv tx_print_stub
     #define qr_print_qr tx_print_stub
     #define qr_print_qi tx_print_stub
     #define qr_print_qo tx_print_stub
+    #define qr_print_qt tx_print_stub
+    #define qr_print_qrl tx_print_stub
+    #define qr_print_qrh tx_print_stub
+    #define qr_print_qri tx_print_stub
 
 #endif // __TEXT_MODE
 
@@ -77,6 +77,9 @@
 #ifndef HARD_LIMIT_ENABLE
 #define HARD_LIMIT_ENABLE           1       // {lim: 0=off, 1=on
 #endif
+#ifndef HOMING_SIMULTANEOUS
+#define HOMING_SIMULTANEOUS         0       // {hms: 0=axis by axis, 1=Z first, then other axes together
+#endif
 #ifndef SAFETY_INTERLOCK_ENABLE
 #define SAFETY_INTERLOCK_ENABLE     1       // {saf: 0=off, 1=on
 #endif
@@ -106,6 +109,18 @@
 #endif
 #endif
 
+#ifndef SPINDLE_TACH_INPUT
+#define SPINDLE_TACH_INPUT          0     // {spti: 0=no tachometer, else digital input of the tach
+#endif
+
+#ifndef SPINDLE_TACH_PULSES_PER_REV
+#define SPINDLE_TACH_PULSES_PER_REV 1     // {sptp:
+#endif
+
+#ifndef SPINDLE_AT_SPEED_TOLERANCE
+#define SPINDLE_AT_SPEED_TOLERANCE  0.05  // {spat: fraction of target speed counted as "at speed"
+#endif
+
 #ifndef SPINDLE_OVERRIDE_ENABLE
 #define SPINDLE_OVERRIDE_ENABLE 1
 #endif
@@ -134,6 +149,14 @@
 #define SPINDLE_SPEED_MAX     1000000.0     // {spsm:
 #endif
 
+#ifndef RASTER_BITS_PER_PIXEL
+#define RASTER_BITS_PER_PIXEL       8       // {rstb: 1, 4 or 8
+#endif
+
+#ifndef RASTER_OVERSCAN
+#define RASTER_OVERSCAN             0.0     // {rsto: unlit run-in / run-out of raster moves (mm)
+#endif
+
 #ifndef COOLANT_MIST_POLARITY
 #define COOLANT_MIST_POLARITY       1       // {comp: 0=active low, 1=active high
 #endif
@@ -150,6 +173,10 @@
 #define FEEDHOLD_Z_LIFT             0       // {zl: mm to lift Z on feedhold
 #endif
 
+#ifndef FEEDHOLD_HIGH_JERK
+#define FEEDHOLD_HIGH_JERK          false   // {fhj: true to brake feedholds at jerk_high for the shortest stop
+#endif
+
 #ifndef PROBE_REPORT_ENABLE
 #define PROBE_REPORT_ENABLE         true    // {prbr:
 #endif
@@ -196,7 +223,19 @@
 #endif
 
 #ifndef QUEUE_REPORT_VERBOSITY
-#define QUEUE_REPORT_VERBOSITY      QR_OFF                  // {qv: QR_OFF, QR_SINGLE, QR_TRIPLE
+#define QUEUE_REPORT_VERBOSITY      QR_OFF                  // {qv: QR_OFF, QR_SINGLE, QR_TRIPLE, QR_WATERMARK
+#endif
+
+#ifndef QUEUE_REPORT_LOW_WATER
+#define QUEUE_REPORT_LOW_WATER      8                       // {qrl: QR_WATERMARK - report when available buffers fall to this
+#endif
+
+#ifndef QUEUE_REPORT_HIGH_WATER
+#define QUEUE_REPORT_HIGH_WATER     24                      // {qrh: QR_WATERMARK - report when available buffers rise to this
+#endif
+
+#ifndef QUEUE_REPORT_INTERVAL_MS
+#define QUEUE_REPORT_INTERVAL_MS    250                     // {qri: QR_WATERMARK - report other changes at most this often
 #endif
 
 #ifndef STATUS_REPORT_VERBOSITY
@@ -297,6 +336,12 @@
 #ifndef M1_POWER_LEVEL_IDLE
 #define M1_POWER_LEVEL_IDLE         (M1_POWER_LEVEL/2.0)
 #endif
+#ifndef M1_CORRECTION_KP
+#define M1_CORRECTION_KP           0.0                     // {1cp:  following error correction P gain, 0=off
+#endif
+#ifndef M1_CORRECTION_KI
+#define M1_CORRECTION_KI           0.0                     // {1ci:  following error correction I gain, 0=off
+#endif
 
 // MOTOR 2
 #ifndef M2_MOTOR_MAP
@@ -332,6 +377,12 @@
 #ifndef M2_POWER_LEVEL_IDLE
 #define M2_POWER_LEVEL_IDLE         (M2_POWER_LEVEL/2.0)
 #endif
+#ifndef M2_CORRECTION_KP
+#define M2_CORRECTION_KP           0.0                     // {2cp:  following error correction P gain, 0=off
+#endif
+#ifndef M2_CORRECTION_KI
+#define M2_CORRECTION_KI           0.0                     // {2ci:  following error correction I gain, 0=off
+#endif
 
 // MOTOR 3
 #ifndef M3_MOTOR_MAP
@@ -367,6 +418,12 @@
 #ifndef M3_POWER_LEVEL_IDLE
 #define M3_POWER_LEVEL_IDLE         (M3_POWER_LEVEL/2.0)
 #endif
+#ifndef M3_CORRECTION_KP
+#define M3_CORRECTION_KP           0.0                     // {3cp:  following error correction P gain, 0=off
+#endif
+#ifndef M3_CORRECTION_KI
+#define M3_CORRECTION_KI           0.0                     // {3ci:  following error correction I gain, 0=off
+#endif
 
 // MOTOR 4
 #ifndef M4_MOTOR_MAP
@@ -402,6 +459,12 @@
 #ifndef M4_POWER_LEVEL_IDLE
 #define M4_POWER_LEVEL_IDLE         (M4_POWER_LEVEL/2.0)
 #endif
+#ifndef M4_CORRECTION_KP
+#define M4_CORRECTION_KP           0.0                     // {4cp:  following error correction P gain, 0=off
+#endif
+#ifndef M4_CORRECTION_KI
+#define M4_CORRECTION_KI           0.0                     // {4ci:  following error correction I gain, 0=off
+#endif
 
 // MOTOR 5
 #ifndef M5_MOTOR_MAP
@@ -437,6 +500,12 @@
 #ifndef M5_POWER_LEVEL_IDLE
 #define M5_POWER_LEVEL_IDLE         (M5_POWER_LEVEL/2.0)
 #endif
+#ifndef M5_CORRECTION_KP
+#define M5_CORRECTION_KP           0.0                     // {5cp:  following error correction P gain, 0=off
+#endif
+#ifndef M5_CORRECTION_KI
+#define M5_CORRECTION_KI           0.0                     // {5ci:  following error correction I gain, 0=off
+#endif
 
 // MOTOR 6
 #ifndef M6_MOTOR_MAP
@@ -472,6 +541,12 @@
 #ifndef M6_POWER_LEVEL_IDLE
 #define M6_POWER_LEVEL_IDLE         (M6_POWER_LEVEL/2.0)
 #endif
+#ifndef M6_CORRECTION_KP
+#define M6_CORRECTION_KP           0.0                     // {6cp:  following error correction P gain, 0=off
+#endif
+#ifndef M6_CORRECTION_KI
+#define M6_CORRECTION_KI           0.0                     // {6ci:  following error correction I gain, 0=off
+#endif
 
 // TMC2130 config defaults
 // START Generated with ${PROJECT_ROOT}/Resources/generate_motors_default_config.js
@@ -760,6 +835,9 @@
 #ifndef X_ZERO_BACKOFF
 #define X_ZERO_BACKOFF              2.0                     // {xzb:  mm
 #endif
+#ifndef X_HOMING_STALL_THRESHOLD
+#define X_HOMING_STALL_THRESHOLD    0                       // {xsg:  sensorless homing stall threshold, or 0 to use the homing input
+#endif
 
 // Y AXIS
 #ifndef Y_AXIS_MODE
@@ -801,6 +879,9 @@
 #ifndef Y_ZERO_BACKOFF
 #define Y_ZERO_BACKOFF              2.0
 #endif
+#ifndef Y_HOMING_STALL_THRESHOLD
+#define Y_HOMING_STALL_THRESHOLD    0                       // {ysg:  sensorless homing stall threshold, or 0 to use the homing input
+#endif
 
 // Z AXIS
 #ifndef Z_AXIS_MODE
@@ -842,6 +923,9 @@
 #ifndef Z_ZERO_BACKOFF
 #define Z_ZERO_BACKOFF              2.0
 #endif
+#ifndef Z_HOMING_STALL_THRESHOLD
+#define Z_HOMING_STALL_THRESHOLD    0                       // {zsg:  sensorless homing stall threshold, or 0 to use the homing input
+#endif
 
 // U AXIS
 #ifndef U_AXIS_MODE
@@ -883,6 +967,9 @@
 #ifndef U_ZERO_BACKOFF
 #define U_ZERO_BACKOFF              2.0                     // {xzb:  mm
 #endif
+#ifndef U_HOMING_STALL_THRESHOLD
+#define U_HOMING_STALL_THRESHOLD    0                       // {usg:  sensorless homing stall threshold, or 0 to use the homing input
+#endif
 
 // V AXIS
 #ifndef V_AXIS_MODE
@@ -924,6 +1011,9 @@
 #ifndef V_ZERO_BACKOFF
 #define V_ZERO_BACKOFF              2.0
 #endif
+#ifndef V_HOMING_STALL_THRESHOLD
+#define V_HOMING_STALL_THRESHOLD    0                       // {vsg:  sensorless homing stall threshold, or 0 to use the homing input
+#endif
 
 // W AXIS
 #ifndef W_AXIS_MODE
@@ -965,6 +1055,9 @@
 #ifndef W_ZERO_BACKOFF
 #define W_ZERO_BACKOFF              2.0
 #endif
+#ifndef W_HOMING_STALL_THRESHOLD
+#define W_HOMING_STALL_THRESHOLD    0                       // {wsg:  sensorless homing stall threshold, or 0 to use the homing input
+#endif
 
 /***************************************************************************************
  * Rotary values can be chosen to make the motor react the same as X for testing
@@ -1041,6 +1134,9 @@
 #ifndef A_ZERO_BACKOFF
 #define A_ZERO_BACKOFF              2.0
 #endif
+#ifndef A_HOMING_STALL_THRESHOLD
+#define A_HOMING_STALL_THRESHOLD    0                       // {asg:  sensorless homing stall threshold, or 0 to use the homing input
+#endif
 
 // B AXIS
 #ifndef B_AXIS_MODE
@@ -1085,6 +1181,9 @@
 #ifndef B_ZERO_BACKOFF
 #define B_ZERO_BACKOFF              2.0
 #endif
+#ifndef B_HOMING_STALL_THRESHOLD
+#define B_HOMING_STALL_THRESHOLD    0                       // {bsg:  sensorless homing stall threshold, or 0 to use the homing input
+#endif
 
 // C AXIS
 #ifndef C_AXIS_MODE
@@ -1129,6 +1228,9 @@
 #ifndef C_ZERO_BACKOFF
 #define C_ZERO_BACKOFF              2.0
 #endif
+#ifndef C_HOMING_STALL_THRESHOLD
+#define C_HOMING_STALL_THRESHOLD    0                       // {csg:  sensorless homing stall threshold, or 0 to use the homing input
+#endif
 
 
 //*****************************************************************************
@@ -229,6 +229,29 @@ stat_t sp_set_spde(nvObj_t *nv) {
     return (STAT_OK);
 }
 
+stat_t sp_get_spti(nvObj_t *nv) { return (get_integer(nv, active_toolhead->get_tach_input())); }
+stat_t sp_set_spti(nvObj_t *nv) {
+    uint8_t new_input;
+    ritorno(set_integer(nv, new_input, 0, D_IN_CHANNELS));
+    active_toolhead->set_tach_input(new_input);
+    return (STAT_OK);
+}
+stat_t sp_get_sptp(nvObj_t *nv) { return (get_float(nv, active_toolhead->get_tach_ppr())); }
+stat_t sp_set_sptp(nvObj_t *nv) {
+    float new_ppr;
+    ritorno(set_float_range(nv, new_ppr, 1, 1000));
+    active_toolhead->set_tach_ppr(new_ppr);
+    return (STAT_OK);
+}
+stat_t sp_get_spat(nvObj_t *nv) { return (get_float(nv, active_toolhead->get_at_speed_tolerance())); }
+stat_t sp_set_spat(nvObj_t *nv) {
+    float new_tolerance;
+    ritorno(set_float_range(nv, new_tolerance, 0.001, 0.5));
+    active_toolhead->set_at_speed_tolerance(new_tolerance);
+    return (STAT_OK);
+}
+stat_t sp_get_spsa(nvObj_t *nv) { return (get_float(nv, active_toolhead->get_speed_measured())); }
+
 stat_t sp_get_spsn(nvObj_t *nv) { return (get_float(nv, active_toolhead->get_speed_min())); }
 stat_t sp_set_spsn(nvObj_t *nv) {
     float new_speed;
@@ -430,6 +453,10 @@ const char fmt_spep[] = "[spep] spindle enable polarity%5d [0=active_low,1=activ
 const char fmt_spdp[] = "[spdp] spindle direction polarity%2d [0=CW_low,1=CW_high]\n";
 const char fmt_spph[] = "[spph] spindle pause on hold%7d [0=no,1=pause_on_hold]\n";
 const char fmt_spde[] = "[spde] spindle spinup delay%10.1f seconds\n";
+const char fmt_spti[] = "[spti] spindle tach input%11d [0=none,1-N=input]\n";
+const char fmt_sptp[] = "[sptp] spindle tach pulses/rev%9.0f\n";
+const char fmt_spat[] = "[spat] spindle at-speed tolerance%6.3f [0.001 < spat < 0.500]\n";
+const char fmt_spsa[] = "[spsa] spindle speed measured%10.0f rpm\n";
 const char fmt_spsn[] = "[spsn] spindle speed min%14.2f rpm\n";
 const char fmt_spsm[] = "[spsm] spindle speed max%14.2f rpm\n";
 const char fmt_spoe[] = "[spoe] spindle speed override ena%2d [0=disable,1=enable]\n";
@@ -442,6 +469,10 @@ void sp_print_spep(nvObj_t *nv) { text_print(nv, fmt_spep);}    // TYPE_INT
 void sp_print_spdp(nvObj_t *nv) { text_print(nv, fmt_spdp);}    // TYPE_INT
 void sp_print_spph(nvObj_t *nv) { text_print(nv, fmt_spph);}    // TYPE_INT
 void sp_print_spde(nvObj_t *nv) { text_print(nv, fmt_spde);}    // TYPE_FLOAT
+void sp_print_spti(nvObj_t *nv) { text_print(nv, fmt_spti);}    // TYPE_INT
+void sp_print_sptp(nvObj_t *nv) { text_print(nv, fmt_sptp);}    // TYPE_FLOAT
+void sp_print_spat(nvObj_t *nv) { text_print(nv, fmt_spat);}    // TYPE_FLOAT
+void sp_print_spsa(nvObj_t *nv) { text_print(nv, fmt_spsa);}    // TYPE_FLOAT
 void sp_print_spsn(nvObj_t *nv) { text_print(nv, fmt_spsn);}    // TYPE_FLOAT
 void sp_print_spsm(nvObj_t *nv) { text_print(nv, fmt_spsm);}    // TYPE_FLOAT
 void sp_print_spoe(nvObj_t *nv) { text_print(nv, fmt_spoe);}    // TYPE INT
@@ -478,6 +509,9 @@ constexpr cfgItem_t spindle_config_items_1[] = {
     { "sp","spmo", _i0,  0, sp_print_spmo, get_nul,     set_nul,     nullptr, 0 }, // keeping this key around, but it returns null and does nothing
     { "sp","spph", _bip, 0, sp_print_spph, sp_get_spph, sp_set_spph, nullptr, SPINDLE_PAUSE_ON_HOLD },
     { "sp","spde", _fip, 2, sp_print_spde, sp_get_spde, sp_set_spde, nullptr, SPINDLE_SPINUP_DELAY },
+    { "sp","spti", _iip, 0, sp_print_spti, sp_get_spti, sp_set_spti, nullptr, SPINDLE_TACH_INPUT },
+    { "sp","sptp", _fip, 0, sp_print_sptp, sp_get_sptp, sp_set_sptp, nullptr, SPINDLE_TACH_PULSES_PER_REV },
+    { "sp","spat", _fip, 3, sp_print_spat, sp_get_spat, sp_set_spat, nullptr, SPINDLE_AT_SPEED_TOLERANCE },
     { "sp","spsn", _fip, 2, sp_print_spsn, sp_get_spsn, sp_set_spsn, nullptr, SPINDLE_SPEED_MIN},
     { "sp","spsm", _fip, 2, sp_print_spsm, sp_get_spsm, sp_set_spsm, nullptr, SPINDLE_SPEED_MAX},
     { "sp","spep", _iip, 0, sp_print_spep, sp_get_spep, sp_set_spep, nullptr, SPINDLE_ENABLE_POLARITY },
@@ -486,6 +520,7 @@ constexpr cfgItem_t spindle_config_items_1[] = {
     { "sp","spo",  _fip, 3, sp_print_spo,  sp_get_spo,  sp_set_spo,  nullptr, SPINDLE_OVERRIDE_FACTOR},
     { "sp","spc",  _i0,  0, sp_print_spc,  sp_get_spc,  sp_set_spc,  nullptr, 0 },   // spindle state
     { "sp","sps",  _f0,  0, sp_print_sps,  sp_get_sps,  sp_set_sps,  nullptr, 0 },   // spindle speed
+    { "sp","spsa", _f0,  0, sp_print_spsa, sp_get_spsa, set_ro,      nullptr, 0 },   // measured spindle speed (tach)
 };
 constexpr cfgSubtableFromStaticArray spindle_config_1 {spindle_config_items_1};
 const configSubtable * const getSpindleConfig_1() { return &spindle_config_1; }
@@ -113,6 +113,13 @@ class ToolHead  // TODO: Move to a toolhead file
     virtual float get_speed_change_per_tick() { return 0.0; }
     virtual void set_spinup_delay(float new_spinup_delay) { /* do nothing */ }
     virtual float get_spinup_delay() { return 0.0; }
+    virtual bool set_tach_input(const uint8_t tach_input) { return false; }
+    virtual uint8_t get_tach_input() { return 0; }
+    virtual void set_tach_ppr(float new_tach_ppr) { /* do nothing */ }
+    virtual float get_tach_ppr() { return 0.0; }
+    virtual void set_at_speed_tolerance(float new_tolerance) { /* do nothing */ }
+    virtual float get_at_speed_tolerance() { return 0.0; }
+    virtual float get_speed_measured() { return 0.0; }
 
     virtual void set_cw_speed_lo(float new_speed_lo) { /* do nothing */ }
     virtual float get_cw_speed_lo() { return 0.0; }
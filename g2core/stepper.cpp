@@ -41,6 +41,7 @@
 #include "xio.h"
 #include "kinematics.h"
 #include "gpio.h"
+#include "trace.h"
 
 #include "spindle.h"
 
@@ -190,6 +191,8 @@ void stepper_reset()
         st_pre.mot[motor].prev_direction = STEP_INITIAL_DIRECTION;
         st_pre.mot[motor].direction = STEP_INITIAL_DIRECTION;
         st_pre.mot[motor].corrected_steps = 0;          // diagnostic only - no action effect
+        st_pre.mot[motor].correction_pending = 0;
+        st_pre.mot[motor].correction_integral = 0;
 ////##* Conceptual key to centering blocks within their alloted time // here probably redundant with later loading
         st_run.mot[motor].substep_accumulator = -(DDA_HALF_SUBSTEPS);
         st_run.mot[motor].start_new_block = true;           
@@ -236,6 +239,29 @@ bool st_runtime_isbusy()
     return (st_run.dda_ticks_downcount || st_run.dwell_ticks_downcount || is_a_toolhead_busy());
 }
 
+/*
+ * st_get_substep_phase() - return the fraction of a step the motor's DDA has advanced past its step count
+ *
+ *  The substep accumulator is the DDA phase. It is seeded at -DDA_HALF_SUBSTEPS and a step
+ *  is counted each time it crosses zero, so (accumulator + DDA_HALF_SUBSTEPS) / DDA_SUBSTEPS
+ *  is the distance of the continuous DDA position from the counted steps, between -0.5 and
+ *  +0.5 steps. The accumulator already integrates substep_increment and its ramp over the
+ *  DDA ticks run so far in the segment. An asynchronous event (e.g. a probe input) lands
+ *  somewhere within the current tick, so half of the current tick's increment is added.
+ *
+ *  Returns an unsigned (direction-less) value in steps; zero if the motor isn't moving.
+ *  Intended to be called with interrupts disabled, together with reading the step counts.
+ */
+
+float st_get_substep_phase(const uint8_t motor)
+{
+    if ((st_run.dda_ticks_downcount == 0) || (st_run.mot[motor].substep_increment == 0)) {
+        return (0);
+    }
+    return (((float)st_run.mot[motor].substep_accumulator + DDA_HALF_SUBSTEPS +
+             (float)st_run.mot[motor].substep_increment / 2) / DDA_SUBSTEPS);
+}
+
 /*
  * st_clc() - clear diagnostic step counters only
  *
@@ -252,6 +278,42 @@ stat_t st_clc(nvObj_t *nv)
     return(STAT_OK);
 }
 
+/*
+ * st_get_axis_load()        - combined load reading of all the motors mapped to an axis
+ * st_set_axis_stall_output() - enable or disable the stall output of all the motors mapped to an axis
+ *
+ *  The combined load is the highest load (lowest reading) of the motors, stalled or standstill
+ *  if any motor is. Returns false if none of the motors can sense load.
+ */
+
+bool st_get_axis_load(const uint8_t axis, stLoad_t &load)
+{
+    bool found = false;
+    load = { 0, UINT16_MAX, false, false };
+
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        stLoad_t motor_load;
+        if ((st_cfg.mot[motor].motor_map != axis) || !Motors[motor]->getLoad(motor_load)) {
+            continue;
+        }
+        found = true;
+        load.samples += motor_load.samples;
+        load.load = std::min(load.load, motor_load.load);
+        load.stalled |= motor_load.stalled;
+        load.standstill |= motor_load.standstill;
+    }
+    return (found);
+}
+
+void st_set_axis_stall_output(const uint8_t axis, const bool enable)
+{
+    for (uint8_t motor = MOTOR_1; motor < MOTORS; motor++) {
+        if (st_cfg.mot[motor].motor_map == axis) {
+            Motors[motor]->setStallOutput(enable);
+        }
+    }
+}
+
 /*
  * st_motor_power_callback() - callback to manage motor power sequencing
  *
@@ -536,6 +598,8 @@ static void _load_move()
         return;
     } // if (st_pre.buffer_state != PREP_BUFFER_OWNED_BY_LOADER)
 
+    TRACE(TRACE_LOAD_MOVE, st_pre.block_type, st_pre.dda_ticks);
+
     // give the toolhead a chance to react to the upcoming move
     if (st_pre.bf) {
         spindle_engage(st_pre.bf->gm);
@@ -742,6 +806,55 @@ static void _load_move()
     st_request_exec_move();                             // exec and prep next move
 }
 
+/***********************************************************************************
+ * _correct_following_error() - bounded PI correction of one motor's steps for a segment
+ *
+ *  Returns the steps to run for the segment. Only motors with a real encoder are
+ *  corrected: without one the error is the DDA's own step count against the commanded
+ *  steps, which can't see lost steps (see en_read_encoder()).
+ *
+ *  following_error is time-aligned two segments back (see _exec_aline_segment()), so the
+ *  correction applied to the segment that's running now isn't in it yet and is taken off
+ *  first. Errors inside the deadband are left alone - the count carries up to a step of
+ *  quantization error and the encoder its own resolution, and chasing either would only
+ *  add noise.
+ *
+ *  The correction is clamped to a small fraction of the segment's own steps. It trims
+ *  the segment velocity by at most that fraction and can never reverse the motor, so a
+ *  large error is worked off over many segments rather than as a jump the jerk limits
+ *  didn't plan for.
+ */
+
+#ifdef __STEP_CORRECTION
+static float _correct_following_error(const uint8_t motor, const float steps, const float following_error)
+{
+    stPrepMotor_t &pm = st_pre.mot[motor];
+    if (!en_has_external_encoder(motor)) {
+        return (steps);
+    }
+    float error = following_error - pm.correction_pending;
+    float correction = 0;
+
+    if (std::abs(error) > STEP_CORRECTION_THRESHOLD) {
+        pm.correction_integral = std::min(std::max(pm.correction_integral + error, -STEP_CORRECTION_INTEGRAL_MAX),
+                                          STEP_CORRECTION_INTEGRAL_MAX);
+        correction = st_cfg.mot[motor].correction_kp * error + st_cfg.mot[motor].correction_ki * pm.correction_integral;
+        float limit = std::abs(steps) * STEP_CORRECTION_MAX_FRACTION;
+        correction = std::min(std::max(correction, -limit), limit);
+    } else {
+        pm.correction_integral = 0;
+    }
+    pm.correction_pending = correction;
+    pm.corrected_steps += correction;
+    return (steps - correction);                            // error > 0 is ahead, so take steps off
+}
+#else
+static float _correct_following_error(const uint8_t motor, const float steps, const float following_error)
+{
+    return (steps);
+}
+#endif
+
 /***********************************************************************************
  * st_prep_line() - Prepare the next move for the loader
  *
@@ -756,7 +869,8 @@ static void _load_move()
  *      floats that typically have fractional values (fractional steps). The sign
  *      indicates direction. Motors that are not in the move should be 0 steps on input.
  *
- *    - following_error[] is a vector of measured errors to the step count. Used for correction.
+ *    - following_error[] is a vector of measured errors to the step count. Used for correction
+ *      when __STEP_CORRECTION is defined and the motor has a real encoder and correction gains set.
  *
  *    - segment_time - how many minutes the segment should run. If timing is not
  *      100% accurate this will affect the move velocity, but not the distance traveled.
@@ -794,8 +908,10 @@ stat_t st_prep_line(const float start_velocity, const float end_velocity, const
         if (fp_ZERO(steps)) {
             st_pre.mot[motor].substep_increment = 0;        // substep increment also acts as a motor flag
             st_pre.mot[motor].substep_increment_increment = 0;  
+            st_pre.mot[motor].correction_pending = 0;
             continue;
         }
+        steps = _correct_following_error(motor, steps, following_error[motor]);
 
         // Setup the direction, compensating for polarity.
         // Set the step_sign which is used by the stepper ISR to accumulate step position
@@ -892,8 +1008,10 @@ stat_t st_prep_line(const float start_velocities[], const float end_velocities[]
         if (fp_ZERO(steps)) {
             st_pre.mot[motor].substep_increment = 0;        // substep increment also acts as a motor flag
             st_pre.mot[motor].substep_increment_increment = 0;
+            st_pre.mot[motor].correction_pending = 0;
             continue;
         }
+        steps = _correct_following_error(motor, steps, following_error[motor]);
 
         // Setup the direction, compensating for polarity.
         // Set the step_sign which is used by the stepper ISR to accumulate step position
@@ -1152,6 +1270,13 @@ stat_t st_set_su(nvObj_t *nv)
     st_cfg.mot[m].steps_per_unit = nv->value_flt;
     st_cfg.mot[m].units_per_step = 1.0/st_cfg.mot[m].steps_per_unit;
 
+    // Defaults are applied in table order, so su arrives before mi has been set. Scaling
+    // TR by a zero microstep count would zero it, and setting mi then computes an infinite
+    // su from it. Leave TR alone - setting mi recomputes su from sa, tr and mi.
+    if (st_cfg.mot[m].microsteps == 0) {
+        return(STAT_OK);
+    }
+
     // Scale TR so all the other values make sense
     // You could scale any one of the other values, but TR makes the most sense
     st_cfg.mot[m].travel_rev = (360.0 * st_cfg.mot[m].microsteps) /
@@ -1212,6 +1337,20 @@ stat_t st_set_pi(nvObj_t *nv) {
     return (STAT_OK);
 }
 
+/*
+ * st_get_cp() - get following error correction proportional gain
+ * st_set_cp() - set following error correction proportional gain
+ * st_get_ci() - get following error correction integral gain
+ * st_set_ci() - set following error correction integral gain
+ *
+ *  Gains are per segment: a proportional gain of 0.2 takes 20% of the error off the
+ *  next segment (within the bounds in stepper.h). Both 0 disables correction.
+ */
+stat_t st_get_cp(nvObj_t *nv) { return(get_float(nv, st_cfg.mot[_motor(nv->index)].correction_kp)); }
+stat_t st_set_cp(nvObj_t *nv) { return(set_float_range(nv, st_cfg.mot[_motor(nv->index)].correction_kp, 0.0, 1.0)); }
+stat_t st_get_ci(nvObj_t *nv) { return(get_float(nv, st_cfg.mot[_motor(nv->index)].correction_ki)); }
+stat_t st_set_ci(nvObj_t *nv) { return(set_float_range(nv, st_cfg.mot[_motor(nv->index)].correction_ki, 0.0, 1.0)); }
+
 /*
  * st_get_pwr()	- get current motor power
  *
@@ -1414,6 +1553,8 @@ static const char fmt_0sp[] = "[%s%s] m%s step polarity%13d [0=active HIGH,1=act
 static const char fmt_0pm[] = "[%s%s] m%s power management%10d [0=disabled,1=always on,2=in cycle,3=when moving,4=reduced when idle]\n";
 static const char fmt_0pl[] = "[%s%s] m%s motor power level%13.3f [0.000=minimum, 1.000=maximum]\n";
 static const char fmt_0pi[] = "[%s%s] m%s motor idle power level%13.3f [0.000=minimum, 1.000=maximum]\n";
+static const char fmt_0cp[] = "[%s%s] m%s correction P gain%14.3f [0=off, fraction of error per segment]\n";
+static const char fmt_0ci[] = "[%s%s] m%s correction I gain%14.3f [0=off]\n";
 static const char fmt_pwr[] = "[%s%s] Motor %c power level:%12.3f\n";
 static const char fmt_0scn[] = "[%s%s] m%s net step count: %d\n";
 static const char fmt_0scu[] = "[%s%s] m%s UP step count: %d\n";
@@ -1458,6 +1599,8 @@ void st_print_sp(nvObj_t *nv) { _print_motor_int(nv, fmt_0sp);}
 void st_print_pm(nvObj_t *nv) { _print_motor_int(nv, fmt_0pm);}
 void st_print_pl(nvObj_t *nv) { _print_motor_flt(nv, fmt_0pl);}
 void st_print_pi(nvObj_t *nv) { _print_motor_flt(nv, fmt_0pi);}
+void st_print_cp(nvObj_t *nv) { _print_motor_flt(nv, fmt_0cp);}
+void st_print_ci(nvObj_t *nv) { _print_motor_flt(nv, fmt_0ci);}
 void st_print_pwr(nvObj_t *nv){ _print_motor_pwr(nv, fmt_pwr);}
 void st_print_scn(nvObj_t *nv) { _print_motor_int(nv, fmt_0scn);}
 void st_print_scu(nvObj_t *nv) { _print_motor_int(nv, fmt_0scu);}
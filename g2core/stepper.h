@@ -308,7 +308,12 @@ enum stPowerMode {
  #define DDA_HALF_SUBSTEPS (DDA_SUBSTEPS/2)
 
 
-//  Step correction settings ... ////##th OBSOLETE (removed)
+//  Step correction settings - see _correct_following_error() in stepper.cpp
+//  The gains are per motor ({1cp:, {1ci:), these are the bounds
+
+#define STEP_CORRECTION_THRESHOLD     ((float)2.00)         // following error in steps below which no correction is made
+#define STEP_CORRECTION_MAX_FRACTION  ((float)0.05)         // max correction as a fraction of the segment's own steps
+#define STEP_CORRECTION_INTEGRAL_MAX  ((float)100.0)        // integral term windup limit in steps
 
 /*
  * Stepper control structures
@@ -340,6 +345,8 @@ typedef struct cfgMotor {                   // per-motor configs
     float travel_rev;                       // mm or deg of travel per motor revolution
     float steps_per_unit;                   // microsteps per mm (or degree) of travel
     float units_per_step;                   // mm or degrees of travel per microstep
+    float correction_kp;                    // following error correction proportional gain (0 = off)
+    float correction_ki;                    // following error correction integral gain (0 = off)
 } cfgMotor_t;
 
 typedef struct stConfig {                   // stepper configs
@@ -385,7 +392,8 @@ typedef struct stPrepMotor {
     int8_t step_sign;                       // set to +1 or -1 for encoders
 
     // following error correction
-    int32_t correction_holdoff;             // count down segments between corrections
+    float correction_pending;               // correction applied to the segment now running - not yet in the error
+    float correction_integral;              // integral of the following error (steps * segments)
     float corrected_steps;                  // accumulated correction steps for the cycle (for diagnostic display only)
 
     // accumulator phase correction
@@ -411,6 +419,15 @@ extern stConfig_t st_cfg        HOT_DATA;   // config struct is exposed. The res
 extern stPrepSingleton_t st_pre HOT_DATA;   // only used by config_app diagnostics
 
 
+/**** Load sensing (sensorless homing) ****/
+
+typedef struct stLoad {
+    uint32_t samples;                   // changes whenever a new reading is available
+    uint16_t load;                      // driver load measurement - lower means more load
+    bool stalled;                       // the driver flagged a stall itself
+    bool standstill;                    // the motor wasn't turning, so load is meaningless
+} stLoad_t;
+
 /**** Stepper (base object) ****/
 
 struct Stepper {
@@ -505,6 +522,11 @@ public:
     virtual void setDirection(uint8_t direction) HOT_FUNC { /* must override */ }; // HOT - called from the DDA interrupt
     virtual void setMicrosteps(const uint16_t microsteps) { /* must override */ };
     virtual void setPowerLevels(float active_pl, float idle_pl) { /* must override */ };
+
+    /* Optional - drivers that can sense motor load (e.g. stallGuard) */
+
+    virtual bool getLoad(stLoad_t &load) { return false; };     // false if the driver can't sense load
+    virtual void setStallOutput(bool enable) {};                // drive a stall pin (e.g. DIAG) while enabled
 };
 
 /**** ExternalEncoder (base object) ****/
@@ -532,7 +554,10 @@ void stepper_init_assertions(void);
 stat_t stepper_test_assertions(void);
 
 bool st_runtime_isbusy(void);
+float st_get_substep_phase(const uint8_t motor);
 stat_t st_clc(nvObj_t *nv);
+bool st_get_axis_load(const uint8_t axis, stLoad_t &load);
+void st_set_axis_stall_output(const uint8_t axis, const bool enable);
 void st_set_motor_power(const uint8_t motor);
 stat_t st_motor_power_callback(void);
 
@@ -574,6 +599,10 @@ stat_t st_get_pl(nvObj_t *nv);
 stat_t st_get_pi(nvObj_t *nv);
 stat_t st_set_pl(nvObj_t *nv);
 stat_t st_set_pi(nvObj_t *nv);
+stat_t st_get_cp(nvObj_t *nv);
+stat_t st_set_cp(nvObj_t *nv);
+stat_t st_get_ci(nvObj_t *nv);
+stat_t st_set_ci(nvObj_t *nv);
 
 stat_t st_get_pwr(nvObj_t *nv);
 
@@ -601,6 +630,8 @@ stat_t st_set_sc(nvObj_t *nv);
     void st_print_pm(nvObj_t *nv);
     void st_print_pl(nvObj_t *nv);
     void st_print_pi(nvObj_t *nv);
+    void st_print_cp(nvObj_t *nv);
+    void st_print_ci(nvObj_t *nv);
     void st_print_pwr(nvObj_t *nv);
     void st_print_mt(nvObj_t *nv);
     void st_print_me(nvObj_t *nv);
@@ -622,6 +653,8 @@ stat_t st_set_sc(nvObj_t *nv);
     #define st_print_pm tx_print_stub
     #define st_print_pl tx_print_stub
     #define st_print_pi tx_print_stub
+    #define st_print_cp tx_print_stub
+    #define st_print_ci tx_print_stub
     #define st_print_pwr tx_print_stub
     #define st_print_mt tx_print_stub
     #define st_print_me tx_print_stub
@@ -39,6 +39,7 @@
 #include "util.h"
 #include "settings.h"
 #include "gpio.h" // for ValueHistory
+#include "temperature_pid.h"
 
 
 /**** Local safety/limit settings ****/
@@ -70,34 +71,6 @@
 //#define BED_OUTPUT_INIT {kPWMPinInverted, fet_pin3_freq};
 #endif
 
-// These could be moved to settings
-// If the temperature stays at set_point +- TEMP_SETPOINT_HYSTERESIS for more
-// than TEMP_SETPOINT_HOLD_TIME ms, it's "at temp".
-#ifndef TEMP_SETPOINT_HYSTERESIS
-#define TEMP_SETPOINT_HYSTERESIS (float)1.0 // +- 1 degrees C
-#endif
-#ifndef TEMP_SETPOINT_HOLD_TIME
-#define TEMP_SETPOINT_HOLD_TIME 1000 // a full second
-#endif
-
-// Below TEMP_OFF_BELOW is considered "off".
-// With a set temp of < TEMP_OFF_BELOW, and a measured temp of < TEMP_OFF_BELOW,
-// we are "at temp".
-#ifndef TEMP_OFF_BELOW
-#define TEMP_OFF_BELOW (float)45.0 // "safe to touch and hold for metal" with 5º margin
-#endif
-
-// If the read temp is more than TEMP_FULL_ON_DIFFERENCE less than set temp,
-// just turn the heater full-on.
-#ifndef TEMP_FULL_ON_DIFFERENCE
-#define TEMP_FULL_ON_DIFFERENCE (float)50.0
-#endif
-
-// If the temp is more than TEMP_MAX_SETPOINT, just turn the heater off,
-// regardless of set temp.
-#ifndef TEMP_MAX_SETPOINT
-#define TEMP_MAX_SETPOINT (float)300.0
-#endif
 
 // If the resistance reads higher than TEMP_MIN_DISCONNECTED_RESISTANCE, the
 // thermistor is considered disconnected.
@@ -105,22 +78,6 @@
 #define TEMP_MIN_DISCONNECTED_RESISTANCE (float)1000000.0
 #endif
 
-// If the temperature doesn't rise more than TEMP_MIN_RISE_DEGREES_OVER_TIME in
-// TEMP_MIN_RISE_TIME milliseconds, then it's a failure (the sensor is likely
-// physically dislocated.)
-#ifndef TEMP_MIN_RISE_DEGREES_OVER_TIME
-#define TEMP_MIN_RISE_DEGREES_OVER_TIME (float)10.0
-#endif
-#ifndef TEMP_MIN_BED_RISE_DEGREES_OVER_TIME
-#define TEMP_MIN_BED_RISE_DEGREES_OVER_TIME (float)3.0
-#endif
-#ifndef TEMP_MIN_RISE_TIME
-#define TEMP_MIN_RISE_TIME (float)(60.0 * 1000.0) // one minute
-#endif
-#ifndef TEMP_MIN_RISE_DEGREES_FROM_TARGET
-#define TEMP_MIN_RISE_DEGREES_FROM_TARGET (float)10.0
-#endif
-
 
 /**** Allocate structures ****/
 
@@ -279,7 +236,7 @@ struct ADCCircuitRawResistance : ADCCircuit
 };
 
 
-template<typename ADC_t, uint16_t min_temp = 0, uint16_t max_temp = 300>
+template<typename ADC_t, uint16_t min_temp = 0, uint16_t max_temp = 300, typename History_t = ValueHistory<20>>
 struct Thermistor {
     float c1, c2, c3;
     const ADCCircuit *circuit;
@@ -289,9 +246,9 @@ struct Thermistor {
     float raw_adc_voltage = 0.0;
 
     const float variance_max = 1.1;
-    ValueHistory<20> history {variance_max};
+    History_t history {variance_max};   // ValueHistory<20> or ClippedValueHistory<20>
 
-    typedef Thermistor<ADC_t, min_temp, max_temp> type;
+    typedef Thermistor<ADC_t, min_temp, max_temp, History_t> type;
 
     // References for thermistor formulas:
     //  http://assets.newport.com/webDocuments-EN/images/AN04_Thermistor_Calibration_IX.PDF
@@ -403,7 +360,7 @@ struct Thermistor {
 };
 
 
-template<typename ADC_t, uint16_t min_temp = 0, uint16_t max_temp = 400>
+template<typename ADC_t, uint16_t min_temp = 0, uint16_t max_temp = 400, typename History_t = ValueHistory<20>>
 struct PT100 {
     const ADCCircuit *circuit;
 
@@ -415,9 +372,9 @@ struct PT100 {
     uint8_t reads_without_sample = 0;
 
     const float variance_max = 1.1;
-    ValueHistory<20> history {variance_max};
+    History_t history {variance_max};   // ValueHistory<20> or ClippedValueHistory<20>
 
-    typedef PT100<ADC_t, min_temp, max_temp> type;
+    typedef PT100<ADC_t, min_temp, max_temp, History_t> type;
 
 //    PT100(const ADCCircuit *_circuit)
 //    : circuit{_circuit},
@@ -640,162 +597,6 @@ Motate::SysTickEvent adc_tick_event {[&] {
 #endif
 
 
-struct PID {
-    static constexpr float output_max = 1.0;
-    static constexpr float derivative_contribution = 1.0/10.0;
-
-    float _p_factor;                // the scale for P values
-    float _i_factor;                // the scale for I values
-    float _d_factor;                // the scale for D values
-    float _f_factor;                // the scale for O values
-
-    float _proportional = 0.0;      // _proportional storage
-    float _integral = 0.0;          // _integral storage
-    float _derivative = 0.0;        // _derivative storage
-    float _feed_forward = 0.0;            // _feed_forward storage
-    float _previous_input = 0.0;    // _derivative storage
-
-    float _set_point;
-
-    Timeout _set_point_timeout;     // used to keep track of if we are at set temp and stay there
-    bool _at_set_point;
-
-    Timeout _rise_time_timeout;     // used to keep track of if we are increasing temperature fast enough
-    float _min_rise_over_time;      // the amount of degrees that it must rise in the given time
-    float _rise_time_checkpoint;    // when we start the timer, we set _rise_time_checkpoint to the minimum goal
-
-    float _average_output = 0;
-
-    bool _enable;                   // set true to enable this heater
-
-    PID(float P, float I, float D, float F, float min_rise_over_time, float startSetPoint = 0.0) : _p_factor{P/100.0f}, _i_factor{I/100.0f}, _d_factor{D/100.0f}, _f_factor{F/100.0f}, _set_point{startSetPoint}, _at_set_point{false}, _min_rise_over_time(min_rise_over_time) {};
-
-    float getNewOutput(float input) {
-        // If the input is < 0, the sensor failed
-        if (input < 0) {
-            if (_set_point > TEMP_OFF_BELOW) {
-                cm_alarm(STAT_TEMPERATURE_CONTROL_ERROR, "Heater set, but sensor read failed.");
-            }
-
-            return 0;
-        }
-
-        // Calculate the e (error)
-        float e = _set_point - input;
-
-        if (std::abs(e) < TEMP_SETPOINT_HYSTERESIS) {
-            if (!_set_point_timeout.isSet()) {
-                _set_point_timeout.set(TEMP_SETPOINT_HOLD_TIME);
-            } else if (_set_point_timeout.isPast()) {
-                _at_set_point = true;
-                _set_point_timeout.clear();
-            }
-        } else {
-            _at_set_point = false;
-
-            // Check to see if we already have the rise_time timeout set
-            if (_rise_time_timeout.isSet()) {
-                if (_rise_time_timeout.isPast()) {
-                    if (input < _rise_time_checkpoint) {
-                        // FAILURE!!
-                        char buffer[128];
-                        char *str = buffer;
-                        str += sprintf(str, "Heater temperature failed to rise fast enough. At: %f Set: %f", input, _set_point);
-                        cm_alarm(STAT_TEMPERATURE_CONTROL_ERROR, buffer);
-                        _set_point = 0;
-                        _rise_time_timeout.clear();
-                        return -1;
-                    }
-
-                    _rise_time_timeout.clear();
-                }
-            }
-
-            if (!_rise_time_timeout.isSet() && (_set_point > (input + TEMP_MIN_RISE_DEGREES_FROM_TARGET))) {
-                _rise_time_timeout.set(TEMP_MIN_RISE_TIME);
-                _rise_time_checkpoint = std::min(input + _min_rise_over_time, _set_point + TEMP_SETPOINT_HYSTERESIS);
-            }
-        }
-
-        // P = Proportional
-
-        float p = _p_factor * e;
-        // For output's sake, we'll store this, otherwise we don't need it:
-        _proportional = p;
-
-
-        // I = Integral
-
-        // Now, to restrict windup, prevent the integral from contributing too much, AND to keep it sane:
-        // 1) Limit the i contribution to the output
-        // 2) Limit the _integral maximum value
-        // 3) Reset _integral to e if output has to be clamped (after output is computed)
-        _integral += e;
-        float i = _integral * _i_factor;
-
-        if (i > 0.75) {
-            i = 0.75;
-            _integral = 0.75 / _i_factor;
-        } else if (i < -0.75) {
-            i = -0.75;
-            _integral = -0.75 / _i_factor;
-        }
-
-        // D = derivative
-
-        // This needs to be smoothed somewhat, so we use a exponential moving average.
-        // See https://en.wikipedia.org/wiki/Moving_average#Exponential_moving_average
-
-
-        _derivative = (input - _previous_input)*(derivative_contribution) + (_derivative * (1.0-derivative_contribution));
-        float d = _derivative * _d_factor;
-
-        // F = feed-forward
-
-        _feed_forward = (_set_point-21); // 21 is for a roughly ideal room temperature
-
-        float f = _f_factor * _feed_forward;
-
-        _previous_input = input;
-
-        // Now that we've computed all that, we'll decide when to ignore it
-
-        float output = p + i + f - d;
-        if (output < 0.0f) {
-            output = 0;
-
-            // reset the integral to prevent windup
-            _integral = e;
-        } else if (output > output_max) {
-            output = output_max;
-
-            // reset the integral to prevent windup
-            _integral = e;
-        }
-
-        // If the setpoint is "off" or the temperature is higher than MAX, always return OFF
-        if ((_set_point < TEMP_OFF_BELOW) || (input > TEMP_MAX_SETPOINT)) {
-            output = 0; // "off"
-            _average_output = 0;
-
-            return 0;
-        // If we are too far from the set point, turn the heater full on
-        }
-//        else if (e > TEMP_FULL_ON_DIFFERENCE) {
-//            output = 1; // "on"
-//        }
-
-        // Keep track of our output with some averaging for output purposes
-        _average_output = (0.5*output) + (0.5*_average_output);
-
-        return _average_output; // return the smoothed value
-    };
-
-    bool atSetPoint() {
-        return _at_set_point;
-    }
-};
-
 // NOTICE, the JSON alters incoming values for these!
 // {he1p:9} == 9.0/100.0 here
 
@@ -865,6 +666,29 @@ void temperature_init()
     temperature_reset();
 }
 
+/*
+ * _persist_heater_gains() - write a heater's P, I and D to NVM after an autotune
+ */
+static void _persist_heater_gains(PID &pid, const char heater)
+{
+    if (!pid._tune_persist_pending) {
+        return;
+    }
+    pid._tune_persist_pending = false;
+
+    const char factors[] = {'p', 'i', 'd'};
+    for (uint8_t f = 0; f < 3; f++) {
+        nvObj_t nv;
+        memset(&nv, 0, sizeof(nv));
+        sprintf(nv.token, "he%c%c", heater, factors[f]);
+        if ((nv.index = nv_get_index("", nv.token)) == NO_MATCH) {
+            continue;
+        }
+        nv_get(&nv);
+        nv_persist(&nv);
+    }
+}
+
 void temperature_reset()
 {
     // make setpoint 0
@@ -877,7 +701,7 @@ void temperature_reset()
     fet_pin3 = 0.0f;
     pid3._set_point = 0.0;
 
-    pid_timeout.set(100);
+    pid_timeout.set(TEMP_PID_PERIOD_MS);
 }
 
 // Minimum difference in temp before it'll trigger an SR
@@ -900,7 +724,7 @@ stat_t temperature_callback()
     }
 
     if (pid_timeout.isPast()) {
-        pid_timeout.set(100);
+        pid_timeout.set(TEMP_PID_PERIOD_MS);
 
         float temp = 0.0;
         float fan_temp = 0.0;
@@ -946,6 +770,10 @@ stat_t temperature_callback()
         if (sr_requested) {
             sr_request_status_report(SR_REQUEST_TIMED);
         }
+
+        _persist_heater_gains(pid1, '1');
+        _persist_heater_gains(pid2, '2');
+        _persist_heater_gains(pid3, '3');
     }
     return (STAT_OK);
 }
@@ -1116,6 +944,67 @@ stat_t cm_set_heater_f(nvObj_t *nv)
     return (STAT_OK);
 }
 
+/****************************************************************************************
+ * cm_get_heater_autotune() - get the autotune state: 0=off, 1=running, 2=done, 3=failed
+ * cm_set_heater_autotune() - start a relay autotune at the given temperature, 0 cancels
+ * cm_get_heater_autotune_persist() - get whether autotune results are persisted
+ * cm_set_heater_autotune_persist() - set to persist P, I and D when an autotune completes
+ *
+ * On completion the new gains are in effect (he1p, he1i, he1d) and the heater is off.
+ */
+
+static PID *_get_heater_pid(nvObj_t *nv)
+{
+    switch(_get_heater_number(nv)) {
+        case '1': { return (&pid1); }
+        case '2': { return (&pid2); }
+        case '3': { return (&pid3); }
+        default: { return (nullptr); }
+    }
+}
+
+stat_t cm_get_heater_autotune(nvObj_t *nv)
+{
+    PID *pid = _get_heater_pid(nv);
+    nv->value_int = (pid != nullptr) ? pid->_tune_state : 0;
+    nv->valuetype = TYPE_INTEGER;
+    return (STAT_OK);
+}
+
+stat_t cm_set_heater_autotune(nvObj_t *nv)
+{
+    PID *pid = _get_heater_pid(nv);
+    if (pid == nullptr) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    if (fp_ZERO(nv->value_flt)) {
+        pid->stopAutotune();
+        return (STAT_OK);
+    }
+    if (!pid->startAutotune(nv->value_flt)) {
+        return (STAT_COMMAND_NOT_ACCEPTED);     // heater disabled or temperature out of range
+    }
+    return (STAT_OK);
+}
+
+stat_t cm_get_heater_autotune_persist(nvObj_t *nv)
+{
+    PID *pid = _get_heater_pid(nv);
+    nv->value_int = (pid != nullptr) ? pid->_tune_persist : false;
+    nv->valuetype = TYPE_BOOLEAN;
+    return (STAT_OK);
+}
+
+stat_t cm_set_heater_autotune_persist(nvObj_t *nv)
+{
+    PID *pid = _get_heater_pid(nv);
+    if (pid == nullptr) {
+        return (STAT_INPUT_VALUE_RANGE_ERROR);
+    }
+    pid->_tune_persist = (nv->value_int != 0);
+    return (STAT_OK);
+}
+
 /****************************************************************************************
  * cm_get_set_temperature() - get the set value of the PID
  * cm_set_set_temperature() - set the set value of the PID
@@ -48,6 +48,10 @@ stat_t cm_get_heater_d(nvObj_t* nv);
 stat_t cm_set_heater_d(nvObj_t* nv);
 stat_t cm_get_heater_f(nvObj_t* nv);
 stat_t cm_set_heater_f(nvObj_t* nv);
+stat_t cm_get_heater_autotune(nvObj_t* nv);
+stat_t cm_set_heater_autotune(nvObj_t* nv);
+stat_t cm_get_heater_autotune_persist(nvObj_t* nv);
+stat_t cm_set_heater_autotune_persist(nvObj_t* nv);
 stat_t cm_get_pid_p(nvObj_t* nv);
 stat_t cm_get_pid_i(nvObj_t* nv);
 stat_t cm_get_pid_d(nvObj_t* nv);
@@ -0,0 +1,404 @@
+/*
+ * temperature_pid.h - heater PID and relay autotune
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2016 - 2019 Robert Giseburt
+ * Copyright (c) 2016 - 2019 Alden S. Hart, Jr.
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with  other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TEMPERATURE_PID_H_ONCE
+#define TEMPERATURE_PID_H_ONCE
+
+#include <algorithm>
+#include <cmath>
+
+/*
+ * The PID is kept apart from the sensors and outputs in temperature.cpp so it can
+ * also be run against a simulated heater (see host/bench/autotune_sim.cpp).
+ * Include after canonical_machine.h (cm_alarm) and util.h (fp_ZERO).
+ */
+
+// These could be moved to settings
+// If the temperature stays at set_point +- TEMP_SETPOINT_HYSTERESIS for more
+// than TEMP_SETPOINT_HOLD_TIME ms, it's "at temp".
+#ifndef TEMP_SETPOINT_HYSTERESIS
+#define TEMP_SETPOINT_HYSTERESIS (float)1.0 // +- 1 degrees C
+#endif
+#ifndef TEMP_SETPOINT_HOLD_TIME
+#define TEMP_SETPOINT_HOLD_TIME 1000 // a full second
+#endif
+
+// Below TEMP_OFF_BELOW is considered "off".
+// With a set temp of < TEMP_OFF_BELOW, and a measured temp of < TEMP_OFF_BELOW,
+// we are "at temp".
+#ifndef TEMP_OFF_BELOW
+#define TEMP_OFF_BELOW (float)45.0 // "safe to touch and hold for metal" with 5º margin
+#endif
+
+// If the read temp is more than TEMP_FULL_ON_DIFFERENCE less than set temp,
+// just turn the heater full-on.
+#ifndef TEMP_FULL_ON_DIFFERENCE
+#define TEMP_FULL_ON_DIFFERENCE (float)50.0
+#endif
+
+// If the temp is more than TEMP_MAX_SETPOINT, just turn the heater off,
+// regardless of set temp.
+#ifndef TEMP_MAX_SETPOINT
+#define TEMP_MAX_SETPOINT (float)300.0
+#endif
+
+// If the temperature doesn't rise more than TEMP_MIN_RISE_DEGREES_OVER_TIME in
+// TEMP_MIN_RISE_TIME milliseconds, then it's a failure (the sensor is likely
+// physically dislocated.)
+#ifndef TEMP_MIN_RISE_DEGREES_OVER_TIME
+#define TEMP_MIN_RISE_DEGREES_OVER_TIME (float)10.0
+#endif
+#ifndef TEMP_MIN_BED_RISE_DEGREES_OVER_TIME
+#define TEMP_MIN_BED_RISE_DEGREES_OVER_TIME (float)3.0
+#endif
+#ifndef TEMP_MIN_RISE_TIME
+#define TEMP_MIN_RISE_TIME (float)(60.0 * 1000.0) // one minute
+#endif
+#ifndef TEMP_MIN_RISE_DEGREES_FROM_TARGET
+#define TEMP_MIN_RISE_DEGREES_FROM_TARGET (float)10.0
+#endif
+
+// The PIDs are run every TEMP_PID_PERIOD_MS milliseconds
+#define TEMP_PID_PERIOD_MS 100
+
+// Relay autotune: the relay switches at set point +- TEMP_AUTOTUNE_HYSTERESIS,
+// the first full oscillation is discarded and the next TEMP_AUTOTUNE_CYCLES are
+// averaged. If that takes longer than TEMP_AUTOTUNE_TIMEOUT ms the tune fails.
+#ifndef TEMP_AUTOTUNE_HYSTERESIS
+#define TEMP_AUTOTUNE_HYSTERESIS (float)1.0
+#endif
+#ifndef TEMP_AUTOTUNE_CYCLES
+#define TEMP_AUTOTUNE_CYCLES 4
+#endif
+#ifndef TEMP_AUTOTUNE_TIMEOUT
+#define TEMP_AUTOTUNE_TIMEOUT (float)(20.0 * 60.0 * 1000.0) // twenty minutes
+#endif
+
+struct PID {
+    static constexpr float output_max = 1.0;
+    static constexpr float derivative_contribution = 1.0/10.0;
+
+    float _p_factor;                // the scale for P values
+    float _i_factor;                // the scale for I values
+    float _d_factor;                // the scale for D values
+    float _f_factor;                // the scale for O values
+
+    float _proportional = 0.0;      // _proportional storage
+    float _integral = 0.0;          // _integral storage
+    float _derivative = 0.0;        // _derivative storage
+    float _feed_forward = 0.0;            // _feed_forward storage
+    float _previous_input = 0.0;    // _derivative storage
+
+    float _set_point;
+
+    Timeout _set_point_timeout;     // used to keep track of if we are at set temp and stay there
+    bool _at_set_point;
+
+    Timeout _rise_time_timeout;     // used to keep track of if we are increasing temperature fast enough
+    float _min_rise_over_time;      // the amount of degrees that it must rise in the given time
+    float _rise_time_checkpoint;    // when we start the timer, we set _rise_time_checkpoint to the minimum goal
+
+    float _average_output = 0;
+
+    bool _enable;                   // set true to enable this heater
+
+    // Relay-feedback autotune (Astrom-Hagglund). While running, the output is a relay
+    // that is full on below _set_point - h and off above _set_point + h. The loop
+    // settles into an oscillation whose period Tu and amplitude a give the ultimate
+    // gain Ku = 4d / (pi * sqrt(a^2 - h^2)), with d the relay amplitude (half of
+    // output_max). Classic Ziegler-Nichols PID gains follow from Ku and Tu.
+    enum TuneState { TUNE_OFF = 0, TUNE_RUNNING, TUNE_DONE, TUNE_FAILED };
+    TuneState _tune_state = TUNE_OFF;
+    bool _tune_persist = false;         // set true to persist the gains when the tune completes
+    bool _tune_persist_pending = false; // set when gains are ready to be persisted
+    bool _tune_relay_on;                // relay output state
+    uint8_t _tune_switches;             // relay off->on switches seen so far
+    uint32_t _tune_ticks;               // PID periods since the last off->on switch
+    uint32_t _tune_total_ticks;         // PID periods since the tune started
+    float _tune_max;                    // highest temperature in the current cycle
+    float _tune_min;                    // lowest temperature in the current cycle
+    float _tune_period_sum;             // sum of measured periods, in PID periods
+    float _tune_amplitude_sum;          // sum of measured peak-to-peak swings
+
+    PID(float P, float I, float D, float F, float min_rise_over_time, float startSetPoint = 0.0) : _p_factor{P/100.0f}, _i_factor{I/100.0f}, _d_factor{D/100.0f}, _f_factor{F/100.0f}, _set_point{startSetPoint}, _at_set_point{false}, _min_rise_over_time(min_rise_over_time) {};
+
+    float getNewOutput(float input) {
+        // If the input is < 0, the sensor failed
+        if (input < 0) {
+            if (_set_point > TEMP_OFF_BELOW) {
+                cm_alarm(STAT_TEMPERATURE_CONTROL_ERROR, "Heater set, but sensor read failed.");
+            }
+            if (_tune_state == TUNE_RUNNING) {
+                _tune_state = TUNE_FAILED;
+            }
+
+            return 0;
+        }
+
+        if (_tune_state == TUNE_RUNNING) {
+            return _getTuneOutput(input);
+        }
+
+        // Calculate the e (error)
+        float e = _set_point - input;
+
+        if (std::abs(e) < TEMP_SETPOINT_HYSTERESIS) {
+            if (!_set_point_timeout.isSet()) {
+                _set_point_timeout.set(TEMP_SETPOINT_HOLD_TIME);
+            } else if (_set_point_timeout.isPast()) {
+                _at_set_point = true;
+                _set_point_timeout.clear();
+            }
+        } else {
+            _at_set_point = false;
+
+            if (!_riseTimeOK(input)) {
+                return -1;
+            }
+        }
+
+        // P = Proportional
+
+        float p = _p_factor * e;
+        // For output's sake, we'll store this, otherwise we don't need it:
+        _proportional = p;
+
+
+        // I = Integral
+
+        // Now, to restrict windup, prevent the integral from contributing too much, AND to keep it sane:
+        // 1) Limit the i contribution to the output
+        // 2) Limit the _integral maximum value
+        // 3) Reset _integral to e if output has to be clamped (after output is computed)
+        _integral += e;
+        float i = _integral * _i_factor;
+
+        if (i > 0.75) {
+            i = 0.75;
+            _integral = 0.75 / _i_factor;
+        } else if (i < -0.75) {
+            i = -0.75;
+            _integral = -0.75 / _i_factor;
+        }
+
+        // D = derivative
+
+        // This needs to be smoothed somewhat, so we use a exponential moving average.
+        // See https://en.wikipedia.org/wiki/Moving_average#Exponential_moving_average
+
+
+        _derivative = (input - _previous_input)*(derivative_contribution) + (_derivative * (1.0-derivative_contribution));
+        float d = _derivative * _d_factor;
+
+        // F = feed-forward
+
+        _feed_forward = (_set_point-21); // 21 is for a roughly ideal room temperature
+
+        float f = _f_factor * _feed_forward;
+
+        _previous_input = input;
+
+        // Now that we've computed all that, we'll decide when to ignore it
+
+        float output = p + i + f - d;
+        if (output < 0.0f) {
+            output = 0;
+
+            // reset the integral to prevent windup
+            _integral = e;
+        } else if (output > output_max) {
+            output = output_max;
+
+            // reset the integral to prevent windup
+            _integral = e;
+        }
+
+        // If the setpoint is "off" or the temperature is higher than MAX, always return OFF
+        if ((_set_point < TEMP_OFF_BELOW) || (input > TEMP_MAX_SETPOINT)) {
+            output = 0; // "off"
+            _average_output = 0;
+
+            return 0;
+        // If we are too far from the set point, turn the heater full on
+        }
+//        else if (e > TEMP_FULL_ON_DIFFERENCE) {
+//            output = 1; // "on"
+//        }
+
+        // Keep track of our output with some averaging for output purposes
+        _average_output = (0.5*output) + (0.5*_average_output);
+
+        return _average_output; // return the smoothed value
+    };
+
+    bool atSetPoint() {
+        return _at_set_point;
+    }
+
+    // Runaway check, shared by the PID and the autotune relay: while the set point is
+    // more than TEMP_MIN_RISE_DEGREES_FROM_TARGET away, the temperature has to rise
+    // _min_rise_over_time degrees every TEMP_MIN_RISE_TIME ms. Alarms and turns the
+    // heater off (returns false) if it doesn't.
+    bool _riseTimeOK(float input) {
+        // A heater that is off can't run away - don't let a timer armed before it was
+        // turned off (or before a tune ended) alarm later
+        if (_set_point < TEMP_OFF_BELOW) {
+            _rise_time_timeout.clear();
+            return true;
+        }
+
+        // Check to see if we already have the rise_time timeout set
+        if (_rise_time_timeout.isSet()) {
+            if (_rise_time_timeout.isPast()) {
+                if (input < _rise_time_checkpoint) {
+                    // FAILURE!!
+                    char buffer[128];
+                    char *str = buffer;
+                    str += sprintf(str, "Heater temperature failed to rise fast enough. At: %f Set: %f", input, _set_point);
+                    cm_alarm(STAT_TEMPERATURE_CONTROL_ERROR, buffer);
+                    _set_point = 0;
+                    _rise_time_timeout.clear();
+                    return false;
+                }
+
+                _rise_time_timeout.clear();
+            }
+        }
+
+        if (!_rise_time_timeout.isSet() && (_set_point > (input + TEMP_MIN_RISE_DEGREES_FROM_TARGET))) {
+            _rise_time_timeout.set(TEMP_MIN_RISE_TIME);
+            _rise_time_checkpoint = std::min(input + _min_rise_over_time, _set_point + TEMP_SETPOINT_HYSTERESIS);
+        }
+        return true;
+    }
+
+    bool startAutotune(float set_point) {
+        if (!_enable || (set_point < TEMP_OFF_BELOW) || (set_point > TEMP_MAX_SETPOINT)) {
+            return false;
+        }
+        _set_point = set_point;
+        _at_set_point = false;
+        _rise_time_timeout.clear();
+        _tune_state = TUNE_RUNNING;
+        _tune_persist_pending = false;
+        _tune_relay_on = true;
+        _tune_switches = 0;
+        _tune_ticks = 0;
+        _tune_total_ticks = 0;
+        _tune_max = 0;
+        _tune_min = TEMP_MAX_SETPOINT;
+        _tune_period_sum = 0;
+        _tune_amplitude_sum = 0;
+        return true;
+    }
+
+    void stopAutotune() {
+        if (_tune_state == TUNE_RUNNING) {
+            _tune_state = TUNE_OFF;
+            _set_point = 0;
+        }
+    }
+
+    float _getTuneOutput(float input) {
+        // Setting the temperature to "off" (or an alarm doing so) cancels the tune
+        if (_set_point < TEMP_OFF_BELOW) {
+            _tune_state = TUNE_OFF;
+            return 0;
+        }
+        if ((input > TEMP_MAX_SETPOINT) ||
+            (++_tune_total_ticks > (uint32_t)(TEMP_AUTOTUNE_TIMEOUT / TEMP_PID_PERIOD_MS))) {
+            _tune_state = TUNE_FAILED;
+            _set_point = 0;
+            return 0;
+        }
+        // a heater that can't reach the set point is as much a runaway under the relay
+        if (!_riseTimeOK(input)) {
+            _tune_state = TUNE_FAILED;
+            _average_output = 0;
+            return 0;
+        }
+
+        _tune_ticks++;
+        _tune_max = std::max(_tune_max, input);
+        _tune_min = std::min(_tune_min, input);
+
+        if (_tune_relay_on && (input > (_set_point + TEMP_AUTOTUNE_HYSTERESIS))) {
+            _tune_relay_on = false;
+        } else if (!_tune_relay_on && (input < (_set_point - TEMP_AUTOTUNE_HYSTERESIS))) {
+            _tune_relay_on = true;
+
+            // A full cycle ends at each off->on switch. The first one includes the
+            // warm-up and the second may not have settled yet, so skip both.
+            if (_tune_switches >= 2) {
+                _tune_period_sum += _tune_ticks;
+                _tune_amplitude_sum += _tune_max - _tune_min;
+            }
+            _tune_switches++;
+            _tune_ticks = 0;
+            _tune_max = input;
+            _tune_min = input;
+
+            if (_tune_switches == (TEMP_AUTOTUNE_CYCLES + 2)) {
+                _finishAutotune();
+                return 0;
+            }
+        }
+        _average_output = _tune_relay_on ? output_max : 0;
+        return _average_output;
+    }
+
+    void _finishAutotune() {
+        const float dt = TEMP_PID_PERIOD_MS / 1000.0f;   // seconds per PID period
+        const float d = output_max / 2;
+        const float h = TEMP_AUTOTUNE_HYSTERESIS;
+        float a = (_tune_amplitude_sum / TEMP_AUTOTUNE_CYCLES) / 2;
+        float tu = (_tune_period_sum / TEMP_AUTOTUNE_CYCLES) * dt;
+
+        _set_point = 0;                 // leave the heater off, as before the tune
+        _rise_time_timeout.clear();
+        if ((a <= h) || fp_ZERO(tu)) {
+            _tune_state = TUNE_FAILED;
+            return;
+        }
+        float ku = (4 * d) / ((float)M_PI * std::sqrt(a*a - h*h));
+
+        // Kp = 0.6 Ku, Ti = Tu/2, Td = Tu/8, mapped onto this loop's discrete form:
+        // the integral sums e once per period and the derivative is a per-period delta
+        float kp = 0.6f * ku;
+        _p_factor = kp;
+        _i_factor = kp * dt / (tu / 2);
+        _d_factor = kp * (tu / 8) / dt;
+        _integral = 0;
+        _derivative = 0;
+
+        _tune_state = TUNE_DONE;
+        _tune_persist_pending = _tune_persist;
+    }
+};
+
+#endif  // End of include Guard: TEMPERATURE_PID_H_ONCE
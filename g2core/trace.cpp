@@ -0,0 +1,171 @@
+/*
+ * trace.cpp - binary event trace ring for latency diagnostics
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2026 FabMo
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "g2core.h"     // #1
+#include "config.h"     // #2
+#include "trace.h"
+#include "xio.h"
+#include "util.h"
+
+#ifdef __TRACE
+
+#include <atomic>
+
+/*
+ * The ring is multi-producer (main loop and every ISR level) and single-consumer (main loop).
+ *
+ * Producers claim a slot with an atomic increment of 'head', fill it, and commit it by writing
+ * the low 16 bits of the claimed index into the record's 'seq' field last. The consumer only
+ * takes a record once its seq matches the tail index, so a producer that was preempted between
+ * claim and commit simply delays the drain - it never yields a half-written record. If the
+ * producers lap the consumer the oldest records are skipped and counted as dropped.
+ */
+
+typedef struct traceRecord {        // 12 bytes on the wire
+    uint32_t time_us;               // microseconds since boot (wraps at ~71 minutes)
+    uint16_t seq;                   // low 16 bits of the ring index; written last to commit
+    uint8_t event;                  // traceEvent
+    uint8_t arg;                    // small event-specific payload
+    uint32_t value;                 // larger event-specific payload
+} __attribute__((packed)) traceRecord_t;
+
+typedef struct traceFrame {         // frame header sent ahead of each batch
+    uint16_t sync;
+    uint8_t count;
+    uint8_t version;
+    uint32_t dropped;
+} __attribute__((packed)) traceFrame_t;
+
+static_assert((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) == 0, "TRACE_RING_SIZE must be a power of 2");
+static_assert(TRACE_RING_SIZE < 65536, "TRACE_RING_SIZE must fit the 16 bit sequence number");
+
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+
+static struct traceSingleton {
+    std::atomic<uint32_t> head;     // next slot to claim (producers)
+    uint32_t tail;                  // next slot to send (consumer only)
+    uint32_t dropped;               // running total of overwritten records
+    traceRecord_t ring[TRACE_RING_SIZE];
+    uint8_t frame[sizeof(traceFrame_t) + TRACE_DRAIN_BATCH * sizeof(traceRecord_t)];
+} tr;
+
+/*
+ * _trace_time_us() - microsecond timestamp from the SysTick millisecond count and counter
+ *
+ *  SysTick counts down from LOAD to 0 once per millisecond. Resample if the millisecond
+ *  count changed while reading the counter.
+ */
+static uint32_t _trace_time_us()
+{
+    uint32_t ms = SysTickTimer.getValue();
+    uint32_t ticks = SysTick->VAL;
+    if (ms != SysTickTimer.getValue()) {
+        ms = SysTickTimer.getValue();
+        ticks = SysTick->VAL;
+    }
+    uint32_t load = SysTick->LOAD + 1;
+    return (ms * 1000 + ((load - ticks) * 1000) / load);
+}
+
+/*
+ * trace_init() - clear the ring
+ *
+ *  Each slot is stamped with the sequence number of the previous lap so that nothing
+ *  reads as committed until a producer has written it.
+ */
+void trace_init()
+{
+    tr.head.store(0);
+    tr.tail = 0;
+    tr.dropped = 0;
+    for (uint32_t i = 0; i < TRACE_RING_SIZE; i++) {
+        tr.ring[i].seq = (uint16_t)(i - TRACE_RING_SIZE);
+    }
+}
+
+/*
+ * trace_event() - record an event. Safe to call from any interrupt level.
+ */
+void trace_event(const traceEvent event, const uint8_t arg, const uint32_t value)
+{
+    uint32_t slot = tr.head.fetch_add(1, std::memory_order_relaxed);
+    traceRecord_t *rec = &tr.ring[slot & TRACE_RING_MASK];
+
+    rec->time_us = _trace_time_us();
+    rec->event = event;
+    rec->arg = arg;
+    rec->value = value;
+    std::atomic_signal_fence(std::memory_order_release);   // payload must land before the commit
+    rec->seq = (uint16_t)slot;
+}
+
+/*
+ * trace_callback() - drain committed records to the muted secondary channel
+ *
+ *  Sends at most TRACE_DRAIN_BATCH records per pass so the main loop is never held up.
+ *  Always returns STAT_OK - tracing must not change controller dispatch.
+ */
+stat_t trace_callback()
+{
+    uint32_t head = tr.head.load(std::memory_order_relaxed);
+    if (head == tr.tail) {
+        return (STAT_OK);
+    }
+    if ((head - tr.tail) > TRACE_RING_SIZE) {       // producers lapped us - skip to the oldest live record
+        tr.dropped += (head - tr.tail) - TRACE_RING_SIZE;
+        tr.tail = head - TRACE_RING_SIZE;
+    }
+
+    traceRecord_t *out = (traceRecord_t *)(tr.frame + sizeof(traceFrame_t));
+    uint8_t count = 0;
+    while ((tr.tail != head) && (count < TRACE_DRAIN_BATCH)) {
+        traceRecord_t *rec = &tr.ring[tr.tail & TRACE_RING_MASK];
+        if (rec->seq != (uint16_t)tr.tail) {
+            break;                                  // claimed but not yet committed
+        }
+        std::atomic_signal_fence(std::memory_order_acquire);
+        out[count] = *rec;
+        if ((tr.head.load(std::memory_order_relaxed) - tr.tail) > TRACE_RING_SIZE) {
+            break;                                  // overwritten while copying; resync next pass
+        }
+        count++;
+        tr.tail++;
+    }
+    if (count == 0) {
+        return (STAT_OK);
+    }
+
+    traceFrame_t *frame = (traceFrame_t *)tr.frame;
+    frame->sync = TRACE_SYNC;
+    frame->count = count;
+    frame->version = TRACE_VERSION;
+    frame->dropped = tr.dropped;
+    xio_write((const char *)tr.frame, sizeof(traceFrame_t) + count * sizeof(traceRecord_t), true);
+    return (STAT_OK);
+}
+
+#endif // __TRACE
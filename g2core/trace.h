@@ -0,0 +1,80 @@
+/*
+ * trace.h - binary event trace ring for latency diagnostics
+ * This file is part of the g2core project
+ *
+ * Copyright (c) 2026 FabMo
+ *
+ * This file ("the software") is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2 as published by the
+ * Free Software Foundation. You should have received a copy of the GNU General Public
+ * License, version 2 along with the software.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, you may use this file as part of a software library without
+ * restriction. Specifically, if other files instantiate templates or use macros or
+ * inline functions from this file, or you compile this file and link it with other
+ * files to produce an executable, this file does not by itself cause the resulting
+ * executable to be covered by the GNU General Public License. This exception does not
+ * however invalidate any other reasons why the executable file might be covered by the
+ * GNU General Public License.
+ *
+ * THE SOFTWARE IS DISTRIBUTED IN THE HOPE THAT IT WILL BE USEFUL, BUT WITHOUT ANY
+ * WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+ * SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ * The trace ring replaces ASCII_ART() style diagnostics for timing-sensitive work. Events are
+ * written as fixed-size binary records from any context (ISRs included) without locking or
+ * formatting, and drained opportunistically from the main loop to the muted secondary channel
+ * (usually the second USB serial port). Resources/debug/trace_decode.py converts the captured
+ * stream to Chrome-trace JSON that can be loaded into Perfetto or chrome://tracing.
+ *
+ * Enable by defining __TRACE in g2core.h. When disabled the TRACE() macro compiles to nothing.
+ *
+ * Wire format (little-endian), repeated:
+ *
+ *   frame header    uint16 sync (TRACE_SYNC), uint8 count, uint8 version, uint32 dropped
+ *   count records   uint32 time_us, uint16 seq, uint8 event, uint8 arg, uint32 value
+ *
+ * 'dropped' is the running total of records overwritten before they could be drained.
+ */
+
+#ifndef TRACE_H_ONCE
+#define TRACE_H_ONCE
+
+#include <stdint.h>
+
+typedef enum {                      // trace event IDs - keep in sync with Resources/debug/trace_decode.py
+    TRACE_NONE = 0,
+    TRACE_BUFFER_STATE,             // arg = planner buffer number, value = new bufferState
+    TRACE_FORWARD_PLAN_START,       // mp_forward_plan() entered
+    TRACE_FORWARD_PLAN_END,         // arg = 1 if something was planned
+    TRACE_LOAD_MOVE,                // arg = stepper block type, value = segment DDA ticks
+    TRACE_FEEDHOLD,                 // arg = new cmFeedholdState, value = hold type
+    TRACE_RX_LINE,                  // arg = 1 if control line, value = line length
+    TRACE_FEEDHOLD_STOP,            // arg = hold type, value = stopping distance in microns
+    TRACE_EVENT_MAX
+} traceEvent;
+
+#ifdef __TRACE
+
+#define TRACE_VERSION       1
+#define TRACE_SYNC          ((uint16_t)0x5447)      // "GT" on the wire
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE     256                     // records; must be a power of 2 and < 65536
+#endif
+#define TRACE_DRAIN_BATCH   16                      // max records sent per trace_callback() pass
+
+#define TRACE(event, arg, value) trace_event((event), (uint8_t)(arg), (uint32_t)(value))
+
+void trace_init(void);
+void trace_event(const traceEvent event, const uint8_t arg, const uint32_t value);
+stat_t trace_callback(void);
+
+#else
+#define TRACE(event, arg, value)
+#endif // __TRACE
+
+#endif // End of include guard: TRACE_H_ONCE
@@ -38,6 +38,7 @@
 #include "controller.h"
 #include "util.h"
 #include "settings.h"
+#include "trace.h"
 
 #include "board_xio.h"
 
@@ -258,13 +259,14 @@ struct xio_t {
      * In the current environment, these are not foreseen to cause trouble since these
      * are blocking writes and we expect to only really be writing to one device.
      */
-    size_t write(const char *buffer, size_t size, bool only_to_muted)
+    size_t write(const char *buffer, size_t size, bool only_to_muted, devflags_t sr_mask = 0, devflags_t sr_flags = 0)
     {
         size_t total_written = -1;
         for (int8_t i = 0; i < _dev_count; ++i) {
             bool ok_channel = false;
             if (!only_to_muted) {
-                ok_channel = DeviceWrappers[i]->isCtrlAndActive();
+                ok_channel = DeviceWrappers[i]->isCtrlAndActive() &&
+                             ((DeviceWrappers[i]->flags & sr_mask) == sr_flags);
             } else {
                 ok_channel = DeviceWrappers[i]->isMuted();
             }
@@ -294,6 +296,42 @@ struct xio_t {
         return write(buffer, len, only_to_muted);
     };
 
+    /*
+     * hasSRChannel() - true if an active control channel takes status reports in the given format
+     */
+
+    bool hasSRChannel(bool compact)
+    {
+        for (int8_t i = 0; i < _dev_count; ++i) {
+            if (DeviceWrappers[i]->isCtrlAndActive() &&
+                (((DeviceWrappers[i]->flags & DEV_SR_COMPACT) != 0) == compact)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+     * setSRCompact() - set the status report format of the device the last line was read from
+     */
+
+    void setSRCompact(bool compact)
+    {
+        if (read_dev == DEV_NONE) {
+            return;
+        }
+        if (compact) {
+            DeviceWrappers[read_dev]->flags |= DEV_SR_COMPACT;
+        } else {
+            DeviceWrappers[read_dev]->flags &= ~DEV_SR_COMPACT;
+        }
+    }
+
+    bool getSRCompact()
+    {
+        return ((read_dev != DEV_NONE) && (DeviceWrappers[read_dev]->flags & DEV_SR_COMPACT));
+    }
+
     /*
      * flush() - flush all readable devices' write buffers
      */
@@ -369,6 +407,8 @@ struct xio_t {
 
             if (size > 0) {
                 flags = DeviceWrappers[dev]->flags;
+                read_dev = dev;
+                read_ctrl = true;
                 return ret_buffer;
             }
         }
@@ -383,6 +423,8 @@ struct xio_t {
 
                 if (size > 0) {
                     flags = DeviceWrappers[dev]->flags;
+                    read_dev = dev;
+                    read_ctrl = false;          // control lines were drained by the first pass
                     return ret_buffer;
                 }
             }
@@ -412,6 +454,9 @@ struct xio_t {
     };
 #endif
 
+    int8_t read_dev = DEV_NONE;            // device the last line was read from (for per-channel settings)
+    bool read_ctrl = false;                 // the last line was read as a control line
+
     uint16_t magic_end;
 };
 
@@ -1385,7 +1430,15 @@ size_t xio_write(const char *buffer, size_t size, bool only_to_muted /*= false*/
 
 char *xio_readline(devflags_t &flags, uint16_t &size)
 {
+#ifdef __TRACE
+    char *line = xio.readline(flags, size);
+    if (line != NULL) {
+        TRACE(TRACE_RX_LINE, xio.read_ctrl, size);    // tag by how the line was read, not by the request
+    }
+    return line;
+#else
     return xio.readline(flags, size);
+#endif
 }
 
 int16_t xio_writeline(const char *buffer, bool only_to_muted /*= false*/)
@@ -1393,6 +1446,33 @@ int16_t xio_writeline(const char *buffer, bool only_to_muted /*= false*/)
     return xio.writeline(buffer, only_to_muted);
 }
 
+/*
+ * xio_set_sr_compact() - select compact status reports for the channel the current command came from
+ * xio_get_sr_compact() - return the status report format of that channel
+ * xio_has_sr_channel() - true if any active control channel wants the given format
+ * xio_writeline_sr()   - write a line only to the control channels using the given format
+ */
+
+void xio_set_sr_compact(bool compact)
+{
+    xio.setSRCompact(compact);
+}
+
+bool xio_get_sr_compact()
+{
+    return xio.getSRCompact();
+}
+
+bool xio_has_sr_channel(bool compact)
+{
+    return xio.hasSRChannel(compact);
+}
+
+int16_t xio_writeline_sr(const char *buffer, bool compact)
+{
+    return xio.write(buffer, strlen(buffer), false, DEV_SR_COMPACT, compact ? DEV_SR_COMPACT : 0);
+}
+
 /*
  * write() - return true of the device is currently "connected" (there's a fair bit of interpretation)
  */
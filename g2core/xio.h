@@ -87,6 +87,9 @@ typedef uint16_t devflags_t;                // might need to bump to 32 be 16 or
 // device exception flags
 #define DEV_THROW_EOF       (0x0100)        // end of file encountered
 
+// device reporting flags
+#define DEV_SR_COMPACT      (0x0200)        // device is sent compact status reports ({sf:1}, see report.cpp)
+
 // device specials
 #define DEV_IS_BOTH         (DEV_IS_CTRL | DEV_IS_DATA)
 #define DEV_FLAGS_CLEAR     (0x0000)        // Apply as flags = DEV_FLAGS_CLEAR;
@@ -126,6 +129,11 @@ void xio_exit_fake_bootloader();
 #endif
 void xio_flush_device(devflags_t &flags);
 
+void xio_set_sr_compact(bool compact);
+bool xio_get_sr_compact();
+bool xio_has_sr_channel(bool compact);
+int16_t xio_writeline_sr(const char *buffer, bool compact);
+
 stat_t xio_set_spi(nvObj_t *nv);
 
 /**** newlib-nano support function(s) ****/